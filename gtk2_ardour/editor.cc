@@ -5648,7 +5648,18 @@ Editor::super_rapid_screen_update ()
 	/* update track meters, if required */
 	if (is_mapped() && meters_running) {
 		RouteTimeAxisView* rtv;
+		/* only poll meters that can be seen, so that the backend
+		   does not need to compute them for the others
+		*/
+		double const view_min_y = vertical_adjustment.get_value ();
+		double const view_max_y = view_min_y + vertical_adjustment.get_page_size ();
 		for (TrackViewList::iterator i = track_views.begin(); i != track_views.end(); ++i) {
+			if ((*i)->hidden ()) {
+				continue;
+			}
+			if ((*i)->y_position () + (*i)->effective_height () < view_min_y || (*i)->y_position () > view_max_y) {
+				continue;
+			}
 			if ((rtv = dynamic_cast<RouteTimeAxisView*>(*i)) != 0) {
 				rtv->fast_update ();
 			}
@@ -20,6 +20,8 @@
 #include <limits.h>
 
 #include "ardour/meter.h"
+#include "ardour/meter_snapshot.h"
+#include "ardour/session.h"
 
 #include <gtkmm2ext/utils.h>
 #include "pbd/fastlog.h"
@@ -122,21 +124,51 @@ static float vu_standard() {
 	}
 }
 
+/* All meters share one copy of the session's meter snapshot, which is
+ * refreshed at most once per redraw pass rather than once per meter.
+ */
+static MeterSnapshot::View&
+snapshot_view (Session* session)
+{
+	static MeterSnapshot::View view;
+	static MeterSnapshot* source = 0;
+	static gint64 updated = 0;
+
+	MeterSnapshot* snapshot = session->meter_snapshot ().get ();
+	gint64 const now = g_get_monotonic_time ();
+
+	if (snapshot != source) {
+		view = MeterSnapshot::View ();
+		source = snapshot;
+		updated = 0;
+	}
+
+	if (now - updated > 5000) {
+		view.update (*snapshot);
+		updated = now;
+	}
+
+	return view;
+}
+
 float
 LevelMeterBase::update_meters ()
 {
 	vector<MeterInfo>::iterator i;
 	uint32_t n;
 
-	if (!_meter) {
+	if (!_meter || !_session) {
 		return 0.0f;
 	}
 
+	MeterSnapshot::View& view (snapshot_view (_session));
+	uint32_t const slot = _meter->snapshot_slot ();
+
 	uint32_t nmidi = _meter->input_streams().n_midi();
 
 	for (n = 0, i = meters.begin(); i != meters.end(); ++i, ++n) {
 		if ((*i).packed) {
-			const float mpeak = _meter->meter_level(n, MeterMaxPeak);
+			const float mpeak = view.level (slot, n, MeterMaxPeak);
 			if (mpeak > (*i).max_peak) {
 				(*i).max_peak = mpeak;
 				(*i).meter->set_highlight(mpeak >= UIConfiguration::instance().get_meter_peak());
@@ -146,9 +178,9 @@ LevelMeterBase::update_meters ()
 			}
 
 			if (n < nmidi) {
-				(*i).meter->set (_meter->meter_level (n, MeterPeak));
+				(*i).meter->set (view.level (slot, n, MeterPeak));
 			} else {
-				const float peak = _meter->meter_level (n, meter_type);
+				const float peak = view.level (slot, n, meter_type);
 				if (meter_type == MeterPeak) {
 					(*i).meter->set (log_meter (peak));
 				} else if (meter_type == MeterPeak0dB) {
@@ -162,13 +194,13 @@ LevelMeterBase::update_meters ()
 				} else if (meter_type == MeterVU) {
 					(*i).meter->set (meter_deflect_vu (peak + vu_standard() + meter_lineup(0)));
 				} else if (meter_type == MeterK12) {
-					(*i).meter->set (meter_deflect_k (peak, 12), meter_deflect_k(_meter->meter_level(n, MeterPeak), 12));
+					(*i).meter->set (meter_deflect_k (peak, 12), meter_deflect_k(view.level (slot, n, MeterPeak), 12));
 				} else if (meter_type == MeterK14) {
-					(*i).meter->set (meter_deflect_k (peak, 14), meter_deflect_k(_meter->meter_level(n, MeterPeak), 14));
+					(*i).meter->set (meter_deflect_k (peak, 14), meter_deflect_k(view.level (slot, n, MeterPeak), 14));
 				} else if (meter_type == MeterK20) {
-					(*i).meter->set (meter_deflect_k (peak, 20), meter_deflect_k(_meter->meter_level(n, MeterPeak), 20));
+					(*i).meter->set (meter_deflect_k (peak, 20), meter_deflect_k(view.level (slot, n, MeterPeak), 20));
 				} else { // RMS
-					(*i).meter->set (log_meter (peak), log_meter(_meter->meter_level(n, MeterPeak)));
+					(*i).meter->set (log_meter (peak), log_meter(view.level (slot, n, MeterPeak)));
 				}
 			}
 		}
@@ -913,7 +913,9 @@ Mixer_UI::fast_update_strips ()
 {
 	if (is_mapped () && _session) {
 		for (list<MixerStrip *>::iterator i = strips.begin(); i != strips.end(); ++i) {
-			(*i)->fast_update ();
+			if ((*i)->is_visible ()) {
+				(*i)->fast_update ();
+			}
 		}
 	}
 }
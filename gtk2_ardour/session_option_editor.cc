@@ -207,6 +207,15 @@ SessionOptionEditor::SessionOptionEditor (Session* s)
 
 	add_option (_("Media"), hf);
 
+	add_option (_("Media"), new OptionEditorHeading (_("Playback")));
+
+	add_option (_("Media"), new BoolOption (
+				"high-quality-varispeed",
+				_("Use band-limited resampling for varispeed playback"),
+				sigc::mem_fun (*_session_config, &SessionConfiguration::get_high_quality_varispeed),
+				sigc::mem_fun (*_session_config, &SessionConfiguration::set_high_quality_varispeed)
+				));
+
 	add_option (_("Locations"), new OptionEditorHeading (_("File locations")));
 
         SearchPathOption* spo = new SearchPathOption ("audio-search-path", _("Search for audio files in:"),
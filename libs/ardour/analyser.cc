@@ -22,7 +22,10 @@
 #include "ardour/session_event.h"
 #include "ardour/transient_detector.h"
 
+#include <boost/scoped_ptr.hpp>
+
 #include "pbd/compose.h"
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 #include "i18n.h"
 
@@ -33,7 +36,9 @@ using namespace PBD;
 Analyser* Analyser::the_analyser = 0;
 Glib::Threads::Mutex Analyser::analysis_queue_lock;
 Glib::Threads::Cond  Analyser::SourcesToAnalyse;
+Glib::Threads::Cond  Analyser::AnalysisFinished;
 list<boost::weak_ptr<Source> > Analyser::analysis_queue;
+map<Source const *, Analyser::Analysis> Analyser::analyses_in_progress;
 
 Analyser::Analyser ()
 {
@@ -53,7 +58,13 @@ analyser_work ()
 void
 Analyser::init ()
 {
-	Glib::Threads::Thread::create (sigc::ptr_fun (analyser_work));
+	/* each source is analysed independently, so use a thread per core */
+
+	uint32_t const n_threads = max (1U, hardware_concurrency ());
+
+	for (uint32_t n = 0; n < n_threads; ++n) {
+		Glib::Threads::Thread::create (sigc::ptr_fun (analyser_work));
+	}
 }
 
 void
@@ -68,36 +79,145 @@ Analyser::queue_source_for_analysis (boost::shared_ptr<Source> src, bool force)
 	}
 
 	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+
+	for (list<boost::weak_ptr<Source> >::const_iterator i = analysis_queue.begin(); i != analysis_queue.end(); ++i) {
+		if (i->lock() == src) {
+			/* already waiting */
+			return;
+		}
+	}
+
+	map<Source const *, Analysis>::iterator a = analyses_in_progress.find (src.get());
+
+	if (a != analyses_in_progress.end()) {
+		if (!force) {
+			return;
+		}
+		/* the source has changed since the running analysis began, so
+		   stop it; the source will be analysed again once it has finished.
+		*/
+		a->second.cancelled = true;
+		if (a->second.analyser) {
+			a->second.analyser->cancel ();
+		}
+	}
+
 	analysis_queue.push_back (boost::weak_ptr<Source>(src));
-	SourcesToAnalyse.broadcast ();
+	SourcesToAnalyse.signal ();
 }
 
+/** Stop any analysis of a source, whether it is queued or running */
 void
-Analyser::work ()
+Analyser::cancel_source_analysis (boost::shared_ptr<Source> src)
 {
-	SessionEvent::create_per_thread_pool ("Analyser", 64);
+	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
 
-	while (true) {
-		analysis_queue_lock.lock ();
+	for (list<boost::weak_ptr<Source> >::iterator i = analysis_queue.begin(); i != analysis_queue.end(); ) {
+		boost::shared_ptr<Source> s (i->lock());
+		if (!s || s == src) {
+			i = analysis_queue.erase (i);
+		} else {
+			++i;
+		}
+	}
 
-	  wait:
-		if (analysis_queue.empty()) {
-			SourcesToAnalyse.wait (analysis_queue_lock);
+	map<Source const *, Analysis>::iterator a = analyses_in_progress.find (src.get());
+
+	if (a != analyses_in_progress.end()) {
+		a->second.cancelled = true;
+		if (a->second.analyser) {
+			a->second.analyser->cancel ();
 		}
+	}
+}
 
-		if (analysis_queue.empty()) {
-			goto wait;
+/** Drop all queued analyses, and cancel and wait for any that are running,
+ *  so that no source is referenced by the analysis threads on return.
+ */
+void
+Analyser::flush ()
+{
+	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+
+	analysis_queue.clear ();
+
+	for (map<Source const *, Analysis>::iterator a = analyses_in_progress.begin(); a != analyses_in_progress.end(); ++a) {
+		a->second.cancelled = true;
+		if (a->second.analyser) {
+			a->second.analyser->cancel ();
 		}
+	}
+
+	while (!analyses_in_progress.empty ()) {
+		AnalysisFinished.wait (analysis_queue_lock);
+	}
+}
+
+/** Take the first queued source that still exists and is not already being
+ *  analysed by another thread off the queue, and mark it as in progress.
+ *  Must be called with analysis_queue_lock held.
+ */
+boost::shared_ptr<Source>
+Analyser::next_source ()
+{
+	for (list<boost::weak_ptr<Source> >::iterator i = analysis_queue.begin(); i != analysis_queue.end(); ) {
 
-		boost::shared_ptr<Source> src (analysis_queue.front().lock());
-		analysis_queue.pop_front();
-		analysis_queue_lock.unlock ();
+		boost::shared_ptr<Source> src (i->lock());
+
+		if (!src) {
+			i = analysis_queue.erase (i);
+			continue;
+		}
+
+		if (analyses_in_progress.find (src.get()) == analyses_in_progress.end()) {
+			analysis_queue.erase (i);
+			analyses_in_progress[src.get()] = Analysis ();
+			return src;
+		}
+
+		++i;
+	}
+
+	return boost::shared_ptr<Source> ();
+}
+
+void
+Analyser::work ()
+{
+	SessionEvent::create_per_thread_pool ("Analyser", 64);
+
+	while (true) {
+		boost::shared_ptr<Source> src;
+
+		{
+			Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+			while (!(src = next_source ())) {
+				SourcesToAnalyse.wait (analysis_queue_lock);
+			}
+		}
 
 		boost::shared_ptr<AudioFileSource> afs = boost::dynamic_pointer_cast<AudioFileSource> (src);
 
 		if (afs && afs->length(afs->timeline_position())) {
 			analyse_audio_file_source (afs);
 		}
+
+		/* drop our references before flush() can return, so that
+		   the last one is never released by this thread.
+		*/
+		Source const * done = src.get();
+		afs.reset ();
+		src.reset ();
+
+		{
+			Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+			analyses_in_progress.erase (done);
+			/* another thread may be able to take a source that was
+			   held back while this one was busy with it.
+			*/
+			SourcesToAnalyse.broadcast ();
+			AnalysisFinished.broadcast ();
+		}
 	}
 }
 
@@ -105,17 +225,41 @@ void
 Analyser::analyse_audio_file_source (boost::shared_ptr<AudioFileSource> src)
 {
 	AnalysisFeatureList results;
+	boost::scoped_ptr<TransientDetector> td;
+	int ret;
 
 	try {
-		TransientDetector td (src->sample_rate());
-		if (td.run (src->get_transients_path(), src.get(), 0, results) == 0) {
-			src->set_been_analysed (true);
-		} else {
-			src->set_been_analysed (false);
-		}
+		td.reset (new TransientDetector (src->sample_rate()));
 	} catch (...) {
-		error << string_compose(_("Transient Analysis failed for %1."), _("Audio File Source")) << endmsg;;
+		error << string_compose(_("Transient Analysis failed for %1."), _("Audio File Source")) << endmsg;
 		src->set_been_analysed (false);
 		return;
 	}
+
+	{
+		Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+		Analysis& a (analyses_in_progress[src.get()]);
+		if (a.cancelled) {
+			return;
+		}
+		a.analyser = td.get();
+	}
+
+	try {
+		ret = td->run (src->get_transients_path(), src.get(), 0, results);
+	} catch (...) {
+		error << string_compose(_("Transient Analysis failed for %1."), _("Audio File Source")) << endmsg;
+		ret = -1;
+	}
+
+	{
+		Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+		Analysis& a (analyses_in_progress[src.get()]);
+		a.analyser = 0;
+		if (a.cancelled) {
+			return;
+		}
+	}
+
+	src->set_been_analysed (ret == 0);
 }
@@ -20,17 +20,26 @@
 #ifndef __ardour_analyser_h__
 #define __ardour_analyser_h__
 
+#include <list>
+#include <map>
+
 #include <glibmm/threads.h>
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
 
 #include "ardour/libardour_visibility.h"
 
 namespace ARDOUR {
 
+class AudioAnalyser;
 class AudioFileSource;
 class Source;
 class TransientDetector;
 
+/** Runs transient analysis of sources in the background, on a pool of
+ *  threads.  Results are kept on disk (see Source::get_transients_path())
+ *  so that a source is only analysed again if it is forced.
+ */
 class LIBARDOUR_API Analyser {
 
   public:
@@ -39,14 +48,26 @@ class LIBARDOUR_API Analyser {
 
 	static void init ();
 	static void queue_source_for_analysis (boost::shared_ptr<Source>, bool force);
+	static void cancel_source_analysis (boost::shared_ptr<Source>);
+	static void flush ();
 	static void work ();
 
   private:
+	struct Analysis {
+		Analysis () : analyser (0), cancelled (false) {}
+		AudioAnalyser* analyser;
+		bool cancelled;
+	};
+
 	static Analyser* the_analyser;
         static Glib::Threads::Mutex analysis_queue_lock;
         static Glib::Threads::Cond  SourcesToAnalyse;
+	static Glib::Threads::Cond  AnalysisFinished;
 	static std::list<boost::weak_ptr<Source> > analysis_queue;
+	/** sources that are being analysed now; protected by analysis_queue_lock */
+	static std::map<Source const *, Analysis> analyses_in_progress;
 
+	static boost::shared_ptr<Source> next_source ();
 	static void analyse_audio_file_source (boost::shared_ptr<AudioFileSource>);
 };
 
@@ -0,0 +1,124 @@
+/*
+    Copyright (C) 2016 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef __ardour_audio_block_cache_h__
+#define __ardour_audio_block_cache_h__
+
+#include <list>
+#include <map>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <glibmm/threads.h>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class AudioSource;
+
+/** An LRU cache of decoded audio shared by all audio file sources.
+ *
+ *  Data is kept in blocks of block_frames frames of a single source, so
+ *  that regions sharing a source, loops and re-reads after a locate are
+ *  served from memory.  The cache is split into shards with a lock each,
+ *  which keeps the butler and other readers from contending on one lock.
+ *  Sources must drop() their blocks before they go away.
+ */
+class LIBARDOUR_API AudioBlockCache : public boost::noncopyable
+{
+  public:
+	static const framecnt_t block_frames = 16384;
+
+	struct Stats {
+		Stats () : hits (0), misses (0), evictions (0), blocks (0), bytes (0) {}
+
+		uint64_t hits;
+		uint64_t misses;
+		uint64_t evictions;
+		size_t   blocks;
+		size_t   bytes;
+	};
+
+	static AudioBlockCache& instance ();
+
+	/** Set the total size of cached data, in bytes; 0 disables the cache */
+	void set_capacity (size_t bytes);
+	size_t capacity () const;
+
+	bool lookup (AudioSource const *, framepos_t block, framecnt_t offset, framecnt_t cnt, Sample* dst, framecnt_t& valid);
+	void insert (AudioSource const *, framepos_t block, std::vector<Sample>& data, framecnt_t valid);
+
+	void drop (AudioSource const *);
+	void clear ();
+
+	Stats stats () const;
+	void reset_stats ();
+
+  private:
+	AudioBlockCache ();
+
+	struct Key {
+		Key (AudioSource const * s, framepos_t b) : source (s), block (b) {}
+
+		bool operator< (Key const & other) const {
+			return source < other.source || (source == other.source && block < other.block);
+		}
+
+		AudioSource const * source;
+		framepos_t          block;
+	};
+
+	struct Block {
+		Block (Key const & k) : key (k), valid (0) {}
+
+		Key                 key;
+		std::vector<Sample> data;
+		framecnt_t          valid; ///< number of frames of @a data that are from the file
+	};
+
+	typedef std::list<Block> LRU; ///< most recently used first
+	typedef std::map<Key, LRU::iterator> Index;
+
+	struct Shard {
+		Shard () : bytes (0), hits (0), misses (0), evictions (0) {}
+
+		mutable Glib::Threads::Mutex lock;
+		LRU      lru;
+		Index    index;
+		size_t   bytes;
+		uint64_t hits;
+		uint64_t misses;
+		uint64_t evictions;
+	};
+
+	static const uint32_t n_shards = 16;
+
+	Shard& shard_for (Key const &);
+	void trim (Shard&, size_t limit);
+
+	static AudioBlockCache* _instance;
+
+	Shard  _shards[n_shards];
+	size_t _shard_capacity; ///< bytes per shard
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_audio_block_cache_h__ */
@@ -206,6 +206,7 @@ class LIBARDOUR_API AudioDiskstream : public Diskstream
 	typedef std::vector<ChannelInfo*> ChannelList;
 
 	CubicInterpolation interpolation;
+	PolyphaseInterpolation polyphase_interpolation; ///< used instead of interpolation with high-quality-varispeed
 
 	/* The two central butler operations */
 	int do_flush (RunContext context, bool force = false);
@@ -23,6 +23,8 @@
 #include <vector>
 #include <string>
 #include <boost/utility.hpp>
+#include <glib.h>
+#include <glibmm/threads.h>
 #include "vamp-sdk/Plugin.h"
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
@@ -50,6 +52,11 @@ class LIBARDOUR_API AudioAnalyser : public boost::noncopyable {
 
 	void reset ();
 
+	/** Ask a running analysis to stop, from any thread; it will then
+	 *  return an error without writing any results.
+	 */
+	void cancel () { g_atomic_int_set (&cancelled, 1); }
+
   protected:
 	float sample_rate;
 	AnalysisPlugin* plugin;
@@ -58,6 +65,11 @@ class LIBARDOUR_API AudioAnalyser : public boost::noncopyable {
 	framecnt_t bufsize;
 	framecnt_t stepsize;
 
+	volatile gint cancelled;
+
+	/** serializes use of the (shared) VAMP plugin loader */
+	static Glib::Threads::Mutex loader_lock;
+
 	int initialize_plugin (AnalysisPluginKey name, float sample_rate);
 	int analyse (const std::string& path, Readable*, uint32_t channel);
 
@@ -64,6 +64,8 @@ public:
 
 	int setup_peakfile ();
 
+	framecnt_t read (Sample *dst, framepos_t start, framecnt_t cnt, int channel=0) const;
+
 	XMLNode& get_state ();
 	int set_state (const XMLNode&, int version);
 
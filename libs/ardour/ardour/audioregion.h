@@ -206,6 +206,7 @@ class LIBARDOUR_API AudioRegion : public Region
 	void recompute_gain_at_start ();
 
 	framecnt_t read_from_sources (SourceList const &, framecnt_t, Sample *, framepos_t, framecnt_t, uint32_t) const;
+	bool read_peak_maxima (Sample *, framepos_t, framecnt_t) const;
 
 	void recompute_at_start ();
 	void recompute_at_end ();
@@ -71,6 +71,15 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 	int read_peaks (PeakData *peaks, framecnt_t npeaks,
 			framepos_t start, framecnt_t cnt, double samples_per_visual_peak) const;
 
+	/** Read peak data straight from the peak file at its own resolution,
+	 *  one PeakData for every peak_file_frames() frames.  This does not
+	 *  disturb the cache used by read_peaks() for display.
+	 *  @param start First frame to read; must be a multiple of peak_file_frames().
+	 *  @return 0 on success, -1 if the peak data is not (yet) available.
+	 */
+	int read_file_peaks (PeakData *peaks, framecnt_t npeaks, framepos_t start) const;
+	static framecnt_t peak_file_frames ();
+
 	int  build_peaks ();
 	bool peaks_ready (boost::function<void()> callWhenReady, PBD::ScopedConnection** connection_created_if_not_ready, PBD::EventLoop* event_loop) const;
 
@@ -63,6 +63,8 @@ public:
         virtual void transport_located (framepos_t now);
 	virtual void transport_stopped (framepos_t now);
 
+	void render_automation (framepos_t start, framecnt_t len);
+
 	virtual std::string describe_parameter(Evoral::Parameter param);
 	virtual std::string value_as_string (boost::shared_ptr<AutomationControl>) const;
 
@@ -69,6 +69,26 @@ class LIBARDOUR_API Butler : public SessionHandleRef
 
 	bool flush_tracks_to_disk_after_locate (boost::shared_ptr<RouteList>, uint32_t& errors);
 
+	/** Where the butler thread's time goes, in usecs. Written by the
+	 *  butler only; readers get a copy which may be slightly stale.
+	 */
+	struct Stats {
+		Stats ()
+			: passes (0), pass_max (0), pass_total (0)
+			, transport_work (0), transport_work_max (0), transport_work_total (0) {}
+
+		uint64_t passes;         ///< refill passes over all tracks
+		gint64   pass_max;
+		gint64   pass_total;
+		uint64_t transport_work; ///< calls to Session::butler_transport_work()
+		gint64   transport_work_max;
+		gint64   transport_work_total;
+	};
+
+	Stats stats () const;
+	/** Ask the butler thread to clear its stats before its next pass */
+	void reset_stats ();
+
 	static void* _thread_work(void *arg);
 	void*         thread_work();
 
@@ -104,6 +124,9 @@ private:
 
 	CrossThreadChannel _xthread;
 
+	Stats _stats;
+	volatile gint _reset_stats;
+
 };
 
 } // namespace ARDOUR
@@ -0,0 +1,139 @@
+/*
+    Copyright (C) 2016 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef __ardour_disk_io_stats_h__
+#define __ardour_disk_io_stats_h__
+
+#include <ostream>
+#include <stdint.h>
+
+#include <glib.h>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+/** Disk I/O statistics and recent underruns of one diskstream.
+ *
+ *  Refill figures are written by the butler, buffer fill levels and
+ *  underruns by the process thread. Readers take them without locking,
+ *  so a report may be a cycle out of date, and an underrun record being
+ *  overwritten while it is read may come out mixed.
+ *
+ *  reset() may be called from any thread: it only asks for the figures to
+ *  be cleared, and each of the two writers clears its own the next time it
+ *  records something. Until then they read as zero.
+ */
+class LIBARDOUR_API DiskIOStats
+{
+public:
+	DiskIOStats ();
+
+	enum UnderrunCause {
+		ButlerStarved, ///< the butler had not got round to refilling this stream
+		DiskSlow,      ///< the butler was reading for this stream, but not fast enough
+		TransportWork, ///< buffers were still being refilled after a locate or overwrite
+	};
+
+	struct Underrun {
+		gint64        when;      ///< g_get_monotonic_time() of the underrun
+		framepos_t    position;  ///< transport position
+		framecnt_t    needed;    ///< samples the cycle needed
+		framecnt_t    available; ///< samples that were in the buffer
+		gint64        idle;      ///< usecs since the last refill finished, or -1
+		UnderrunCause cause;
+	};
+
+	static const int fill_bins = 10;     ///< buffer fill, in 10% steps
+	static const int latency_bins = 16;  ///< refill time, [2^n, 2^(n+1)) usecs
+	static const int max_underruns = 32; ///< underrun records kept
+
+	/* butler side */
+
+	void refill_started ();
+	void refill_done (uint64_t bytes, uint32_t reads);
+
+	/* process side */
+
+	void playback_fill (float);
+	void capture_fill (float);
+	void underrun (framepos_t position, framecnt_t needed, framecnt_t available, bool transport_work);
+
+	/* anyone */
+
+	void reset ();
+	void dump (std::ostream&) const;
+
+	uint64_t refills () const { return butler_reset_pending () ? 0 : _refills; }
+	uint64_t bytes_read () const { return butler_reset_pending () ? 0 : _bytes_read; }
+	uint64_t reads () const { return butler_reset_pending () ? 0 : _reads; }
+	gint64 refill_max () const { return butler_reset_pending () ? 0 : _refill_max; }
+	gint64 refill_total () const { return butler_reset_pending () ? 0 : _refill_total; }
+	uint64_t refill_histogram (int bin) const { return butler_reset_pending () ? 0 : _refill_hist[bin]; }
+
+	uint64_t playback_fill_histogram (int bin) const { return process_reset_pending () ? 0 : _playback_fill[bin]; }
+	uint64_t capture_fill_histogram (int bin) const { return process_reset_pending () ? 0 : _capture_fill[bin]; }
+
+	/** @return total number of underruns since the last reset */
+	uint32_t n_underruns () const;
+	/** @param n 0 for the most recent underrun, up to
+	 *  min (n_underruns(), max_underruns) - 1
+	 */
+	Underrun const & underrun_record (uint32_t n) const;
+
+	static const char* cause_name (UnderrunCause);
+
+	/** @return histogram bin for a buffer fill of @a load (0 to 1) */
+	static int fill_bin (float load);
+	/** @return histogram bin for a refill that took @a usecs */
+	static int latency_bin (gint64 usecs);
+
+private:
+	void reset_butler_side ();
+	void reset_process_side ();
+	void check_process_reset ();
+
+	bool butler_reset_pending () const { return g_atomic_int_get (const_cast<gint*> (&_butler_reset)); }
+	bool process_reset_pending () const { return g_atomic_int_get (const_cast<gint*> (&_process_reset)); }
+
+	/* butler */
+	uint64_t _refills;
+	uint64_t _bytes_read;
+	uint64_t _reads;
+	gint64   _refill_start;
+	gint64   _refill_max;
+	gint64   _refill_total;
+	uint64_t _refill_hist[latency_bins];
+	volatile gint   _refilling;
+	gint64          _last_refill;
+
+	/* process thread */
+	uint64_t _playback_fill[fill_bins];
+	uint64_t _capture_fill[fill_bins];
+	Underrun _underruns[max_underruns];
+	volatile gint _n_underruns;
+
+	/* reset requests, one for each writer */
+	volatile gint _butler_reset;
+	volatile gint _process_reset;
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_disk_io_stats_h__ */
@@ -33,6 +33,7 @@
 
 #include "ardour/ardour.h"
 #include "ardour/chan_count.h"
+#include "ardour/disk_io_stats.h"
 #include "ardour/session_object.h"
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
@@ -92,6 +93,9 @@ class LIBARDOUR_API Diskstream : public SessionObject, public PublicDiskstream
 	virtual float playback_buffer_load() const = 0;
 	virtual float capture_buffer_load() const = 0;
 
+	/** refill, buffer fill and underrun history of this diskstream */
+	DiskIOStats& io_stats () { return _io_stats; }
+
 	void set_flag (Flag f)   { _flags = Flag (_flags | f); }
 	void unset_flag (Flag f) { _flags = Flag (_flags & ~f); }
 
@@ -334,6 +338,7 @@ class LIBARDOUR_API Diskstream : public SessionObject, public PublicDiskstream
 	off_t         overwrite_offset;
 	bool          _pending_overwrite;
 	bool          overwrite_queued;
+	DiskIOStats   _io_stats;
 	IOChange      input_change_pending;
 	framecnt_t    wrap_buffer_size;
 	framecnt_t    speed_buffer_size;
@@ -0,0 +1,142 @@
+/*
+    Copyright (C) 2016 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef __ardour_dsp_timing_h__
+#define __ardour_dsp_timing_h__
+
+#include <stdint.h>
+#include <algorithm>
+#include <limits>
+
+#include <glib.h>
+
+#include "ardour/cycles.h"
+
+namespace ARDOUR {
+
+/** Collects min/avg/max of the time (in CPU cycles, see get_cycles())
+ *  spent in some piece of DSP code over a window of process calls.
+ *
+ *  start()/stop()/update() must only be called from the one thread that
+ *  runs the code being timed; get_stats() and reset() may be called from
+ *  any thread.  Results are published once per window, so readers never
+ *  see a partially accumulated window and the process thread never blocks.
+ */
+class DSPTiming {
+public:
+	struct Stats {
+		Stats () : min (0), max (0), avg (0), count (0) {}
+
+		uint64_t min;   ///< shortest call in the window, in cycles
+		uint64_t max;   ///< longest call in the window, in cycles
+		double   avg;   ///< mean over the window, in cycles
+		uint32_t count; ///< number of calls that the window covered
+	};
+
+	DSPTiming (uint32_t window = 256)
+		: _window (std::max ((uint32_t) 1, window))
+		, _start (0)
+		, _seq (0)
+		, _reset (0)
+	{
+		clear ();
+	}
+
+	void start () { _start = get_cycles (); }
+	void stop () { update (get_cycles () - _start); }
+
+	void update (cycles_t elapsed)
+	{
+		if (g_atomic_int_get (&_reset)) {
+			g_atomic_int_set (&_reset, 0);
+			clear ();
+			publish (Stats ());
+		}
+
+		uint64_t const e = elapsed;
+
+		_min = std::min (_min, e);
+		_max = std::max (_max, e);
+		_sum += e;
+
+		if (++_count < _window) {
+			return;
+		}
+
+		Stats s;
+		s.min = _min;
+		s.max = _max;
+		s.avg = (double) _sum / _count;
+		s.count = _count;
+		publish (s);
+
+		clear ();
+	}
+
+	/** @return false if no complete window has been collected yet */
+	bool get_stats (Stats& s) const
+	{
+		while (true) {
+			gint const before = g_atomic_int_get (&_seq);
+			if (before & 1) {
+				continue;
+			}
+			s = _published;
+			if (g_atomic_int_get (&_seq) == before) {
+				return s.count > 0;
+			}
+		}
+	}
+
+	/** Discard collected data; takes effect at the next update() */
+	void reset () { g_atomic_int_set (&_reset, 1); }
+
+private:
+	void publish (Stats const & s)
+	{
+		/* odd sequence numbers mean "write in progress" */
+		g_atomic_int_inc (&_seq);
+		_published = s;
+		g_atomic_int_inc (&_seq);
+	}
+
+	void clear ()
+	{
+		_min = std::numeric_limits<uint64_t>::max ();
+		_max = 0;
+		_sum = 0;
+		_count = 0;
+	}
+
+	uint32_t _window;
+	cycles_t _start;
+
+	/* only touched by the process thread */
+	uint64_t _min;
+	uint64_t _max;
+	uint64_t _sum;
+	uint32_t _count;
+
+	mutable volatile gint _seq;
+	volatile gint _reset;
+	Stats _published;
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_dsp_timing_h__ */
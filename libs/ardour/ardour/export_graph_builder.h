@@ -38,6 +38,7 @@ namespace AudioGrapher {
 	template <typename T> class SndfileWriter;
 	template <typename T> class SilenceTrimmer;
 	template <typename T> class TmpFile;
+	template <typename T> class TmpBuffer;
 	template <typename T> class Threader;
 	template <typename T> class AllocatingProcessContext;
 }
@@ -148,10 +149,12 @@ class LIBARDOUR_API ExportGraphBuilder
 		typedef boost::shared_ptr<AudioGrapher::PeakReader> PeakReaderPtr;
 		typedef boost::shared_ptr<AudioGrapher::Normalizer> NormalizerPtr;
 		typedef boost::shared_ptr<AudioGrapher::TmpFile<Sample> > TmpFilePtr;
+		typedef boost::shared_ptr<AudioGrapher::TmpBuffer<Sample> > TmpBufferPtr;
 		typedef boost::shared_ptr<AudioGrapher::Threader<Sample> > ThreaderPtr;
 		typedef boost::shared_ptr<AudioGrapher::AllocatingProcessContext<Sample> > BufferPtr;
 
 		void start_post_processing();
+		framecnt_t expected_frames () const;
 
 		ExportGraphBuilder & parent;
 
@@ -160,7 +163,11 @@ class LIBARDOUR_API ExportGraphBuilder
 
 		BufferPtr       buffer;
 		PeakReaderPtr   peak_reader;
+
+		// Only one of these should be available at a time
 		TmpFilePtr      tmp_file;
+		TmpBufferPtr    tmp_buffer;
+
 		NormalizerPtr   normalizer;
 		ThreaderPtr     threader;
 		boost::ptr_list<SFC> children;
@@ -245,6 +252,11 @@ class LIBARDOUR_API ExportGraphBuilder
 
 	std::list<Normalizer *> normalizers;
 
+	/* bytes reserved by Normalizers keeping their data in RAM, all of which
+	 * share export-normalize-memory-limit
+	 */
+	int64_t normalize_memory_used;
+
 	Glib::ThreadPool thread_pool;
 };
 
@@ -49,6 +49,38 @@ class GraphEdges;
 
 typedef boost::shared_ptr<GraphNode> node_ptr_t;
 
+class GraphTaskGroup;
+
+/** A unit of work that a GraphNode can hand to the process threads
+ *  while it is itself being processed (e.g. one of several independent
+ *  plugin instances).  run() must be realtime-safe and must not dispatch
+ *  further tasks.
+ */
+class LIBARDOUR_API GraphTask
+{
+public:
+	GraphTask () : _group (0) {}
+	virtual ~GraphTask () {}
+	virtual void run () = 0;
+
+private:
+	friend class Graph;
+	GraphTaskGroup* _group;
+};
+
+/** A set of GraphTasks that is started and joined by one node */
+class LIBARDOUR_API GraphTaskGroup
+{
+public:
+	GraphTaskGroup ();
+
+private:
+	friend class Graph;
+	std::string           _name;
+	volatile gint         _pending;
+	PBD::ProcessSemaphore _done;
+};
+
 typedef std::list< node_ptr_t > node_list_t;
 typedef std::set< node_ptr_t > node_set_t;
 
@@ -85,6 +117,11 @@ public:
 
 	bool in_process_thread () const;
 
+	/* sub-node parallelism; all three must be called from the same thread */
+	void start_tasks (GraphTaskGroup&);
+	void dispatch_task (GraphTaskGroup&, GraphTask*);
+	void join_tasks (GraphTaskGroup&);
+
 protected:
 	virtual void session_going_away ();
 
@@ -99,8 +136,12 @@ private:
 	node_list_t _init_trigger_list[2];
 
 	std::vector<GraphNode *> _trigger_queue;
+	/** tasks handed out by nodes that are currently being processed; protected by _trigger_mutex */
+	std::vector<GraphTask *> _task_queue;
 	pthread_mutex_t          _trigger_mutex;
 
+	void run_task (GraphTask*);
+
 	PBD::ProcessSemaphore _execution_sem;
 
 	/** Signalled to start a run of the graph for a process callback */
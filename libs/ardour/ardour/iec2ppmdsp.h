@@ -35,8 +35,14 @@ public:
 
     static void init (float fsamp);
 
+    // Process nchan meters at once, each reading n samples from bufs[i].
+    static void process (Iec2ppmdsp* const *meters, float const * const *bufs, int nchan, int n);
+
 private:
 
+    void get_state (float& z1, float& z2, float& m);
+    void set_state (float z1, float z2, float m);
+
     float          _z1;          // filter state
     float          _z2;          // filter state
     float          _m;           // max value since last read()
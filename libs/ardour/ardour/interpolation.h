@@ -19,6 +19,7 @@
 
 #include <math.h>
 #include <samplerate.h>
+#include <vector>
 
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
@@ -68,6 +69,55 @@ public:
 	framecnt_t interpolate (int channel, framecnt_t nframes, Sample* input, Sample* output);
 };
 
+/** Band-limited (windowed sinc) interpolation using precomputed polyphase
+ *  filter tables.  All channels advance with the same phase, so the filter
+ *  coefficients for each output sample are computed once and then applied
+ *  to every channel.
+ */
+class LIBARDOUR_API PolyphaseInterpolation : public Interpolation {
+public:
+	/** number of input samples on either side of the interpolation point that are used */
+	static const int half_taps = 8;
+	/** extra input samples beyond ceil (nframes * speed) that interpolate() reads */
+	static const int lookahead = half_taps + 1;
+
+	PolyphaseInterpolation ();
+
+	void add_channel_to (int input_buffer_size, int output_buffer_size);
+	void remove_channel_from ();
+	void reset ();
+
+	/** Set the buffers to use for @param channel in the next call to interpolate () */
+	void set_buffers (int channel, Sample* input, Sample* output) {
+		_channels[channel].input = input;
+		_channels[channel].output = output;
+	}
+
+	/** Interpolate @param nframes of output for all channels.
+	 *  @return number of input samples consumed.
+	 */
+	framecnt_t interpolate (framecnt_t nframes);
+
+	/** @return number of input samples that interpolate () would consume, without changing state */
+	framecnt_t distance (framecnt_t nframes) const;
+
+private:
+	static const int taps = 2 * half_taps;
+	static const int phases = 256;
+
+	struct Channel {
+		Channel () : input (0), output (0) {}
+		Sample* input;
+		Sample* output;
+		/** the last half_taps samples of the previous cycle, followed by the first taps of this one */
+		Sample edge[half_taps + taps];
+	};
+
+	std::vector<Channel> _channels;
+
+	static float const * filter_table (double speed);
+};
+
 class BufferSet;
 
 class LIBARDOUR_API CubicMidiInterpolation : public Interpolation {
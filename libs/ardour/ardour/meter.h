@@ -20,6 +20,8 @@
 #define __ardour_meter_h__
 
 #include <vector>
+#include <glib.h>
+#include <boost/shared_ptr.hpp>
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
 #include "ardour/processor.h"
@@ -34,6 +36,7 @@ namespace ARDOUR {
 
 class BufferSet;
 class ChanCount;
+class MeterSnapshot;
 class Session;
 
 /** Meters peaks on the input and stores them for access.
@@ -74,6 +77,9 @@ public:
 
 	float meter_level (uint32_t n, MeterType type);
 
+	/** where this meter publishes its values in the session's MeterSnapshot */
+	uint32_t snapshot_slot () const { return _snapshot_slot; }
+
 	void set_type(MeterType t);
 	MeterType get_type() { return _meter_type; }
 
@@ -103,8 +109,23 @@ private:
 	std::vector<Iec1ppmdsp *> _iec1meter;
 	std::vector<Iec2ppmdsp *> _iec2meter;
 	std::vector<Vumeterdsp *> _vumeter;
+	std::vector<float const *> _audio_data; ///< per-cycle channel pointers for the batched meters
+
+	/* The ballistics meters are only run for types that have been asked
+	 * for via meter_level() recently, so meters that nobody is looking at
+	 * cost no more than the peak.
+	 */
+	volatile guint _polled_types;  ///< set by meter_level(), collected by run()
+	guint          _active_types;  ///< types computed in run()
+	guint          _recent_types;  ///< types polled during the current window
+	framecnt_t     _poll_window;   ///< frames processed in the current window
 
 	MeterType _meter_type;
+
+	void write_snapshot (uint32_t n_midi, uint32_t n_audio);
+
+	boost::shared_ptr<MeterSnapshot> _snapshot;
+	uint32_t                         _snapshot_slot;
 };
 
 } // namespace ARDOUR
@@ -0,0 +1,166 @@
+/*
+    Copyright (C) 2016 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#ifndef __ardour_meter_snapshot_h__
+#define __ardour_meter_snapshot_h__
+
+#include <stdint.h>
+#include <vector>
+
+#include <glib.h>
+#include <glibmm/threads.h>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+/** One contiguous block holding the state of every PeakMeter in a session.
+ *
+ *  Each meter owns a slot in the block. Every few milliseconds the meters
+ *  write their current values into the back buffer during process(), and
+ *  the session publishes it at the end of the cycle. Consumers copy the
+ *  whole front buffer into a View with one sequence check, and then read
+ *  levels from their copy without touching any route or meter.
+ *
+ *  Slots are only (re)allocated while the process thread is not running
+ *  the meter concerned, i.e. under the process lock, just like the meter's
+ *  own buffers.
+ */
+class LIBARDOUR_API MeterSnapshot
+{
+public:
+	MeterSnapshot ();
+
+	/* per-channel values, all but Peak are coefficients */
+	enum Field {
+		Peak = 0,  ///< falloff peak, dB
+		MaxPeak,
+		KRMS,
+		IEC1,
+		IEC2,
+		VU,
+		NFields
+	};
+
+	/* per-slot header, preceding the channels */
+	enum Header {
+		NMidi = 0,    ///< number of MIDI channels (which come first)
+		NHeader
+	};
+
+	static const uint32_t invalid_slot = 0xffffffff;
+
+	/* meter side */
+
+	uint32_t allocate (uint32_t n_channels);
+	uint32_t reallocate (uint32_t slot, uint32_t n_channels);
+	void release (uint32_t slot);
+
+	/** true if meters are to write their values during this cycle */
+	bool writing () const { return _writing; }
+
+	/** @return start of @a slot in the buffer being written, or 0 */
+	float* back (uint32_t slot);
+
+	/** @return meter types requested by readers of @a slot since the last call */
+	guint collect_polled (uint32_t slot);
+
+	/** Raise the peak held for @a slot to @a coeff (linear) if it is
+	 *  lower. The held peak is not double-buffered: it keeps rising until
+	 *  a View takes it (see MeterMCP), so that short peaks between two
+	 *  reads are not lost.
+	 */
+	void hold_peak (uint32_t slot, float coeff);
+
+	/** publish what was written, if anything, and decide whether the
+	 *  next cycle writes. Called by the session after each process cycle.
+	 */
+	void cycle_done (pframes_t nframes, framecnt_t interval);
+
+	/** A consumer's private copy of the snapshot */
+	class LIBARDOUR_API View
+	{
+	public:
+		View ();
+
+		/** copy the latest published snapshot, if it changed.
+		 *  @return true if new data was copied
+		 */
+		bool update (MeterSnapshot&);
+
+		/** same semantics as PeakMeter::meter_level(): in particular
+		 *  MeterMCP is the highest peak of all channels since the last
+		 *  MeterMCP read of @a slot, and reading it clears it. There is
+		 *  one held peak per slot, not per View, so only one consumer
+		 *  (the Mackie surface) should read MeterMCP.
+		 */
+		float level (uint32_t slot, uint32_t chn, MeterType);
+
+		uint32_t n_channels (uint32_t slot) const;
+
+	private:
+		struct Slot {
+			Slot () : offset (0), n_channels (0), wanted (0), hold (false), held (0) {}
+			uint32_t offset;
+			uint32_t n_channels;
+			guint    wanted;
+			bool     hold;  ///< MeterMCP has been read, so take the held peak on update()
+			float    held;  ///< held peak taken, but not yet read
+		};
+
+		std::vector<float> _data;
+		std::vector<Slot>  _slots;
+		gint               _generation;
+		uint32_t           _layout;
+	};
+
+private:
+	friend class View;
+
+	struct Slot {
+		Slot () : offset (0), capacity (0), n_channels (0), used (false) {}
+		uint32_t offset;
+		uint32_t capacity;
+		uint32_t n_channels;
+		bool     used;
+	};
+
+	static uint32_t slot_size (uint32_t n_channels) { return NHeader + n_channels * NFields; }
+
+	uint32_t allocate_unlocked (uint32_t n_channels);
+	void clear (uint32_t slot);
+	float take_held (uint32_t slot);
+
+	mutable Glib::Threads::Mutex _lock; ///< slot table vs. readers, never taken by process()
+
+	std::vector<Slot>  _slots;
+	std::vector<float> _data[2];
+	std::vector<guint> _polled;
+	std::vector<gint>  _held;   ///< per slot, the bits of the held peak (a float >= 0)
+	uint32_t           _size;
+	uint32_t           _layout; ///< bumped whenever the slot table changes
+
+	volatile gint _generation; ///< _data[_generation & 1] is the published buffer
+	bool          _writing;
+	framecnt_t    _since_publish;
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_meter_snapshot_h__ */
@@ -58,6 +58,14 @@ public:
 	bool insert_event(const Evoral::MIDIEvent<TimeType>& event);
 	bool merge_in_place(const MidiBuffer &other);
 
+	/** Put all events back into time order.
+	 *
+	 * insert_event() is linear per event, so adding many out-of-order
+	 * events with it is quadratic.  Instead, push_back() them all and
+	 * call this once; it is O(n log n) and realtime safe.
+	 */
+	void sort();
+
 	/** EventSink interface for non-RT use (export, bounce). */
 	uint32_t write(TimeType time, Evoral::EventType type, uint32_t size, const uint8_t* buf);
 
@@ -180,6 +188,13 @@ private:
 
 	uint8_t* _data; ///< timestamp, event, timestamp, event, ...
 	pframes_t _size;
+
+	/* preallocated by resize() so that sort() and merge_in_place()
+	 * never allocate in the process thread.
+	 */
+	uint8_t*  _scratch; ///< same capacity as _data; swapped with it
+	uint32_t* _index;   ///< event offsets, used by sort()
+	size_t    _index_capacity;
 };
 
 } // namespace ARDOUR
@@ -31,6 +31,7 @@
 #include "ardour/note_fixer.h"
 #include "ardour/playlist.h"
 #include "evoral/Beats.hpp"
+#include "evoral/EventSink.hpp"
 #include "evoral/Note.hpp"
 #include "evoral/Parameter.hpp"
 
@@ -122,11 +123,58 @@ private:
 
 	typedef std::map< Region*, boost::shared_ptr<RegionTracker> > NoteTrackers;
 
+	/** Events read from one region, stored back to back so that reading
+	 *  does not allocate once the buffer has grown to size.
+	 */
+	class ReadBuffer : public Evoral::EventSink<framepos_t> {
+	public:
+		struct Event {
+			framepos_t        time;
+			Evoral::EventType type;
+			uint32_t          size;
+			size_t            offset; ///< of the event data in _data
+		};
+
+		ReadBuffer () : _sorted (true) {}
+
+		uint32_t write (framepos_t time, Evoral::EventType type, uint32_t size, const uint8_t* buf);
+
+		void sort ();
+		void clear ();
+
+		size_t         size () const                   { return _events.size(); }
+		Event const &  operator[] (size_t n) const     { return _events[n]; }
+		uint8_t const* data (Event const & ev) const   { return &_data[ev.offset]; }
+		bool           before (size_t a, ReadBuffer const & other, size_t b) const;
+
+	private:
+		std::vector<Event>   _events;
+		std::vector<uint8_t> _data;
+		bool                 _sorted;
+
+		struct EventOrder;
+	};
+
+	/** Position of the k-way merge in one ReadBuffer */
+	struct MergeCursor {
+		MergeCursor (uint32_t b, size_t p) : buffer (b), pos (p) {}
+		uint32_t buffer;
+		size_t   pos;
+	};
+
+	struct MergeOrder;
+
 	void dump () const;
 
 	NoteTrackers _note_trackers;
 	NoteMode     _note_mode;
 	framepos_t   _read_end;
+
+	/* scratch space for read(), kept to avoid allocating on every call */
+	std::vector< boost::shared_ptr<Region> > _read_regions;
+	std::vector< boost::shared_ptr<Region> > _ended_regions;
+	std::vector<ReadBuffer>                  _read_buffers;
+	std::vector<MergeCursor>                 _merge_heap;
 };
 
 } /* namespace ARDOUR */
@@ -45,6 +45,10 @@ extern "C" {
 LIBARDOUR_API void  x86_sse_find_peaks                 (const float * buf, uint32_t nsamples, float *min, float *max);
 LIBARDOUR_API void  x86_sse_avx_find_peaks             (const float * buf, uint32_t nsamples, float *min, float *max);
 
+LIBARDOUR_API void  x86_sse_mix_buffers_with_gain_vector (float * dst, const float * src, uint32_t nframes, const float * gain);
+LIBARDOUR_API void  x86_sse_mix_buffer_to_outputs (float * const * dst, uint32_t n_outputs, const float * src, uint32_t nframes,
+                                                   const float * initial, const float * target, uint32_t ramp);
+
 /* debug wrappers for SSE functions */
 
 LIBARDOUR_API float debug_compute_peak               (const ARDOUR::Sample * buf, ARDOUR::pframes_t nsamples, float current);
@@ -74,4 +78,16 @@ LIBARDOUR_API void  default_mix_buffers_with_gain     (ARDOUR::Sample * dst, con
 LIBARDOUR_API void  default_mix_buffers_no_gain       (ARDOUR::Sample * dst, const ARDOUR::Sample * src, ARDOUR::pframes_t nframes);
 LIBARDOUR_API void  default_copy_vector				  (ARDOUR::Sample * dst, const ARDOUR::Sample * src, ARDOUR::pframes_t nframes);
 
+/** dst[i] += src[i] * gain[i] */
+LIBARDOUR_API void  default_mix_buffers_with_gain_vector (ARDOUR::Sample * dst, const ARDOUR::Sample * src, ARDOUR::pframes_t nframes, const float * gain);
+
+/** Mix one source into @a n_outputs destinations. The gain for output o
+ *  starts at initial[o] and moves linearly towards target[o] by
+ *  (target[o] - initial[o]) / ramp per frame for the first @a ramp frames,
+ *  then stays at target[o]. Outputs whose gain is zero throughout are
+ *  not touched.
+ */
+LIBARDOUR_API void  default_mix_buffer_to_outputs     (ARDOUR::Sample * const * dst, uint32_t n_outputs, const ARDOUR::Sample * src, ARDOUR::pframes_t nframes,
+                                                       const float * initial, const float * target, ARDOUR::pframes_t ramp);
+
 #endif /* __ardour_mix_h__ */
@@ -25,12 +25,16 @@
 
 #include <boost/weak_ptr.hpp>
 
+#include "pbd/rcu.h"
+
 #include "ardour/ardour.h"
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
 #include "ardour/parameter_descriptor.h"
 #include "ardour/processor.h"
 #include "ardour/automation_control.h"
+#include "ardour/chan_mapping.h"
+#include "ardour/graph.h"
 
 class XMLNode;
 
@@ -202,11 +206,40 @@ class LIBARDOUR_API PluginInsert : public Processor
 	/** details of the match currently being used */
 	Match _match;
 
+	/** Controls whose automation is in Play or Touch state. Maintained
+	 *  by the automation-state-changed handler so that the process thread
+	 *  does not need to walk every plugin parameter in each cycle.
+	 */
+	typedef std::vector<boost::shared_ptr<AutomationControl> > AutomatedControls;
+	SerializedRCUManager<AutomatedControls> _automated_controls;
+
+	/** One replicated plugin instance's share of a connect_and_run() cycle,
+	 *  so that independent instances can be run by different process threads.
+	 */
+	struct PluginInstanceTask : public GraphTask {
+		PluginInstanceTask () : bufs (0), nframes (0), offset (0) {}
+		void run ();
+
+		boost::shared_ptr<Plugin> plugin;
+		BufferSet* bufs;
+		ChanMapping in_map;
+		ChanMapping out_map;
+		pframes_t nframes;
+		framecnt_t offset;
+	};
+
+	std::vector<PluginInstanceTask> _instance_tasks;
+	GraphTaskGroup _instance_tasks_group;
+
+	bool can_run_instances_in_parallel (BufferSet const &) const;
+
 	void automation_run (BufferSet& bufs, framepos_t start, pframes_t nframes);
 	void connect_and_run (BufferSet& bufs, pframes_t nframes, framecnt_t offset, bool with_auto, framepos_t now = 0);
+	bool find_next_automation_event (AutomatedControls const &, framepos_t now, framepos_t end, Evoral::ControlEvent& next_event) const;
 
 	void create_automatable_parameters ();
 	void control_list_automation_state_changed (Evoral::Parameter, AutoState);
+	void automation_list_automation_state_changed (Evoral::Parameter, AutoState);
 	void set_parameter_state_2X (const XMLNode& node, int version);
 	void set_control_ids (const XMLNode&, int version);
 
@@ -137,6 +137,7 @@ class LIBARDOUR_API PluginManager : public boost::noncopyable {
 	int windows_vst_discover (std::string path, bool cache_only = false);
 
 	int lxvst_discover_from_path (std::string path, bool cache_only = false);
+	int vst_scan_jobs () const;
 	int lxvst_discover (std::string path, bool cache_only = false);
 
 	int ladspa_discover (std::string path);
@@ -28,6 +28,7 @@
 
 #include "ardour/ardour.h"
 #include "ardour/buffer_set.h"
+#include "ardour/dsp_timing.h"
 #include "ardour/latent.h"
 #include "ardour/session_object.h"
 #include "ardour/libardour_visibility.h"
@@ -121,6 +122,10 @@ class LIBARDOUR_API Processor : public SessionObject, public Automatable, public
 	void set_owner (SessionObject*);
 	SessionObject* owner() const;
 
+	/** Time spent in run(), as measured by the Route that owns us */
+	DSPTiming& dsp_timing () { return _dsp_timing; }
+	DSPTiming const & dsp_timing () const { return _dsp_timing; }
+
 protected:
 	virtual int set_state_2X (const XMLNode&, int version);
 
@@ -135,6 +140,7 @@ protected:
 	void*     _ui_pointer;
 	ProcessorWindowProxy *_window_proxy;
 	SessionObject* _owner;
+	DSPTiming _dsp_timing;
 };
 
 } // namespace ARDOUR
@@ -25,6 +25,7 @@ namespace ARDOUR {
 class Playlist;
 class Source;
 class Location;
+class DiskIOStats;
 
 /** Public interface to a Diskstream */
 class LIBARDOUR_API PublicDiskstream
@@ -42,6 +43,7 @@ public:
 	virtual void reset_write_sources (bool, bool force = false) = 0;
 	virtual float playback_buffer_load () const = 0;
 	virtual float capture_buffer_load () const = 0;
+	virtual DiskIOStats& io_stats () = 0;
 	virtual int do_refill () = 0;
 	virtual int do_flush (RunContext, bool force = false) = 0;
 	virtual void set_pending_overwrite (bool) = 0;
@@ -94,10 +94,15 @@ CONFIG_VARIABLE (float, midi_readahead,  "midi-readahead", 1.0)
 CONFIG_VARIABLE (BufferingPreset, buffering_preset, "buffering-preset", Medium)
 CONFIG_VARIABLE (float, audio_capture_buffer_seconds, "capture-buffer-seconds", 5.0)
 CONFIG_VARIABLE (float, audio_playback_buffer_seconds, "playback-buffer-seconds", 5.0)
+CONFIG_VARIABLE (uint32_t, audio_block_cache_size, "audio-block-cache-size", 256) /* MB, 0 to disable */
 CONFIG_VARIABLE (float, midi_track_buffer_seconds, "midi-track-buffer-seconds", 1.0)
 CONFIG_VARIABLE (uint32_t, disk_choice_space_threshold,  "disk-choice-space-threshold", 57600000)
 CONFIG_VARIABLE (bool, auto_analyse_audio, "auto-analyse-audio", false)
 
+/* export */
+
+CONFIG_VARIABLE (uint32_t, export_normalize_memory_limit, "export-normalize-memory-limit", 1024) /* MB, intermediate data larger than this is spooled to disk */
+
 /* OSC */
 
 CONFIG_VARIABLE (uint32_t, osc_port, "osc-port", 3819)
@@ -205,6 +210,7 @@ CONFIG_VARIABLE (bool, verify_remove_last_capture, "verify-remove-last-capture",
 CONFIG_VARIABLE (bool, save_history, "save-history", true)
 CONFIG_VARIABLE (int32_t, saved_history_depth, "save-history-depth", 20)
 CONFIG_VARIABLE (int32_t, history_depth, "history-depth", 20)
+CONFIG_VARIABLE (uint32_t, history_memory_budget, "history-memory-budget", 512) /* MB, 0 for no limit */
 CONFIG_VARIABLE (bool, use_overlap_equivalency, "use-overlap-equivalency", false)
 CONFIG_VARIABLE (bool, periodic_safety_backups, "periodic-safety-backups", true)
 CONFIG_VARIABLE (uint32_t, periodic_safety_backup_interval, "periodic-safety-backup-interval", 120)
@@ -230,11 +236,14 @@ CONFIG_VARIABLE (EditMode, edit_mode, "edit-mode", Slide)
 
 CONFIG_VARIABLE (bool, new_plugins_active, "new-plugins-active", true)
 CONFIG_VARIABLE (bool, use_plugin_own_gui, "use-plugin-own-gui", true)
+CONFIG_VARIABLE (uint32_t, plugin_automation_min_block, "plugin-automation-min-block", 32) /* samples, minimum sub-block when splitting a cycle at automation events */
+CONFIG_VARIABLE (bool, parallel_plugin_instances, "parallel-plugin-instances", false)
 CONFIG_VARIABLE (bool, use_windows_vst, "use-windows-vst", true)
 CONFIG_VARIABLE (bool, use_lxvst, "use-lxvst", true)
 CONFIG_VARIABLE (bool, discover_vst_on_start, "discover-vst-on-start", false)
 CONFIG_VARIABLE (bool, verbose_plugin_scan, "verbose-plugin-scan", true)
 CONFIG_VARIABLE (int, vst_scan_timeout, "vst-scan-timeout", 600) /* deciseconds, per plugin, <= 0 no timeout */
+CONFIG_VARIABLE (int, vst_scan_jobs, "vst-scan-jobs", 0) /* concurrent scanner processes, <= 0 number of CPUs */
 CONFIG_VARIABLE (bool, discover_audio_units, "discover-audio-units", false)
 
 /* custom user plugin paths */
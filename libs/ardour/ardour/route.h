@@ -135,6 +135,7 @@ class LIBARDOUR_API Route : public SessionObject, public Automatable, public Rou
 	virtual void realtime_handle_transport_stopped () {}
 	virtual void realtime_locate () {}
         virtual void non_realtime_locate (framepos_t);
+	void render_automation (framepos_t start, framecnt_t len);
 	virtual void set_pending_declick (int);
 
 	/* end of vfunc-based API */
@@ -224,6 +225,10 @@ class LIBARDOUR_API Route : public SessionObject, public Automatable, public Rou
 
 	boost::shared_ptr<Processor> processor_by_id (PBD::ID) const;
 
+	/** Time spent in process_output_buffers(), see Processor::dsp_timing() for the parts */
+	DSPTiming const & dsp_timing () const { return _dsp_timing; }
+	void reset_dsp_timing ();
+
 	boost::shared_ptr<Processor> nth_plugin (uint32_t n);
 	boost::shared_ptr<Processor> nth_send (uint32_t n);
 
@@ -518,6 +523,7 @@ class LIBARDOUR_API Route : public SessionObject, public Automatable, public Rou
 
 	ProcessorList  _processors;
 	mutable Glib::Threads::RWLock   _processor_lock;
+	DSPTiming      _dsp_timing;
 	boost::shared_ptr<Delivery> _main_outs;
 	boost::shared_ptr<InternalSend> _monitor_send;
 	boost::shared_ptr<InternalReturn> _intreturn;
@@ -23,6 +23,9 @@
 
 #include <map>
 #include <set>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
 
 namespace ARDOUR {
 
@@ -43,7 +46,7 @@ public:
 	typedef std::map<GraphVertex, std::set<GraphVertex> > EdgeMap;
 
 	void add (GraphVertex from, GraphVertex to, bool via_sends_only);
-	bool has (GraphVertex from, GraphVertex to, bool* via_sends_only);
+	bool has (GraphVertex from, GraphVertex to, bool* via_sends_only) const;
 	std::set<GraphVertex> from (GraphVertex r) const;
 	void remove (GraphVertex from, GraphVertex to);
 	bool has_none_to (GraphVertex to) const;
@@ -56,6 +59,7 @@ private:
 	typedef std::multimap<GraphVertex, std::pair<GraphVertex, bool> > EdgeMapWithSends;
 
 	EdgeMapWithSends::iterator find_in_from_to_with_sends (GraphVertex, GraphVertex);
+	EdgeMapWithSends::const_iterator find_in_from_to_with_sends (GraphVertex, GraphVertex) const;
 
 	/** map of edges with from as `first' and to as `second' */
 	EdgeMap _from_to;
@@ -68,6 +72,56 @@ private:
 	EdgeMapWithSends _from_to_with_sends;
 };
 
+/** The transitive closure of a GraphEdges, i.e. which routes feed which
+ *  other routes either directly or through any number of intermediate
+ *  routes.  Each route has a bitset of the routes that feed it, so that
+ *  reachability questions are a bit test rather than a walk through every
+ *  route's fed-by list.
+ *
+ *  Routes are identified by their position in the list given to build().
+ */
+class LIBARDOUR_API RouteReachability
+{
+public:
+	/** @param sorted Routes in topological order, as returned by topological_sort().
+	 *  @param edges The direct edges between those routes.
+	 */
+	void build (RouteList const & sorted, GraphEdges const & edges);
+
+	/** @return true if this was built for exactly the routes in r, in the same order */
+	bool matches (RouteList const & r) const;
+
+	/** @return position of r in the list given to build(), or -1 if it was not there */
+	int index_of (Route const * r) const;
+
+	size_t size () const { return _routes.size (); }
+
+	/** @param via_sends_only if non-0, filled in with true if every path
+	 *  from `from' to `to' leaves `from' by a send.
+	 *  @return true if the route at position `from' feeds the one at `to'.
+	 */
+	bool feeds (size_t from, size_t to, bool* via_sends_only = 0) const {
+		if (!_fed_by[to][from]) {
+			return false;
+		}
+		if (via_sends_only) {
+			*via_sends_only = !_fed_by_signal[to][from];
+		}
+		return true;
+	}
+
+	/** @return the set of routes that feed the route at position `to' */
+	boost::dynamic_bitset<> const & fed_by (size_t to) const { return _fed_by[to]; }
+
+private:
+	std::vector<Route const *> _routes;
+	std::map<Route const *, int> _index;
+	/** _fed_by[b][a] is set if a feeds b */
+	std::vector<boost::dynamic_bitset<> > _fed_by;
+	/** _fed_by_signal[b][a] is set if a feeds b other than only via sends */
+	std::vector<boost::dynamic_bitset<> > _fed_by_signal;
+};
+
 boost::shared_ptr<RouteList> topological_sort (
 	boost::shared_ptr<RouteList>,
 	GraphEdges
@@ -31,6 +31,8 @@ namespace ARDOUR {
 	typedef void  (*mix_buffers_with_gain_t)	(ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, float);
 	typedef void  (*mix_buffers_no_gain_t)		(ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 	typedef void  (*copy_vector_t)			    (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
+	typedef void  (*mix_buffers_with_gain_vector_t) (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, const float *);
+	typedef void  (*mix_buffer_to_outputs_t)        (ARDOUR::Sample * const *, uint32_t, const ARDOUR::Sample *, pframes_t, const float *, const float *, pframes_t);
 
 	LIBARDOUR_API extern compute_peak_t		compute_peak;
 	LIBARDOUR_API extern find_peaks_t               find_peaks;
@@ -38,6 +40,8 @@ namespace ARDOUR {
 	LIBARDOUR_API extern mix_buffers_with_gain_t	mix_buffers_with_gain;
 	LIBARDOUR_API extern mix_buffers_no_gain_t	mix_buffers_no_gain;
 	LIBARDOUR_API extern copy_vector_t			copy_vector;
+	LIBARDOUR_API extern mix_buffers_with_gain_vector_t mix_buffers_with_gain_vector;
+	LIBARDOUR_API extern mix_buffer_to_outputs_t    mix_buffer_to_outputs;
 }
 
 #endif /* __ardour_runtime_functions_h__ */
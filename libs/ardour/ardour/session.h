@@ -23,6 +23,7 @@
 #include "libardour-config.h"
 
 #include <exception>
+#include <iosfwd>
 #include <list>
 #include <map>
 #include <set>
@@ -56,6 +57,7 @@
 #include "ardour/ardour.h"
 #include "ardour/chan_count.h"
 #include "ardour/delivery.h"
+#include "ardour/dsp_timing.h"
 #include "ardour/interthread_info.h"
 #include "ardour/rc_configuration.h"
 #include "ardour/session_configuration.h"
@@ -107,6 +109,7 @@ class Graph;
 class IO;
 class IOProcessor;
 class ImportStatus;
+class MeterSnapshot;
 class MidiClockTicker;
 class MidiControlUI;
 class MidiPortManager;
@@ -230,6 +233,20 @@ class LIBARDOUR_API Session : public PBD::StatefulDestructible, public PBD::Scop
 	BufferSet& get_route_buffers (ChanCount count = ChanCount::ZERO, bool silence = true);
 	BufferSet& get_mix_buffers (ChanCount count = ChanCount::ZERO);
 
+	/** @return the graph used to process routes, or 0 if routes are processed by a single thread */
+	boost::shared_ptr<Graph> process_graph () const { return _process_graph; }
+
+	/** The most recent DSP timing window of a route (processor == 0) or one of its processors */
+	struct ProcessorTiming {
+		boost::shared_ptr<Route>     route;
+		boost::shared_ptr<Processor> processor;
+		DSPTiming::Stats             stats;
+	};
+
+	/** Fill @param timings for all routes and their processors, most expensive (by average) first */
+	void get_dsp_timing (std::vector<ProcessorTiming>& timings) const;
+	void reset_dsp_timing ();
+
 	bool have_rec_enabled_track () const;
     bool have_rec_disabled_track () const;
 
@@ -237,7 +254,21 @@ class LIBARDOUR_API Session : public PBD::StatefulDestructible, public PBD::Scop
 
 	void refill_all_track_buffers ();
 	Butler* butler() { return _butler; }
+
+	/** Write the butler's timings and every track's disk I/O statistics,
+	 *  including its most recent underruns, to @param out
+	 */
+	void disk_io_report (std::ostream& out) const;
+	/** Ask for all disk I/O statistics to be cleared. Safe while rolling:
+	 *  the butler and process threads each clear their own figures.
+	 */
+	void reset_disk_io_stats ();
+
+	/** levels of all meters in the session, published by the process thread */
+	boost::shared_ptr<MeterSnapshot> meter_snapshot () const { return _meter_snapshot; }
 	void butler_transport_work ();
+	void render_automation ();
+	bool automation_render_wanted () const;
 
 	void refresh_disk_space ();
 
@@ -1264,6 +1295,7 @@ class LIBARDOUR_API Session : public PBD::StatefulDestructible, public PBD::Scop
 	bool              pending_auto_loop;
 
 	Butler* _butler;
+	boost::shared_ptr<MeterSnapshot> _meter_snapshot;
 
 	static const PostTransportWork ProcessCannotProceedMask =
 		PostTransportWork (
@@ -1784,6 +1816,40 @@ class LIBARDOUR_API Session : public PBD::StatefulDestructible, public PBD::Scop
 	void rt_set_record_safe (boost::shared_ptr<RouteList>, bool yn, bool group_override);
 	void rt_set_monitoring (boost::shared_ptr<RouteList>, MonitorChoice, bool group_override);
 
+	/* allocation-free path for the above: when the caller does not need a
+	 * completion callback, changes are queued as plain values instead of
+	 * SessionEvents holding a bound RouteList.
+	 */
+	struct RTControlOp {
+		enum Type {
+			Solo,
+			ClearAllSolo,
+			JustOneSolo,
+			Listen,
+			Mute,
+			SoloIsolate,
+			RecordEnable,
+			RecordSafe,
+			Monitoring
+		};
+
+		Type         type;
+		uint32_t     index;  ///< position of the route in `routes' when queued
+		Route const* route;  ///< only compared against the route found at @a index, never dereferenced
+		int32_t      value;  ///< bool, or MonitorChoice for Monitoring
+		bool         group_override;
+	};
+
+	RingBuffer<RTControlOp>   _rt_control_ops;
+	volatile gint             _rt_control_events;     ///< changes that fell back to a SessionEvent and are not yet applied
+	Glib::Threads::Mutex      _rt_control_write_lock; ///< serializes writers of _rt_control_ops
+	std::vector<RTControlOp>  _rt_control_batch;      ///< protected by _rt_control_write_lock
+
+	bool queue_rt_control (boost::shared_ptr<RouteList>, RTControlOp::Type, int32_t value, SessionEvent::RTeventCallback const & after, bool group_override);
+	bool write_rt_control (boost::shared_ptr<RouteList>, RTControlOp::Type, int32_t value, SessionEvent::RTeventCallback const & after, bool group_override);
+	void process_rt_controls ();
+	void apply_rt_control (Route*, RTControlOp const &, RouteList const &);
+
 	/** temporary list of Diskstreams used only during load of 2.X sessions */
 	std::list<boost::shared_ptr<Diskstream> > _diskstreams_2X;
 
@@ -1797,6 +1863,15 @@ class LIBARDOUR_API Session : public PBD::StatefulDestructible, public PBD::Scop
 	/** true if timecode transmission by the transport is suspended, otherwise false */
 	mutable gint _suspend_timecode_transmission;
 
+	/* range of the transport that render_automation() last covered.
+	 * Written by the butler, read by the process thread; the sequence
+	 * count is odd while a new range is being written.
+	 */
+	volatile gint _automation_rendered_seq;
+	framepos_t    _automation_rendered_from;
+	framepos_t    _automation_rendered_until;
+	framecnt_t automation_render_window () const { return _current_frame_rate; }
+
 	void update_locations_after_tempo_map_change (const Locations::LocationList &);
 
 	void start_time_changed (framepos_t);
@@ -1813,6 +1888,11 @@ class LIBARDOUR_API Session : public PBD::StatefulDestructible, public PBD::Scop
 	*/
 	GraphEdges _current_route_graph;
 
+	/** Transitive closure of _current_route_graph, rebuilt along with it;
+	    used to propagate solo changes without searching fed-by lists.
+	*/
+	SerializedRCUManager<RouteReachability> _route_reachability;
+
 	uint32_t next_control_id () const;
 	int32_t _order_hint;
 	bool ignore_route_processor_changes;
@@ -56,6 +56,7 @@ CONFIG_VARIABLE (std::string, timecode_generator_offset, "timecode-generator-off
 CONFIG_VARIABLE (bool, glue_new_markers_to_bars_and_beats, "glue-new-markers-to-bars-and-beats", false)
 CONFIG_VARIABLE (bool, midi_copy_is_fork, "midi-copy-is-fork", false)
 CONFIG_VARIABLE (bool, glue_new_regions_to_bars_and_beats, "glue-new-regions-to-bars-and-beats", false)
+CONFIG_VARIABLE (bool, high_quality_varispeed, "high-quality-varispeed", false)
 /* These are GUI-only properties and should not be present in this
  * context. There needs to be a new GUI-level session-scoped configuration
  * variable header.
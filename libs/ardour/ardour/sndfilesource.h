@@ -90,6 +90,16 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 	SF_INFO _info;
 	BroadcastInfo *_broadcast_info;
 
+	/* read-only files holding plain PCM or float data are read straight
+	 * from a memory map rather than through libsndfile
+	 */
+	class Mapping;
+	mutable Mapping* _mapping;
+	mutable bool     _mapping_checked;
+
+	bool map_data () const;
+	void unmap_data ();
+
 	void init_sndfile ();
 	int open();
 	int setup_broadcast_info (framepos_t when, struct tm&, time_t);
@@ -127,6 +127,7 @@ class LIBARDOUR_API Track : public Route, public PublicDiskstream
 	void reset_write_sources (bool, bool force = false);
 	float playback_buffer_load () const;
 	float capture_buffer_load () const;
+	DiskIOStats& io_stats ();
 	int do_refill ();
 	int do_flush (RunContext, bool force = false);
 	void set_pending_overwrite (bool);
@@ -23,6 +23,7 @@
 
 #include "ardour/libardour_visibility.h"
 #include "ardour/vst_types.h"
+#include <string>
 #include <vector>
 
 /* Cache File extensions */
@@ -35,9 +36,11 @@
 # if ( defined(__x86_64__) || defined(_M_X64) )
 #define VST_EXT_INFOFILE  ".fsi64"
 #define VST_BLACKLIST  "vst64_blacklist.txt"
+#define VST_INDEXFILE  "vst64_index.txt"
 #else
 #define VST_EXT_INFOFILE  ".fsi32"
 #define VST_BLACKLIST  "vst32_blacklist.txt"
+#define VST_INDEXFILE  "vst32_index.txt"
 #endif
 
 #ifndef VST_SCANNER_APP
@@ -52,6 +55,20 @@ enum VSTScanMode {
 
 LIBARDOUR_API extern void vstfx_free_info_list (std::vector<VSTInfo *> *infos);
 
+#ifndef VST_SCANNER_APP
+/** run up to @param jobs external scanner processes concurrently for all
+ * plugins in @param dllpaths which are neither blacklisted nor cached yet.
+ * @param type is only used for PluginScanMessage
+ */
+LIBARDOUR_API extern void vstfx_scan_parallel (std::vector<std::string> const & dllpaths, std::string const & type, int jobs);
+
+/** write the consolidated cache index (path + mtime -> plugin info) to disk */
+LIBARDOUR_API extern void vstfx_save_index ();
+
+/** drop the consolidated cache index from memory and disk */
+LIBARDOUR_API extern void vstfx_clear_index ();
+#endif
+
 #ifdef LXVST_SUPPORT
 LIBARDOUR_API extern std::vector<VSTInfo*> * vstfx_get_info_lx (char *, enum VSTScanMode mode = VST_SCAN_USE_APP);
 #endif
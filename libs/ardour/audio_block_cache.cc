@@ -0,0 +1,206 @@
+/*
+    Copyright (C) 2016 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <algorithm>
+#include <cstring>
+
+#include <stdint.h>
+
+#include "ardour/audio_block_cache.h"
+
+using namespace ARDOUR;
+
+AudioBlockCache* AudioBlockCache::_instance = 0;
+
+AudioBlockCache&
+AudioBlockCache::instance ()
+{
+	if (_instance == 0) {
+		_instance = new AudioBlockCache;
+	}
+	return *_instance;
+}
+
+AudioBlockCache::AudioBlockCache ()
+	: _shard_capacity (0)
+{
+}
+
+AudioBlockCache::Shard&
+AudioBlockCache::shard_for (Key const & key)
+{
+	/* spread consecutive blocks of a source over the shards, so that a
+	 * long read does not queue up on a single lock
+	 */
+	uintptr_t const h = (reinterpret_cast<uintptr_t> (key.source) >> 4) + (uintptr_t) key.block;
+	return _shards[h % n_shards];
+}
+
+void
+AudioBlockCache::set_capacity (size_t bytes)
+{
+	size_t const per_shard = bytes / n_shards;
+
+	for (uint32_t n = 0; n < n_shards; ++n) {
+		Glib::Threads::Mutex::Lock lm (_shards[n].lock);
+		trim (_shards[n], per_shard);
+	}
+
+	_shard_capacity = per_shard;
+}
+
+size_t
+AudioBlockCache::capacity () const
+{
+	return _shard_capacity * n_shards;
+}
+
+/** Copy @a cnt frames, starting @a offset frames into block number @a block
+ *  of source @a src, to @a dst.
+ *  @param valid Set to the number of frames copied that hold data from the
+ *  file; the remainder, if any, lies beyond its end and is zeroed.
+ *  @return false if the block is not in the cache.
+ */
+bool
+AudioBlockCache::lookup (AudioSource const * src, framepos_t block, framecnt_t offset, framecnt_t cnt, Sample* dst, framecnt_t& valid)
+{
+	Key const key (src, block);
+	Shard& shard (shard_for (key));
+
+	Glib::Threads::Mutex::Lock lm (shard.lock);
+
+	Index::iterator i = shard.index.find (key);
+
+	if (i == shard.index.end()) {
+		++shard.misses;
+		return false;
+	}
+
+	++shard.hits;
+
+	/* move to the front of the LRU list */
+	shard.lru.splice (shard.lru.begin(), shard.lru, i->second);
+
+	Block const & b (*i->second);
+
+	valid = std::max ((framecnt_t) 0, std::min (cnt, b.valid - offset));
+
+	if (valid) {
+		memcpy (dst, &b.data[offset], sizeof (Sample) * valid);
+	}
+	if (valid < cnt) {
+		memset (dst + valid, 0, sizeof (Sample) * (cnt - valid));
+	}
+
+	return true;
+}
+
+/** Add a block read from source @a src.  The contents of @a data are taken
+ *  over by the cache, leaving @a data empty.
+ */
+void
+AudioBlockCache::insert (AudioSource const * src, framepos_t block, std::vector<Sample>& data, framecnt_t valid)
+{
+	Key const key (src, block);
+	Shard& shard (shard_for (key));
+	size_t const bytes = data.size() * sizeof (Sample);
+
+	Glib::Threads::Mutex::Lock lm (shard.lock);
+
+	if (bytes > _shard_capacity || shard.index.find (key) != shard.index.end()) {
+		/* too big, or another thread read the same block meanwhile */
+		return;
+	}
+
+	trim (shard, _shard_capacity - bytes);
+
+	shard.lru.push_front (Block (key));
+	shard.lru.front().data.swap (data);
+	shard.lru.front().valid = valid;
+	shard.index.insert (std::make_pair (key, shard.lru.begin()));
+	shard.bytes += bytes;
+}
+
+void
+AudioBlockCache::drop (AudioSource const * src)
+{
+	for (uint32_t n = 0; n < n_shards; ++n) {
+
+		Shard& shard (_shards[n]);
+		Glib::Threads::Mutex::Lock lm (shard.lock);
+
+		Index::iterator i = shard.index.lower_bound (Key (src, 0));
+
+		while (i != shard.index.end() && i->first.source == src) {
+			shard.bytes -= i->second->data.size() * sizeof (Sample);
+			shard.lru.erase (i->second);
+			shard.index.erase (i++);
+		}
+	}
+}
+
+void
+AudioBlockCache::clear ()
+{
+	for (uint32_t n = 0; n < n_shards; ++n) {
+		Glib::Threads::Mutex::Lock lm (_shards[n].lock);
+		_shards[n].lru.clear ();
+		_shards[n].index.clear ();
+		_shards[n].bytes = 0;
+	}
+}
+
+void
+AudioBlockCache::trim (Shard& shard, size_t limit)
+{
+	while (shard.bytes > limit && !shard.lru.empty()) {
+		Block& b (shard.lru.back());
+		shard.bytes -= b.data.size() * sizeof (Sample);
+		shard.index.erase (b.key);
+		shard.lru.pop_back ();
+		++shard.evictions;
+	}
+}
+
+AudioBlockCache::Stats
+AudioBlockCache::stats () const
+{
+	Stats s;
+
+	for (uint32_t n = 0; n < n_shards; ++n) {
+		Glib::Threads::Mutex::Lock lm (_shards[n].lock);
+		s.hits += _shards[n].hits;
+		s.misses += _shards[n].misses;
+		s.evictions += _shards[n].evictions;
+		s.blocks += _shards[n].lru.size();
+		s.bytes += _shards[n].bytes;
+	}
+
+	return s;
+}
+
+void
+AudioBlockCache::reset_stats ()
+{
+	for (uint32_t n = 0; n < n_shards; ++n) {
+		Glib::Threads::Mutex::Lock lm (_shards[n].lock);
+		_shards[n].hits = 0;
+		_shards[n].misses = 0;
+		_shards[n].evictions = 0;
+	}
+}
@@ -509,6 +509,11 @@ AudioDiskstream::process (BufferSet& bufs, framepos_t transport_frame, pframes_t
 
 			chaninfo->capture_buf->get_write_vector (&chaninfo->capture_vector);
 
+			if (n == 0) {
+				_io_stats.capture_fill (1.0 - (double) (chaninfo->capture_vector.len[0] + chaninfo->capture_vector.len[1]) /
+				                        (double) chaninfo->capture_buf->bufsize());
+			}
+
 			if (rec_nframes <= (framecnt_t) chaninfo->capture_vector.len[0]) {
 
 				chaninfo->current_capture_buffer = chaninfo->capture_vector.buf[0];
@@ -607,7 +612,7 @@ AudioDiskstream::process (BufferSet& bufs, framepos_t transport_frame, pframes_t
 		/* no varispeed playback if we're recording, because the output .... TBD */
 
 		if (rec_nframes == 0 && _actual_speed != 1.0) {
-			necessary_samples = (framecnt_t) ceil ((nframes * fabs (_actual_speed))) + 2;
+			necessary_samples = (framecnt_t) ceil ((nframes * fabs (_actual_speed))) + PolyphaseInterpolation::lookahead;
 		} else {
 			necessary_samples = nframes;
 		}
@@ -616,6 +621,12 @@ AudioDiskstream::process (BufferSet& bufs, framepos_t transport_frame, pframes_t
 			(*chan)->playback_buf->get_read_vector (&(*chan)->playback_vector);
 		}
 
+		if (!c->empty()) {
+			ChannelInfo* chaninfo (c->front());
+			_io_stats.playback_fill ((double) (chaninfo->playback_vector.len[0] + chaninfo->playback_vector.len[1]) /
+			                         (double) chaninfo->playback_buf->bufsize());
+		}
+
 		n = 0;
 
 		/* Setup current_playback_buffer in each ChannelInfo to point to data that someone
@@ -639,6 +650,8 @@ AudioDiskstream::process (BufferSet& bufs, framepos_t transport_frame, pframes_t
 					cerr << "underrun for " << _name << endl;
                                         DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 underrun in %2, rec_nframes = %3 total space = %4\n",
                                                                                     DEBUG_THREAD_SELF, name(), rec_nframes, total));
+					_io_stats.underrun (transport_frame, necessary_samples, total,
+					                    _pending_overwrite || _session.butler()->transport_work_requested());
 					DiskUnderrun ();
 					return -1;
 
@@ -669,16 +682,33 @@ AudioDiskstream::process (BufferSet& bufs, framepos_t transport_frame, pframes_t
 
 		if (rec_nframes == 0 && _actual_speed != 1.0f && _actual_speed != -1.0f) {
 
-			interpolation.set_speed (_target_speed);
+			if (_session.config.get_high_quality_varispeed ()) {
 
-			int channel = 0;
-			for (ChannelList::iterator chan = c->begin(); chan != c->end(); ++chan, ++channel) {
-				ChannelInfo* chaninfo (*chan);
+				/* all channels in one pass */
+
+				polyphase_interpolation.set_speed (_target_speed);
+
+				int channel = 0;
+				for (ChannelList::iterator chan = c->begin(); chan != c->end(); ++chan, ++channel) {
+					polyphase_interpolation.set_buffers (channel, (*chan)->current_playback_buffer, (*chan)->speed_buffer);
+					(*chan)->current_playback_buffer = (*chan)->speed_buffer;
+				}
+
+				playback_distance = polyphase_interpolation.interpolate (nframes);
+
+			} else {
+
+				interpolation.set_speed (_target_speed);
 
-				playback_distance = interpolation.interpolate (
-					channel, nframes, chaninfo->current_playback_buffer, chaninfo->speed_buffer);
+				int channel = 0;
+				for (ChannelList::iterator chan = c->begin(); chan != c->end(); ++chan, ++channel) {
+					ChannelInfo* chaninfo (*chan);
 
-				chaninfo->current_playback_buffer = chaninfo->speed_buffer;
+					playback_distance = interpolation.interpolate (
+						channel, nframes, chaninfo->current_playback_buffer, chaninfo->speed_buffer);
+
+					chaninfo->current_playback_buffer = chaninfo->speed_buffer;
+				}
 			}
 
 		} else {
@@ -739,11 +769,16 @@ AudioDiskstream::calculate_playback_distance (pframes_t nframes)
 	if (record_enabled()) {
 		playback_distance = nframes;
 	} else if (_actual_speed != 1.0f && _actual_speed != -1.0f) {
-		interpolation.set_speed (_target_speed);
-		boost::shared_ptr<ChannelList> c = channels.reader();
-		int channel = 0;
-		for (ChannelList::iterator chan = c->begin(); chan != c->end(); ++chan, ++channel) {
-			playback_distance = interpolation.interpolate (channel, nframes, NULL, NULL);
+		if (_session.config.get_high_quality_varispeed ()) {
+			polyphase_interpolation.set_speed (_target_speed);
+			playback_distance = polyphase_interpolation.distance (nframes);
+		} else {
+			interpolation.set_speed (_target_speed);
+			boost::shared_ptr<ChannelList> c = channels.reader();
+			int channel = 0;
+			for (ChannelList::iterator chan = c->begin(); chan != c->end(); ++chan, ++channel) {
+				playback_distance = interpolation.interpolate (channel, nframes, NULL, NULL);
+			}
 		}
 	} else {
 		playback_distance = nframes;
@@ -1245,6 +1280,8 @@ AudioDiskstream::_do_refill (Sample* mixdown_buffer, float* gain_buffer, framecn
 	}
 
 	framepos_t file_frame_tmp = 0;
+	uint32_t reads = 0;
+	framecnt_t samples_read = 0;
 
 	/* total_space is in samples. We want to optimize read sizes in various sizes using bytes */
 
@@ -1267,8 +1304,7 @@ AudioDiskstream::_do_refill (Sample* mixdown_buffer, float* gain_buffer, framecn
 	// << c->front()->playback_buf->bufsize() * bits_per_sample / 8 << " bps = " << bits_per_sample << endl;
 	// cerr << name () << " read samples = " << samples_to_read << " out of total space " << total_space << " in buffer of " << c->front()->playback_buf->bufsize() << " samples\n";
 
-	// uint64_t before = g_get_monotonic_time ();
-	// uint64_t elapsed;
+	_io_stats.refill_started ();
 
 	for (chan_n = 0, i = c->begin(); i != c->end(); ++i, ++chan_n) {
 
@@ -1317,12 +1353,15 @@ AudioDiskstream::_do_refill (Sample* mixdown_buffer, float* gain_buffer, framecn
 
 		if (to_read) {
 
+			++reads;
+
 			if (read (buf1, mixdown_buffer, gain_buffer, file_frame_tmp, to_read, chan_n, reversed)) {
 				ret = -1;
 				goto out;
 			}
 
 			chan->playback_buf->increment_write_ptr (to_read);
+			samples_read += to_read;
 			ts -= to_read;
 		}
 
@@ -1335,12 +1374,15 @@ AudioDiskstream::_do_refill (Sample* mixdown_buffer, float* gain_buffer, framecn
 			   all of vector.len[1] as well.
 			*/
 
+			++reads;
+
 			if (read (buf2, mixdown_buffer, gain_buffer, file_frame_tmp, to_read, chan_n, reversed)) {
 				ret = -1;
 				goto out;
 			}
 
 			chan->playback_buf->increment_write_ptr (to_read);
+			samples_read += to_read;
 		}
 
 		if (zero_fill) {
@@ -1349,9 +1391,6 @@ AudioDiskstream::_do_refill (Sample* mixdown_buffer, float* gain_buffer, framecn
 
 	}
 
-	// elapsed = g_get_monotonic_time () - before;
-	// cerr << "\tbandwidth = " << (byte_size_for_read / 1048576.0) / (elapsed/1000000.0) << "MB/sec\n";
-
 	file_frame = file_frame_tmp;
 	assert (file_frame >= 0);
 
@@ -1360,6 +1399,8 @@ AudioDiskstream::_do_refill (Sample* mixdown_buffer, float* gain_buffer, framecn
 	c->front()->playback_buf->get_write_vector (&vector);
 
   out:
+	/* what we read, in the session's native sample format */
+	_io_stats.refill_done ((uint64_t) samples_read * bits_per_sample / 8, reads);
 	return ret;
 }
 
@@ -2119,7 +2160,7 @@ AudioDiskstream::allocate_temporary_buffers ()
 	*/
 
 	double const sp = max (fabs (_actual_speed), 1.2);
-	framecnt_t required_wrap_size = (framecnt_t) ceil (_session.get_block_size() * sp) + 2;
+	framecnt_t required_wrap_size = (framecnt_t) ceil (_session.get_block_size() * sp) + PolyphaseInterpolation::lookahead;
 
 	if (required_wrap_size > wrap_buffer_size) {
 
@@ -2192,6 +2233,9 @@ AudioDiskstream::add_channel_to (boost::shared_ptr<ChannelList> c, uint32_t how_
 		interpolation.add_channel_to (
 			_session.butler()->audio_diskstream_playback_buffer_size(),
 			speed_buffer_size);
+		polyphase_interpolation.add_channel_to (
+			_session.butler()->audio_diskstream_playback_buffer_size(),
+			speed_buffer_size);
 	}
 
 	_n_channels.set(DataType::AUDIO, c->size());
@@ -2215,6 +2259,7 @@ AudioDiskstream::remove_channel_from (boost::shared_ptr<ChannelList> c, uint32_t
 		delete c->back();
 		c->pop_back();
 		interpolation.remove_channel_from ();
+		polyphase_interpolation.remove_channel_from ();
 	}
 
 	_n_channels.set(DataType::AUDIO, c->size());
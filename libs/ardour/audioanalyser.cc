@@ -40,9 +40,12 @@ using namespace Vamp;
 using namespace PBD;
 using namespace ARDOUR;
 
+Glib::Threads::Mutex AudioAnalyser::loader_lock;
+
 AudioAnalyser::AudioAnalyser (float sr, AnalysisPluginKey key)
 	: sample_rate (sr)
 	, plugin_key (key)
+	, cancelled (0)
 {
 	/* create VAMP plugin and initialize */
 
@@ -62,9 +65,12 @@ AudioAnalyser::initialize_plugin (AnalysisPluginKey key, float sr)
 {
 	using namespace Vamp::HostExt;
 
-	PluginLoader* loader (PluginLoader::getInstance());
-
-	plugin = loader->loadPlugin (key, sr, PluginLoader::ADAPT_ALL_SAFE);
+	{
+		/* analyses may be set up on several threads at once */
+		Glib::Threads::Mutex::Lock lm (loader_lock);
+		PluginLoader* loader (PluginLoader::getInstance());
+		plugin = loader->loadPlugin (key, sr, PluginLoader::ADAPT_ALL_SAFE);
+	}
 
 	if (!plugin) {
 		error << string_compose (_("VAMP Plugin \"%1\" could not be loaded"), key) << endmsg;
@@ -118,6 +124,10 @@ AudioAnalyser::analyse (const string& path, Readable* src, uint32_t channel)
 
 		framecnt_t to_read;
 
+		if (g_atomic_int_get (&cancelled)) {
+			goto out;
+		}
+
 		/* read from source */
 
 		to_read = min ((len - pos), (framecnt_t) bufsize);
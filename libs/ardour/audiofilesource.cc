@@ -21,6 +21,7 @@
 #include "libardour-config.h"
 #endif
 
+#include <cstring>
 #include <vector>
 
 #include <sys/time.h>
@@ -47,6 +48,7 @@
 #include <glibmm/fileutils.h>
 #include <glibmm/threads.h>
 
+#include "ardour/audio_block_cache.h"
 #include "ardour/audiofilesource.h"
 #include "ardour/debug.h"
 #include "ardour/sndfilesource.h"
@@ -149,12 +151,69 @@ AudioFileSource::AudioFileSource (Session& s, const XMLNode& node, bool must_exi
 AudioFileSource::~AudioFileSource ()
 {
 	DEBUG_TRACE (DEBUG::Destruction, string_compose ("AudioFileSource destructor %1, removable? %2\n", _path, removable()));
+	AudioBlockCache::instance().drop (this);
 	if (removable()) {
 		::g_unlink (_path.c_str());
 		::g_unlink (_peakpath.c_str());
 	}
 }
 
+/** Read via the shared AudioBlockCache once the file can no longer change */
+framecnt_t
+AudioFileSource::read (Sample *dst, framepos_t start, framecnt_t cnt, int channel) const
+{
+	AudioBlockCache& cache (AudioBlockCache::instance());
+
+	if (writable() || cache.capacity() == 0) {
+		return AudioSource::read (dst, start, cnt, channel);
+	}
+
+	framecnt_t const bf = AudioBlockCache::block_frames;
+	framecnt_t done = 0;
+
+	while (done < cnt) {
+
+		framepos_t const pos = start + done;
+		framepos_t const block = pos / bf;
+		framecnt_t const offset = pos - (block * bf);
+		framecnt_t const n = min (cnt - done, bf - offset);
+		framecnt_t valid;
+
+		if (!cache.lookup (this, block, offset, n, dst + done, valid)) {
+
+			vector<Sample> data (bf);
+			framecnt_t got;
+
+			{
+				Glib::Threads::Mutex::Lock lm (_lock);
+				got = max ((framecnt_t) 0, min (bf, read_unlocked (&data[0], block * bf, bf)));
+			}
+
+			valid = max ((framecnt_t) 0, min (n, got - offset));
+
+			if (valid) {
+				memcpy (dst + done, &data[offset], sizeof (Sample) * valid);
+			}
+
+			/* don't keep the results of a failed read around */
+
+			if (got == min (bf, max ((framecnt_t) 0, _length - (block * bf)))) {
+				cache.insert (this, block, data, got);
+			}
+		}
+
+		if (valid < n) {
+			/* hit the end of the file */
+			memset (dst + done + valid, 0, sizeof (Sample) * (cnt - done - valid));
+			return done + valid;
+		}
+
+		done += n;
+	}
+
+	return cnt;
+}
+
 int
 AudioFileSource::init (const string& pathstr, bool must_exist)
 {
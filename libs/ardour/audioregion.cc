@@ -1404,41 +1404,126 @@ AudioRegion::set_scale_amplitude (gain_t g)
 	send_change (PropertyChange (Properties::scale_amplitude));
 }
 
+/** Fill `maxima' with the loudest absolute sample value across all
+ *  channels in each of `npeaks' whole peaks starting at `start', taken
+ *  from the sources' peak files rather than the audio.
+ *  @return false if any of the sources' peak data could not be used.
+ */
+bool
+AudioRegion::read_peak_maxima (Sample* maxima, framepos_t start, framecnt_t npeaks) const
+{
+	framecnt_t const fpp = AudioSource::peak_file_frames ();
+	framecnt_t const chunk = 4096;
+	boost::scoped_array<PeakData> peaks (new PeakData[chunk]);
+
+	memset (maxima, 0, sizeof (Sample) * npeaks);
+
+	for (uint32_t n = 0; n < n_channels(); ++n) {
+		for (framecnt_t done = 0; done < npeaks; ) {
+
+			framecnt_t const cnt = min (chunk, npeaks - done);
+
+			if (audio_source (n)->read_file_peaks (peaks.get(), cnt, start + done * fpp)) {
+				return false;
+			}
+
+			for (framecnt_t i = 0; i < cnt; ++i) {
+				Sample const m = max (fabsf (peaks[i].min), fabsf (peaks[i].max));
+				maxima[done + i] = max (maxima[done + i], m);
+			}
+
+			done += cnt;
+		}
+	}
+
+	return true;
+}
+
 /** @return the maximum (linear) amplitude of the region, or a -ve
  *  number if the Progress object reports that the process was cancelled.
+ *
+ *  The sources' peak data is used, if it is ready, for the part of the
+ *  region that it covers with whole peaks; only the audio in the partial
+ *  peaks at either end is then read.
  */
 double
 AudioRegion::maximum_amplitude (Progress* p) const
 {
-	framepos_t fpos = _start;
 	framepos_t const fend = _start + _length;
 	double maxamp = 0;
 
+	framecnt_t const fpp = AudioSource::peak_file_frames ();
+	framepos_t const pstart = min (fend, ((_start + fpp - 1) / fpp) * fpp);
+	framepos_t const pend = max (pstart, (fend / fpp) * fpp);
+	framecnt_t const npeaks = (pend - pstart) / fpp;
+
+	/* ranges of the region that we must read audio for */
+	std::vector<std::pair<framepos_t, framepos_t> > to_scan;
+
+	if (npeaks > 0) {
+		framecnt_t const chunk = 4096;
+		boost::scoped_array<Sample> maxima (new Sample[chunk]);
+		bool ok = true;
+
+		for (framecnt_t done = 0; ok && done < npeaks; done += chunk) {
+			framecnt_t const cnt = min (chunk, npeaks - done);
+			if ((ok = read_peak_maxima (maxima.get(), pstart + done * fpp, cnt))) {
+				for (framecnt_t i = 0; i < cnt; ++i) {
+					maxamp = max (maxamp, (double) maxima[i]);
+				}
+			}
+		}
+
+		if (ok) {
+			to_scan.push_back (make_pair (_start, pstart));
+			to_scan.push_back (make_pair (pend, fend));
+		} else {
+			maxamp = 0;
+		}
+	}
+
+	if (to_scan.empty ()) {
+		to_scan.push_back (make_pair (_start, fend));
+	}
+
 	framecnt_t const blocksize = 64 * 1024;
 	Sample buf[blocksize];
+	framecnt_t scanned = 0;
+	framecnt_t to_do = 0;
+
+	for (std::vector<std::pair<framepos_t, framepos_t> >::const_iterator r = to_scan.begin(); r != to_scan.end(); ++r) {
+		to_do += r->second - r->first;
+	}
+
+	for (std::vector<std::pair<framepos_t, framepos_t> >::const_iterator r = to_scan.begin(); r != to_scan.end(); ++r) {
 
-	while (fpos < fend) {
+		framepos_t fpos = r->first;
 
-		uint32_t n;
+		while (fpos < r->second) {
 
-		framecnt_t const to_read = min (fend - fpos, blocksize);
+			uint32_t n;
 
-		for (n = 0; n < n_channels(); ++n) {
+			framecnt_t const to_read = min (r->second - fpos, blocksize);
 
-			/* read it in */
+			for (n = 0; n < n_channels(); ++n) {
 
-			if (read_raw_internal (buf, fpos, to_read, n) != to_read) {
-				return 0;
+				/* read it in */
+
+				if (read_raw_internal (buf, fpos, to_read, n) != to_read) {
+					return 0;
+				}
+
+				maxamp = compute_peak (buf, to_read, maxamp);
 			}
 
-			maxamp = compute_peak (buf, to_read, maxamp);
-		}
+			fpos += to_read;
+			scanned += to_read;
 
-		fpos += to_read;
-		if (p) {
-			p->set_progress (float (fpos - _start) / _length);
-			if (p->cancelled ()) {
-				return -1;
+			if (p) {
+				p->set_progress (float (scanned) / to_do);
+				if (p->cancelled ()) {
+					return -1;
+				}
 			}
 		}
 	}
@@ -1791,6 +1876,81 @@ in this and future transient-detection operations.\n\
 	return 0;
 }
 
+namespace {
+
+/** Search state for AudioRegion::find_silence(), fed with the region's
+ *  audio (or what is known about it) from start to end.
+ */
+struct SilenceFinder {
+	SilenceFinder (framepos_t start, framecnt_t min, framecnt_t fade)
+		: in_silence (true)
+		, silence_start (start)
+		, min_length (min)
+		, fade_length (fade)
+	{}
+
+	/** the signal at `pos' is below the threshold */
+	void silent (framepos_t pos) {
+		if (!in_silence) {
+			/* non-silence to silence */
+			in_silence = true;
+			silence_start = pos + fade_length;
+		}
+	}
+
+	/** the signal at `pos' is at or above the threshold */
+	void loud (framepos_t pos) {
+		if (in_silence) {
+			/* silence to non-silence */
+			in_silence = false;
+			frameoffset_t silence_end = pos - 1 - fade_length;
+
+			if (silence_end - silence_start >= min_length) {
+				silent_periods.push_back (std::make_pair (silence_start, silence_end));
+			}
+		}
+	}
+
+	bool in_silence;
+	frameoffset_t silence_start;
+	framecnt_t min_length;
+	framecnt_t fade_length;
+	AudioIntervalResult silent_periods;
+};
+
+/** A stretch of a region which find_silence() either knows to be silent,
+ *  may treat as loud, or must read.
+ */
+struct SilenceSpan {
+	enum Kind {
+		Silent,
+		Loud,
+		Read
+	};
+
+	SilenceSpan (framepos_t s, framepos_t e, Kind k) : start (s), end (e), kind (k) {}
+
+	framepos_t start;
+	framepos_t end;
+	Kind kind;
+};
+
+void
+add_span (std::vector<SilenceSpan>& spans, framepos_t start, framepos_t end, SilenceSpan::Kind kind)
+{
+	if (start >= end) {
+		return;
+	}
+
+	if (!spans.empty() && spans.back().kind == kind && spans.back().end == start) {
+		spans.back().end = end;
+	} else {
+		spans.push_back (SilenceSpan (start, end, kind));
+	}
+}
+
+}
+
 /** Find areas of `silence' within a region.
  *
  *  @param threshold Threshold below which signal is considered silence (as a sample value)
@@ -1808,58 +1968,115 @@ AudioRegion::find_silence (Sample threshold, framecnt_t min_length, framecnt_t f
 	assert (fade_length >= 0);
 	assert (min_length > 0);
 
-	framepos_t pos = _start;
 	framepos_t const end = _start + _length;
 
-	AudioIntervalResult silent_periods;
+	/* Any silent period that we report is longer than min_length.  If
+	   that is at least two peaks long, such a period must include a
+	   whole peak that the sources' peak data shows to be entirely below
+	   the threshold.  Those peaks need not be read at all, and silent
+	   periods can only start or end in the peaks either side of them or
+	   in the partial peaks at the ends of the region, so those are all
+	   that we need to read.  Anywhere else can be treated as loud, since
+	   any silence there is too short to report.
+	*/
 
-	bool in_silence = true;
-	frameoffset_t silence_start = _start;
+	framecnt_t const fpp = AudioSource::peak_file_frames ();
+	framepos_t const pstart = min (end, ((_start + fpp - 1) / fpp) * fpp);
+	framepos_t const pend = max (pstart, (end / fpp) * fpp);
+	framecnt_t const npeaks = (pend - pstart) / fpp;
 
-	while (pos < end && !itt.cancel) {
+	std::vector<SilenceSpan> spans;
 
-		framecnt_t cur_samples = 0;
-		/* fill `loudest' with the loudest absolute sample at each instant, across all channels */
-		memset (loudest.get(), 0, sizeof (Sample) * block_size);
-		for (uint32_t n = 0; n < n_channels(); ++n) {
+	if (min_length >= 2 * fpp && npeaks > 0) {
 
-			cur_samples = read_raw_internal (buf.get(), pos, block_size, n);
-			for (framecnt_t i = 0; i < cur_samples; ++i) {
-				loudest[i] = max (loudest[i], abs (buf[i]));
-			}
-		}
+		std::vector<Sample> maxima (npeaks);
+
+		if (read_peak_maxima (&maxima[0], pstart, npeaks)) {
 
-		/* now look for silence */
-		for (framecnt_t i = 0; i < cur_samples; ++i) {
-			bool const silence = abs (loudest[i]) < threshold;
-			if (silence && !in_silence) {
-				/* non-silence to silence */
-				in_silence = true;
-				silence_start = pos + i + fade_length;
-			} else if (!silence && in_silence) {
-				/* silence to non-silence */
-				in_silence = false;
-				frameoffset_t silence_end = pos + i - 1 - fade_length;
-
-				if (silence_end - silence_start >= min_length) {
-					silent_periods.push_back (std::make_pair (silence_start, silence_end));
+			add_span (spans, _start, pstart, SilenceSpan::Read);
+
+			for (framecnt_t i = 0; i < npeaks; ++i) {
+
+				framepos_t const p = pstart + i * fpp;
+				SilenceSpan::Kind kind;
+
+				if (maxima[i] < threshold) {
+					kind = SilenceSpan::Silent;
+				} else if ((i > 0 && maxima[i - 1] < threshold) || (i + 1 < npeaks && maxima[i + 1] < threshold)) {
+					kind = SilenceSpan::Read;
+				} else {
+					kind = SilenceSpan::Loud;
 				}
+
+				add_span (spans, p, p + fpp, kind);
 			}
+
+			add_span (spans, pend, end, SilenceSpan::Read);
 		}
+	}
+
+	if (spans.empty ()) {
+		add_span (spans, _start, end, SilenceSpan::Read);
+	}
+
+	SilenceFinder finder (_start, min_length, fade_length);
 
-		pos += cur_samples;
-		itt.progress = (end - pos) / (double)_length;
+	for (std::vector<SilenceSpan>::const_iterator s = spans.begin(); s != spans.end() && !itt.cancel; ++s) {
 
-		if (cur_samples == 0) {
-			assert (pos >= end);
+		switch (s->kind) {
+		case SilenceSpan::Silent:
+			finder.silent (s->start);
+			break;
+		case SilenceSpan::Loud:
+			finder.loud (s->start);
+			break;
+		case SilenceSpan::Read:
 			break;
 		}
+
+		framepos_t pos = (s->kind == SilenceSpan::Read) ? s->start : s->end;
+
+		while (pos < s->end && !itt.cancel) {
+
+			framecnt_t const to_read = min (block_size, s->end - pos);
+			framecnt_t cur_samples = 0;
+
+			/* fill `loudest' with the loudest absolute sample at each instant, across all channels */
+			memset (loudest.get(), 0, sizeof (Sample) * block_size);
+			for (uint32_t n = 0; n < n_channels(); ++n) {
+
+				cur_samples = read_raw_internal (buf.get(), pos, to_read, n);
+				for (framecnt_t i = 0; i < cur_samples; ++i) {
+					loudest[i] = max (loudest[i], abs (buf[i]));
+				}
+			}
+
+			/* now look for silence */
+			for (framecnt_t i = 0; i < cur_samples; ++i) {
+				if (abs (loudest[i]) < threshold) {
+					finder.silent (pos + i);
+				} else {
+					finder.loud (pos + i);
+				}
+			}
+
+			pos += cur_samples;
+
+			if (cur_samples == 0) {
+				break;
+			}
+		}
+
+		itt.progress = (end - s->end) / (double)_length;
 	}
 
-	if (in_silence && !itt.cancel) {
+	AudioIntervalResult silent_periods;
+	silent_periods.swap (finder.silent_periods);
+
+	if (finder.in_silence && !itt.cancel) {
 		/* last block was silent, so finish off the last period */
-		if (end - 1 - silence_start >= min_length + fade_length) {
-			silent_periods.push_back (std::make_pair (silence_start, end - 1));
+		if (end - 1 - finder.silence_start >= min_length + fade_length) {
+			silent_periods.push_back (std::make_pair (finder.silence_start, end - 1));
 		}
 	}
 
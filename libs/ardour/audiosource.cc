@@ -336,6 +336,56 @@ AudioSource::read_peaks (PeakData *peaks, framecnt_t npeaks, framepos_t start, f
 	return read_peaks_with_fpp (peaks, npeaks, start, cnt, samples_per_visual_peak, _FPP);
 }
 
+framecnt_t
+AudioSource::peak_file_frames ()
+{
+	return _FPP;
+}
+
+int
+AudioSource::read_file_peaks (PeakData *peaks, framecnt_t npeaks, framepos_t start) const
+{
+	if (start % _FPP) {
+		return -1;
+	}
+
+	{
+		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
+		if (!_peaks_built) {
+			return -1;
+		}
+	}
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	ScopedFileDescriptor sfd (g_open (_peakpath.c_str(), O_RDONLY, 0444));
+
+	if (sfd < 0) {
+		return -1;
+	}
+
+	off_t const first_peak_byte = (start / _FPP) * sizeof (PeakData);
+	size_t const bytes_to_read = sizeof (PeakData) * npeaks;
+
+	if (lseek (sfd, first_peak_byte, SEEK_SET) != first_peak_byte) {
+		return -1;
+	}
+
+	char* p = reinterpret_cast<char*> (peaks);
+	size_t done = 0;
+
+	while (done < bytes_to_read) {
+		ssize_t const r = ::read (sfd, p + done, bytes_to_read - done);
+		if (r <= 0) {
+			/* peak file is shorter than the source */
+			return -1;
+		}
+		done += r;
+	}
+
+	return 0;
+}
+
 /** @param peaks Buffer to write peak data.
  *  @param npeaks Number of peaks to write.
  */
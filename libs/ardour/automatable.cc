@@ -372,6 +372,32 @@ Automatable::transport_located (framepos_t now)
 	}
 }
 
+/** Pre-render the curves of controls in playback mode for [start, start + len),
+ *  where they are about to run out.  Called from the butler thread.
+ */
+void
+Automatable::render_automation (framepos_t start, framecnt_t len)
+{
+	for (Controls::iterator li = controls().begin(); li != controls().end(); ++li) {
+
+		boost::shared_ptr<AutomationControl> c = boost::dynamic_pointer_cast<AutomationControl>(li->second);
+
+		if (!c || !c->automation_playback()) {
+			continue;
+		}
+
+		boost::shared_ptr<AutomationList> l = c->alist();
+
+		if (!l || !l->has_curve()) {
+			continue;
+		}
+
+		if (l->curve().render_wanted (start, len / 2)) {
+			l->curve().render (start, len);
+		}
+	}
+}
+
 void
 Automatable::transport_stopped (framepos_t now)
 {
@@ -52,6 +52,7 @@ Butler::Butler(Session& s)
 	, _xthread (true)
 {
 	g_atomic_int_set(&should_do_transport_work, 0);
+	g_atomic_int_set(&_reset_stats, 0);
 	SessionEvent::pool->set_trash (&pool_trash);
 
         /* catch future changes to parameters */
@@ -203,9 +204,18 @@ Butler::thread_work ()
 		DEBUG_TRACE (DEBUG::Butler, "at restart for disk work\n");
 		disk_work_outstanding = false;
 
+		if (g_atomic_int_compare_and_exchange (&_reset_stats, 1, 0)) {
+			_stats = Stats ();
+		}
+
 		if (transport_work_requested()) {
 			DEBUG_TRACE (DEBUG::Butler, string_compose ("do transport work @ %1\n", g_get_monotonic_time()));
+			gint64 const before = g_get_monotonic_time ();
 			_session.butler_transport_work ();
+			gint64 const elapsed = g_get_monotonic_time () - before;
+			++_stats.transport_work;
+			_stats.transport_work_total += elapsed;
+			_stats.transport_work_max = std::max (_stats.transport_work_max, elapsed);
 			DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttransport work complete @ %1\n", g_get_monotonic_time()));
 		}
 
@@ -224,6 +234,8 @@ Butler::thread_work ()
 		RouteList rl_with_auditioner = *rl;
 		rl_with_auditioner.push_back (_session.the_auditioner());
 
+		gint64 const pass_start = g_get_monotonic_time ();
+
 		for (i = rl_with_auditioner.begin(); !transport_work_requested() && should_run && i != rl_with_auditioner.end(); ++i) {
 
 			boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
@@ -263,11 +275,22 @@ Butler::thread_work ()
 			disk_work_outstanding = true;
 		}
 
+		{
+			gint64 const elapsed = g_get_monotonic_time () - pass_start;
+			++_stats.passes;
+			_stats.pass_total += elapsed;
+			_stats.pass_max = std::max (_stats.pass_max, elapsed);
+		}
+
 		if (!err && transport_work_requested()) {
 			DEBUG_TRACE (DEBUG::Butler, "transport work requested during refill, back to restart\n");
 			goto restart;
 		}
 
+		if (should_run) {
+			_session.render_automation ();
+		}
+
 		disk_work_outstanding = flush_tracks_to_disk_normal (rl, err);
 
 		if (err && _session.actively_recording()) {
@@ -452,6 +475,22 @@ Butler::wait_until_finished ()
 	paused.wait(request_lock);
 }
 
+Butler::Stats
+Butler::stats () const
+{
+	if (g_atomic_int_get (const_cast<gint*> (&_reset_stats))) {
+		/* not cleared yet, but as good as */
+		return Stats ();
+	}
+	return _stats;
+}
+
+void
+Butler::reset_stats ()
+{
+	g_atomic_int_set (&_reset_stats, 1);
+}
+
 bool
 Butler::transport_work_requested () const
 {
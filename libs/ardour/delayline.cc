@@ -232,14 +232,19 @@ DelayLine::run (BufferSet& bufs, framepos_t /* start_frame */, framepos_t /* end
 
 			// move events from dly-buffer into current-buffer until nsamples
 			// and remove them from the dly-buffer
+			bool moved = false;
 			for (MidiBuffer::iterator m = dly->begin(); m != dly->end();) {
 				const Evoral::MIDIEvent<MidiBuffer::TimeType> ev (*m, false);
 				if (ev.time() >= nsamples) {
 					break;
 				}
-				mb.insert_event(ev);
+				mb.push_back(ev);
+				moved = true;
 				m = dly->erase(m);
 			}
+			if (moved) {
+				mb.sort();
+			}
 
 			/* For now, this is only relevant if there is there's a positive delay.
 			 * In the future this could also be used to delay 'too early' events
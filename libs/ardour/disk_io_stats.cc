@@ -0,0 +1,237 @@
+/*
+    Copyright (C) 2016 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <algorithm>
+#include <cstring>
+
+#include "ardour/disk_io_stats.h"
+
+#include "i18n.h"
+
+using namespace ARDOUR;
+using namespace std;
+
+DiskIOStats::DiskIOStats ()
+{
+	g_atomic_int_set (&_refilling, 0);
+	g_atomic_int_set (&_butler_reset, 0);
+	g_atomic_int_set (&_process_reset, 0);
+	_refill_start = 0;
+	reset_butler_side ();
+	reset_process_side ();
+}
+
+void
+DiskIOStats::reset ()
+{
+	g_atomic_int_set (&_butler_reset, 1);
+	g_atomic_int_set (&_process_reset, 1);
+}
+
+/** Butler thread only. _refilling is left alone, as a refill may be in
+ *  progress.
+ */
+void
+DiskIOStats::reset_butler_side ()
+{
+	_refills = 0;
+	_bytes_read = 0;
+	_reads = 0;
+	_refill_max = 0;
+	_refill_total = 0;
+	memset (_refill_hist, 0, sizeof (_refill_hist));
+	_last_refill = -1;
+}
+
+/** Process thread only */
+void
+DiskIOStats::reset_process_side ()
+{
+	memset (_playback_fill, 0, sizeof (_playback_fill));
+	memset (_capture_fill, 0, sizeof (_capture_fill));
+	memset (_underruns, 0, sizeof (_underruns));
+	g_atomic_int_set (&_n_underruns, 0);
+}
+
+void
+DiskIOStats::check_process_reset ()
+{
+	if (g_atomic_int_compare_and_exchange (&_process_reset, 1, 0)) {
+		reset_process_side ();
+	}
+}
+
+void
+DiskIOStats::refill_started ()
+{
+	if (g_atomic_int_compare_and_exchange (&_butler_reset, 1, 0)) {
+		reset_butler_side ();
+	}
+
+	_refill_start = g_get_monotonic_time ();
+	g_atomic_int_set (&_refilling, 1);
+}
+
+void
+DiskIOStats::refill_done (uint64_t bytes, uint32_t reads)
+{
+	gint64 const now = g_get_monotonic_time ();
+	gint64 const elapsed = now - _refill_start;
+
+	g_atomic_int_set (&_refilling, 0);
+	_last_refill = now;
+
+	++_refills;
+	_bytes_read += bytes;
+	_reads += reads;
+	_refill_total += elapsed;
+	_refill_max = max (_refill_max, elapsed);
+
+	++_refill_hist[latency_bin (elapsed)];
+}
+
+int
+DiskIOStats::fill_bin (float load)
+{
+	return max (0, min (fill_bins - 1, (int) (load * fill_bins)));
+}
+
+int
+DiskIOStats::latency_bin (gint64 usecs)
+{
+	int bin = 0;
+	for (gint64 e = usecs; e > 1 && bin < latency_bins - 1; e >>= 1) {
+		++bin;
+	}
+	return bin;
+}
+
+void
+DiskIOStats::playback_fill (float load)
+{
+	check_process_reset ();
+	++_playback_fill[fill_bin (load)];
+}
+
+void
+DiskIOStats::capture_fill (float load)
+{
+	check_process_reset ();
+	++_capture_fill[fill_bin (load)];
+}
+
+void
+DiskIOStats::underrun (framepos_t position, framecnt_t needed, framecnt_t available, bool transport_work)
+{
+	check_process_reset ();
+
+	gint const n = g_atomic_int_get (&_n_underruns);
+	Underrun& u (_underruns[n % max_underruns]);
+
+	u.when = g_get_monotonic_time ();
+	u.position = position;
+	u.needed = needed;
+	u.available = available;
+	u.idle = (_last_refill < 0) ? -1 : u.when - _last_refill;
+
+	if (transport_work) {
+		u.cause = TransportWork;
+	} else if (g_atomic_int_get (&_refilling)) {
+		u.cause = DiskSlow;
+	} else {
+		u.cause = ButlerStarved;
+	}
+
+	g_atomic_int_inc (&_n_underruns);
+}
+
+uint32_t
+DiskIOStats::n_underruns () const
+{
+	if (process_reset_pending ()) {
+		return 0;
+	}
+	return g_atomic_int_get (const_cast<gint*> (&_n_underruns));
+}
+
+DiskIOStats::Underrun const &
+DiskIOStats::underrun_record (uint32_t n) const
+{
+	uint32_t const total = n_underruns ();
+	return _underruns[(total - 1 - n) % max_underruns];
+}
+
+const char*
+DiskIOStats::cause_name (UnderrunCause c)
+{
+	switch (c) {
+	case ButlerStarved:
+		return _("butler starved");
+	case DiskSlow:
+		return _("disk slow");
+	case TransportWork:
+		return _("transport work");
+	}
+	return "";
+}
+
+void
+DiskIOStats::dump (ostream& out) const
+{
+	uint64_t const r = refills ();
+
+	out << "\trefills " << r
+	    << " bytes " << bytes_read ()
+	    << " reads " << reads ()
+	    << " refill usecs avg " << (r ? refill_total () / (gint64) r : 0)
+	    << " max " << refill_max ()
+	    << endl;
+
+	out << "\trefill usecs histogram";
+	for (int i = 0; i < latency_bins; ++i) {
+		out << ' ' << (1 << i) << ':' << refill_histogram (i);
+	}
+	out << endl;
+
+	out << "\tplayback fill histogram";
+	for (int i = 0; i < fill_bins; ++i) {
+		out << ' ' << (i * 100 / fill_bins) << "%:" << playback_fill_histogram (i);
+	}
+	out << endl;
+
+	out << "\tcapture fill histogram";
+	for (int i = 0; i < fill_bins; ++i) {
+		out << ' ' << (i * 100 / fill_bins) << "%:" << capture_fill_histogram (i);
+	}
+	out << endl;
+
+	uint32_t const n = n_underruns ();
+
+	out << "\tunderruns " << n << endl;
+
+	for (uint32_t i = 0; i < min (n, (uint32_t) max_underruns); ++i) {
+		Underrun const & u (underrun_record (i));
+		out << "\t\t@ " << u.when
+		    << " position " << u.position
+		    << " needed " << u.needed
+		    << " available " << u.available
+		    << " usecs since refill " << u.idle
+		    << " cause: " << cause_name (u.cause)
+		    << endl;
+	}
+}
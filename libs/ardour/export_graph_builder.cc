@@ -33,6 +33,7 @@
 #include "audiographer/general/sr_converter.h"
 #include "audiographer/general/silence_trimmer.h"
 #include "audiographer/general/threader.h"
+#include "audiographer/general/tmp_buffer.h"
 #include "audiographer/sndfile/tmp_file.h"
 #include "audiographer/sndfile/sndfile_writer.h"
 
@@ -41,6 +42,7 @@
 #include "ardour/export_filename.h"
 #include "ardour/export_format_specification.h"
 #include "ardour/export_timespan.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/session_directory.h"
 #include "ardour/sndfile_helpers.h"
 
@@ -55,6 +57,7 @@ namespace ARDOUR {
 ExportGraphBuilder::ExportGraphBuilder (Session const & session)
 	: session (session)
 	, thread_pool (hardware_concurrency())
+	, normalize_memory_used (0)
 {
 	process_buffer_frames = session.engine().samples_per_cycle();
 }
@@ -110,6 +113,7 @@ ExportGraphBuilder::reset ()
 	channel_configs.clear ();
 	channels.clear ();
 	normalizers.clear ();
+	normalize_memory_used = 0;
 }
 
 void
@@ -369,12 +373,6 @@ ExportGraphBuilder::SFC::operator== (FileSpec const & other_config) const
 ExportGraphBuilder::Normalizer::Normalizer (ExportGraphBuilder & parent, FileSpec const & new_config, framecnt_t /*max_frames*/)
 	: parent (parent)
 {
-	std::string tmpfile_path = parent.session.session_directory().export_path();
-	tmpfile_path = Glib::build_filename(tmpfile_path, "XXXXXX");
-	std::vector<char> tmpfile_path_buf(tmpfile_path.size() + 1);
-	std::copy(tmpfile_path.begin(), tmpfile_path.end(), tmpfile_path_buf.begin());
-	tmpfile_path_buf[tmpfile_path.size()] = '\0';
-
 	config = new_config;
 	uint32_t const channels = config.channel_config->get_n_chans();
 	max_frames_out = 4086 - (4086 % channels); // TODO good chunk size
@@ -387,14 +385,39 @@ ExportGraphBuilder::Normalizer::Normalizer (ExportGraphBuilder & parent, FileSpe
 	normalizer->alloc_buffer (max_frames_out);
 	normalizer->add_output (threader);
 
-	int format = ExportFormatBase::F_RAW | ExportFormatBase::SF_Float;
-	tmp_file.reset (new TmpFile<float> (&tmpfile_path_buf[0], format, channels, config.format->sample_rate()));
-	tmp_file->FileWritten.connect_same_thread (post_processing_connection,
-	                                           boost::bind (&Normalizer::start_post_processing, this));
+	/* keep the intermediate data in RAM if it fits within what is left of the
+	 * configured limit, which all normalizers of this export share. This saves
+	 * writing the whole export to disk and reading it back again.
+	 */
+	framecnt_t const frames = expected_frames ();
+	int64_t const limit = (int64_t) Config->get_export_normalize_memory_limit () * 1048576;
+	int64_t const bytes = (int64_t) (frames * sizeof (Sample));
+
+	if (bytes <= limit - parent.normalize_memory_used) {
+		parent.normalize_memory_used += bytes;
+		tmp_buffer.reset (new TmpBuffer<Sample> (channels, frames));
+		tmp_buffer->BufferWritten.connect_same_thread (post_processing_connection,
+		                                               boost::bind (&Normalizer::start_post_processing, this));
+	} else {
+		std::string tmpfile_path = parent.session.session_directory().export_path();
+		tmpfile_path = Glib::build_filename(tmpfile_path, "XXXXXX");
+		std::vector<char> tmpfile_path_buf(tmpfile_path.size() + 1);
+		std::copy(tmpfile_path.begin(), tmpfile_path.end(), tmpfile_path_buf.begin());
+		tmpfile_path_buf[tmpfile_path.size()] = '\0';
+
+		int format = ExportFormatBase::F_RAW | ExportFormatBase::SF_Float;
+		tmp_file.reset (new TmpFile<float> (&tmpfile_path_buf[0], format, channels, config.format->sample_rate()));
+		tmp_file->FileWritten.connect_same_thread (post_processing_connection,
+		                                           boost::bind (&Normalizer::start_post_processing, this));
+	}
 
 	add_child (new_config);
 
-	peak_reader->add_output (tmp_file);
+	if (tmp_buffer) {
+		peak_reader->add_output (tmp_buffer);
+	} else {
+		peak_reader->add_output (tmp_file);
+	}
 }
 
 ExportGraphBuilder::FloatSinkPtr
@@ -438,14 +461,14 @@ ExportGraphBuilder::Normalizer::operator== (FileSpec const & other_config) const
 unsigned
 ExportGraphBuilder::Normalizer::get_normalize_cycle_count() const
 {
-	return static_cast<unsigned>(std::ceil(static_cast<float>(tmp_file->get_frames_written()) /
-	                                       max_frames_out));
+	framecnt_t const written = tmp_buffer ? tmp_buffer->get_frames_written() : tmp_file->get_frames_written();
+	return static_cast<unsigned>(std::ceil(static_cast<float>(written) / max_frames_out));
 }
 
 bool
 ExportGraphBuilder::Normalizer::process()
 {
-	framecnt_t frames_read = tmp_file->read (*buffer);
+	framecnt_t frames_read = tmp_buffer ? tmp_buffer->read (*buffer) : tmp_file->read (*buffer);
 	return frames_read != buffer->frames();
 }
 
@@ -453,11 +476,31 @@ void
 ExportGraphBuilder::Normalizer::start_post_processing()
 {
 	normalizer->set_peak (peak_reader->get_peak());
-	tmp_file->seek (0, SEEK_SET);
-	tmp_file->add_output (normalizer);
+	if (tmp_buffer) {
+		tmp_buffer->seek (0, SEEK_SET);
+		tmp_buffer->add_output (normalizer);
+	} else {
+		tmp_file->seek (0, SEEK_SET);
+		tmp_file->add_output (normalizer);
+	}
 	parent.normalizers.push_back (this);
 }
 
+/** @return estimated number of interleaved samples that will pass through this normalizer */
+framecnt_t
+ExportGraphBuilder::Normalizer::expected_frames () const
+{
+	framecnt_t const session_rate = parent.session.nominal_frame_rate();
+	framecnt_t const sample_rate = config.format->sample_rate() ? config.format->sample_rate() : session_rate;
+	uint32_t const channels = config.channel_config->get_n_chans();
+
+	framecnt_t frames = parent.timespan->get_length();
+	frames += config.format->silence_beginning_at (parent.timespan->get_start(), session_rate);
+	frames += config.format->silence_end_at (parent.timespan->get_end(), session_rate);
+
+	return (framecnt_t) std::ceil ((double) frames * sample_rate / session_rate) * channels;
+}
+
 /* SRC */
 
 ExportGraphBuilder::SRC::SRC (ExportGraphBuilder & parent, FileSpec const & new_config, framecnt_t max_frames)
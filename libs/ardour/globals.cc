@@ -135,6 +135,8 @@ apply_gain_to_buffer_t  ARDOUR::apply_gain_to_buffer = 0;
 mix_buffers_with_gain_t ARDOUR::mix_buffers_with_gain = 0;
 mix_buffers_no_gain_t   ARDOUR::mix_buffers_no_gain = 0;
 copy_vector_t			ARDOUR::copy_vector = 0;
+mix_buffers_with_gain_vector_t ARDOUR::mix_buffers_with_gain_vector = 0;
+mix_buffer_to_outputs_t ARDOUR::mix_buffer_to_outputs = 0;
 
 PBD::Signal1<void,std::string> ARDOUR::BootMessage;
 PBD::Signal3<void,std::string,std::string,bool> ARDOUR::PluginScanMessage;
@@ -184,6 +186,8 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_sse_avx_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
+			mix_buffers_with_gain_vector = x86_sse_mix_buffers_with_gain_vector;
+			mix_buffer_to_outputs = x86_sse_mix_buffer_to_outputs;
 
 			generic_mix_functions = false;
 
@@ -198,6 +202,8 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_sse_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
+			mix_buffers_with_gain_vector = x86_sse_mix_buffers_with_gain_vector;
+			mix_buffer_to_outputs = x86_sse_mix_buffer_to_outputs;
 
 			generic_mix_functions = false;
 
@@ -216,6 +222,8 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain  = veclib_mix_buffers_with_gain;
 			mix_buffers_no_gain    = veclib_mix_buffers_no_gain;
 			copy_vector            = default_copy_vector;
+			mix_buffers_with_gain_vector = default_mix_buffers_with_gain_vector;
+			mix_buffer_to_outputs  = default_mix_buffer_to_outputs;
 
 			generic_mix_functions = false;
 
@@ -236,6 +244,8 @@ setup_hardware_optimization (bool try_optimization)
 		mix_buffers_with_gain = default_mix_buffers_with_gain;
 		mix_buffers_no_gain   = default_mix_buffers_no_gain;
 		copy_vector           = default_copy_vector;
+		mix_buffers_with_gain_vector = default_mix_buffers_with_gain_vector;
+		mix_buffer_to_outputs = default_mix_buffer_to_outputs;
 
 		info << "No H/W specific optimizations in use" << endmsg;
 	}
@@ -51,6 +51,20 @@ int alloc_allowed ()
 }
 #endif
 
+static std::string
+task_group_name ()
+{
+	static gint count = 0;
+	return string_compose ("graph_tasks_%1", g_atomic_int_add (&count, 1));
+}
+
+GraphTaskGroup::GraphTaskGroup ()
+	: _name (task_group_name ())
+	, _pending (0)
+	, _done (_name.c_str (), 0)
+{
+}
+
 Graph::Graph (Session & session)
         : SessionHandleRef (session)
         , _threads_active (false)
@@ -65,6 +79,7 @@ Graph::Graph (Session & session)
 	   memory in the RT thread.
 	*/
 	_trigger_queue.reserve (8192);
+	_task_queue.reserve (1024);
 
         _execution_tokens = 0;
 
@@ -141,6 +156,7 @@ Graph::session_going_away()
         _init_trigger_list[0].clear();
         _init_trigger_list[1].clear();
         _trigger_queue.clear();
+        _task_queue.clear();
 }
 
 void
@@ -354,20 +370,23 @@ Graph::rechain (boost::shared_ptr<RouteList> routelist, GraphEdges const & edges
 bool
 Graph::run_one()
 {
-        GraphNode* to_run;
+        GraphNode* to_run = 0;
+        GraphTask* task = 0;
 
         pthread_mutex_lock (&_trigger_mutex);
-        if (_trigger_queue.size()) {
+        /* tasks first: a node is waiting for them to finish */
+        if (_task_queue.size()) {
+                task = _task_queue.back();
+                _task_queue.pop_back();
+        } else if (_trigger_queue.size()) {
                 to_run = _trigger_queue.back();
                 _trigger_queue.pop_back();
-        } else {
-                to_run = 0;
         }
 
 	/* the number of threads that are asleep */
 	int et = _execution_tokens;
-	/* the number of nodes that need to be run */
-	int ts = _trigger_queue.size();
+	/* the number of nodes and tasks that need to be run */
+	int ts = _trigger_queue.size() + _task_queue.size();
 
 	/* hence how many threads to wake up */
         int wakeup = min (et, ts);
@@ -380,7 +399,7 @@ Graph::run_one()
                 _execution_sem.signal ();
         }
 
-        while (to_run == 0) {
+        while (to_run == 0 && task == 0) {
                 _execution_tokens += 1;
                 pthread_mutex_unlock (&_trigger_mutex);
                 DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 goes to sleep\n", pthread_name()));
@@ -390,21 +409,103 @@ Graph::run_one()
                 }
                 DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 is awake\n", pthread_name()));
                 pthread_mutex_lock (&_trigger_mutex);
-                if (_trigger_queue.size()) {
+                if (_task_queue.size()) {
+                        task = _task_queue.back();
+                        _task_queue.pop_back();
+                } else if (_trigger_queue.size()) {
                         to_run = _trigger_queue.back();
                         _trigger_queue.pop_back();
                 }
         }
         pthread_mutex_unlock (&_trigger_mutex);
 
-        to_run->process();
-        to_run->finish (_current_chain);
+        if (task) {
+                run_task (task);
+        } else {
+                to_run->process();
+                to_run->finish (_current_chain);
+        }
 
         DEBUG_TRACE(DEBUG::ProcessThreads, string_compose ("%1 has finished run_one()\n", pthread_name()));
 
         return !_threads_active;
 }
 
+/** Prepare @param group to receive tasks via dispatch_task(). */
+void
+Graph::start_tasks (GraphTaskGroup& group)
+{
+	g_atomic_int_set (&group._pending, 1);
+}
+
+/** Hand @param task to any idle process thread.  The caller must call
+ *  join_tasks() before the data used by the task goes away.
+ */
+void
+Graph::dispatch_task (GraphTaskGroup& group, GraphTask* task)
+{
+	task->_group = &group;
+	g_atomic_int_inc (&group._pending);
+
+	pthread_mutex_lock (&_trigger_mutex);
+
+	if (_task_queue.size() == _task_queue.capacity()) {
+		/* don't allocate in the RT thread; just do it ourselves */
+		pthread_mutex_unlock (&_trigger_mutex);
+		run_task (task);
+		return;
+	}
+
+	_task_queue.push_back (task);
+
+	if (_execution_tokens > 0) {
+		_execution_tokens -= 1;
+		_execution_sem.signal ();
+	}
+
+	pthread_mutex_unlock (&_trigger_mutex);
+}
+
+/** Wait for all tasks dispatched to @param group to complete, running
+ *  any of them that have not yet been picked up by another thread.
+ */
+void
+Graph::join_tasks (GraphTaskGroup& group)
+{
+	while (g_atomic_int_get (&group._pending) > 1) {
+		GraphTask* task = 0;
+
+		pthread_mutex_lock (&_trigger_mutex);
+		if (_task_queue.size() && _task_queue.back()->_group == &group) {
+			task = _task_queue.back();
+			_task_queue.pop_back();
+		}
+		pthread_mutex_unlock (&_trigger_mutex);
+
+		if (!task) {
+			break;
+		}
+
+		run_task (task);
+	}
+
+	if (!g_atomic_int_dec_and_test (&group._pending)) {
+		group._done.wait ();
+	}
+}
+
+void
+Graph::run_task (GraphTask* task)
+{
+	GraphTaskGroup* group = task->_group;
+
+	task->run ();
+
+	if (g_atomic_int_dec_and_test (&group->_pending)) {
+		group->_done.signal ();
+	}
+}
+
 void
 Graph::helper_thread()
 {
@@ -18,6 +18,9 @@
 */
 
 #include <math.h>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
 #include "ardour/iec1ppmdsp.h"
 
 
@@ -45,10 +48,7 @@ void Iec1ppmdsp::process (float const *p, int n)
 {
     float z1, z2, m, t;
 
-    z1 = _z1 > 20 ? 20 : (_z1 < 0 ? 0 : _z1);
-    z2 = _z2 > 20 ? 20 : (_z2 < 0 ? 0 : _z2);
-    m = _res ? 0: _m;
-    _res = false;
+    get_state (z1, z2, m);
 
     n /= 4;
     while (n--)
@@ -71,6 +71,78 @@ void Iec1ppmdsp::process (float const *p, int n)
 	if (t > m) m = t;
     }
 
+    set_state (z1, z2, m);
+}
+
+void Iec1ppmdsp::process (Iec1ppmdsp* const *meters, float const * const *bufs, int nchan, int n)
+{
+    int c = 0;
+
+#ifdef __SSE__
+    // Four channels at a time, one channel per SSE lane.
+    // "if (t > z) z += w * (t - z)" is done as "z += w * max (t - z, 0)".
+    const __m128 w1   = _mm_set1_ps (_w1);
+    const __m128 w2   = _mm_set1_ps (_w2);
+    const __m128 w3   = _mm_set1_ps (_w3);
+    const __m128 zero = _mm_setzero_ps ();
+    const __m128 sign = _mm_set1_ps (-0.0f);
+
+    for (; c + 4 <= nchan; c += 4)
+    {
+	float  v1 [4], v2 [4], vm [4];
+	float const *p0 = bufs [c];
+	float const *p1 = bufs [c + 1];
+	float const *p2 = bufs [c + 2];
+	float const *p3 = bufs [c + 3];
+
+	for (int j = 0; j < 4; ++j) meters [c + j]->get_state (v1 [j], v2 [j], vm [j]);
+	__m128 z1 = _mm_loadu_ps (v1);
+	__m128 z2 = _mm_loadu_ps (v2);
+	__m128 m  = _mm_loadu_ps (vm);
+
+	for (int i = n / 4; i > 0; --i)
+	{
+	    __m128 s [4];
+	    s [0] = _mm_loadu_ps (p0);
+	    s [1] = _mm_loadu_ps (p1);
+	    s [2] = _mm_loadu_ps (p2);
+	    s [3] = _mm_loadu_ps (p3);
+	    p0 += 4; p1 += 4; p2 += 4; p3 += 4;
+	    _MM_TRANSPOSE4_PS (s [0], s [1], s [2], s [3]);
+	    z1 = _mm_mul_ps (z1, w3);
+	    z2 = _mm_mul_ps (z2, w3);
+	    for (int k = 0; k < 4; ++k)
+	    {
+		const __m128 t = _mm_andnot_ps (sign, s [k]);
+		z1 = _mm_add_ps (z1, _mm_mul_ps (w1, _mm_max_ps (_mm_sub_ps (t, z1), zero)));
+		z2 = _mm_add_ps (z2, _mm_mul_ps (w2, _mm_max_ps (_mm_sub_ps (t, z2), zero)));
+	    }
+	    m = _mm_max_ps (m, _mm_add_ps (z1, z2));
+	}
+
+	_mm_storeu_ps (v1, z1);
+	_mm_storeu_ps (v2, z2);
+	_mm_storeu_ps (vm, m);
+	for (int j = 0; j < 4; ++j) meters [c + j]->set_state (v1 [j], v2 [j], vm [j]);
+    }
+#endif
+
+    for (; c < nchan; ++c)
+    {
+	meters [c]->process (bufs [c], n);
+    }
+}
+
+void Iec1ppmdsp::get_state (float& z1, float& z2, float& m)
+{
+    z1 = _z1 > 20 ? 20 : (_z1 < 0 ? 0 : _z1);
+    z2 = _z2 > 20 ? 20 : (_z2 < 0 ? 0 : _z2);
+    m = _res ? 0: _m;
+    _res = false;
+}
+
+void Iec1ppmdsp::set_state (float z1, float z2, float m)
+{
     _z1 = z1 + 1e-10f;
     _z2 = z2 + 1e-10f;
     _m = m;
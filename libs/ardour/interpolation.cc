@@ -19,6 +19,12 @@
 
 #include <stdint.h>
 #include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
 
 #include "ardour/interpolation.h"
 #include "ardour/midi_buffer.h"
@@ -188,3 +194,230 @@ CubicMidiInterpolation::distance (framecnt_t nframes, bool roll)
 
 	return i;
 }
+
+/* the filter tables are shared by all instances; each band is designed for
+ * speeds up to band_speeds[n], with the cutoff lowered accordingly so that
+ * fast playback does not alias.
+ */
+static const double band_speeds[] = { 1.0, 1.25, 1.5, 2.0, 3.0, 4.0 };
+static const int n_bands = sizeof (band_speeds) / sizeof (band_speeds[0]);
+
+namespace {
+
+struct PolyphaseTables {
+	PolyphaseTables (int taps, int phases)
+	{
+		int const half = taps / 2;
+		int const row_size = taps;
+
+		data.resize ((size_t) n_bands * (phases + 1) * row_size);
+
+		for (int b = 0; b < n_bands; ++b) {
+
+			double const cutoff = 0.9 / band_speeds[b];
+
+			for (int p = 0; p <= phases; ++p) {
+
+				float* row = &data[((size_t) b * (phases + 1) + p) * row_size];
+				double const frac = (double) p / phases;
+				double sum = 0;
+
+				for (int k = 0; k < taps; ++k) {
+					/* distance of tap k from the interpolation point */
+					double const x = k - half + 1 - frac;
+					double const y = cutoff * x;
+					double const sinc = (fabs (y) < 1e-9) ? 1.0 : sin (M_PI * y) / (M_PI * y);
+					double const w = (fabs (x) >= half) ? 0.0 : 0.42 + 0.5 * cos (M_PI * x / half) + 0.08 * cos (2.0 * M_PI * x / half);
+					row[k] = sinc * w;
+					sum += row[k];
+				}
+
+				/* unity gain at DC */
+				for (int k = 0; k < taps; ++k) {
+					row[k] /= sum;
+				}
+			}
+		}
+	}
+
+	std::vector<float> data;
+};
+
+}
+
+float const *
+PolyphaseInterpolation::filter_table (double speed)
+{
+	static PolyphaseTables tables (taps, phases);
+
+	int b = 0;
+	while (b < n_bands - 1 && band_speeds[b] < speed) {
+		++b;
+	}
+
+	return &tables.data[(size_t) b * (phases + 1) * taps];
+}
+
+PolyphaseInterpolation::PolyphaseInterpolation ()
+{
+	/* build the tables now, rather than in the process thread */
+	filter_table (1.0);
+}
+
+void
+PolyphaseInterpolation::add_channel_to (int input_buffer_size, int output_buffer_size)
+{
+	Interpolation::add_channel_to (input_buffer_size, output_buffer_size);
+	_channels.push_back (Channel ());
+	memset (_channels.back().edge, 0, sizeof (_channels.back().edge));
+}
+
+void
+PolyphaseInterpolation::remove_channel_from ()
+{
+	Interpolation::remove_channel_from ();
+	_channels.pop_back ();
+}
+
+void
+PolyphaseInterpolation::reset ()
+{
+	Interpolation::reset ();
+	for (std::vector<Channel>::iterator c = _channels.begin(); c != _channels.end(); ++c) {
+		memset (c->edge, 0, sizeof (c->edge));
+	}
+}
+
+static inline float
+dot_product (float const * coefs, Sample const * x, int n)
+{
+#ifdef __SSE__
+	__m128 acc = _mm_setzero_ps ();
+	for (int k = 0; k < n; k += 4) {
+		acc = _mm_add_ps (acc, _mm_mul_ps (_mm_load_ps (coefs + k), _mm_loadu_ps (x + k)));
+	}
+	float r[4];
+	_mm_storeu_ps (r, acc);
+	return (r[0] + r[1]) + (r[2] + r[3]);
+#else
+	float acc = 0;
+	for (int k = 0; k < n; ++k) {
+		acc += coefs[k] * x[k];
+	}
+	return acc;
+#endif
+}
+
+framecnt_t
+PolyphaseInterpolation::interpolate (framecnt_t nframes)
+{
+	double acceleration = 0.0;
+
+	if (_speed != _target_speed) {
+		acceleration = _target_speed - _speed;
+	}
+
+	double const step = _speed + acceleration;
+
+	if (nframes < 3) {
+		/* no interpolation possible; same as CubicInterpolation */
+		for (std::vector<Channel>::iterator c = _channels.begin(); c != _channels.end(); ++c) {
+			memcpy (c->output, c->input, nframes * sizeof (Sample));
+		}
+		return nframes;
+	}
+
+	/* the first few output samples need the tail of the previous cycle,
+	   so give each channel a contiguous copy of the joint.
+	*/
+
+	framecnt_t const available = (framecnt_t) ceil (nframes * step) + lookahead;
+	framecnt_t const n_edge = std::min ((framecnt_t) taps, available);
+
+	for (std::vector<Channel>::iterator c = _channels.begin(); c != _channels.end(); ++c) {
+		memcpy (c->edge + half_taps, c->input, n_edge * sizeof (Sample));
+		memset (c->edge + half_taps + n_edge, 0, (taps - n_edge) * sizeof (Sample));
+	}
+
+	float const * table = filter_table (step);
+#ifdef COMPILER_MSVC
+	__declspec(align(16)) float coefs[taps];
+#else
+	float coefs[taps] __attribute__ ((aligned (16)));
+#endif
+
+	double distance = phase.empty () ? 0.0 : phase[0];
+
+	for (framecnt_t outsample = 0; outsample < nframes; ++outsample) {
+
+		framecnt_t const i = (framecnt_t) floor (distance);
+		double const p = (distance - i) * phases;
+		int p0 = (int) p;
+		if (p0 >= phases) {
+			p0 = phases - 1;
+		}
+		float const t = p - p0;
+
+		float const * r0 = table + p0 * taps;
+		float const * r1 = r0 + taps;
+
+		for (int k = 0; k < taps; ++k) {
+			coefs[k] = r0[k] + t * (r1[k] - r0[k]);
+		}
+
+		/* first input sample used is i - half_taps + 1 */
+
+		if (i < half_taps - 1) {
+			for (std::vector<Channel>::iterator c = _channels.begin(); c != _channels.end(); ++c) {
+				c->output[outsample] = dot_product (coefs, c->edge + i + 1, taps);
+			}
+		} else {
+			for (std::vector<Channel>::iterator c = _channels.begin(); c != _channels.end(); ++c) {
+				c->output[outsample] = dot_product (coefs, c->input + i - half_taps + 1, taps);
+			}
+		}
+
+		distance += step;
+	}
+
+	framecnt_t const consumed = (framecnt_t) floor (distance);
+
+	/* keep the last half_taps consumed samples for the next cycle */
+
+	for (std::vector<Channel>::iterator c = _channels.begin(); c != _channels.end(); ++c) {
+		if (consumed >= half_taps) {
+			memcpy (c->edge, c->input + consumed - half_taps, half_taps * sizeof (Sample));
+		} else {
+			memmove (c->edge, c->edge + consumed, half_taps * sizeof (Sample));
+		}
+	}
+
+	for (size_t n = 0; n < phase.size(); ++n) {
+		phase[n] = distance - consumed;
+	}
+
+	return consumed;
+}
+
+framecnt_t
+PolyphaseInterpolation::distance (framecnt_t nframes) const
+{
+	if (nframes < 3) {
+		return nframes;
+	}
+
+	double acceleration = 0.0;
+
+	if (_speed != _target_speed) {
+		acceleration = _target_speed - _speed;
+	}
+
+	double distance = phase.empty () ? 0.0 : phase[0];
+
+	/* same accumulation as interpolate () for identical rounding */
+	for (framecnt_t outsample = 0; outsample < nframes; ++outsample) {
+		distance += _speed + acceleration;
+	}
+
+	return (framecnt_t) floor (distance);
+}
@@ -18,6 +18,9 @@
 */
 
 #include <math.h>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
 #include "ardour/kmeterdsp.h"
 
 
@@ -51,9 +54,7 @@ void Kmeterdsp::process (float const *p, int n)
 
     float  s, z1, z2;
 
-    // Get filter state.
-    z1 = _z1 > 50 ? 50 : (_z1 < 0 ? 0 : _z1);
-    z2 = _z2 > 50 ? 50 : (_z2 < 0 ? 0 : _z2);
+    get_state (z1, z2);
 
     // Perform filtering. The second filter is evaluated
     // only every 4th sample - this is just an optimisation.
@@ -75,6 +76,68 @@ void Kmeterdsp::process (float const *p, int n)
         z2 += 4 * _omega * (z1 - z2); // Update second filter.
     }
 
+    set_state (z1, z2);
+}
+
+void Kmeterdsp::process (Kmeterdsp* const *meters, float const * const *bufs, int nchan, int n)
+{
+    int c = 0;
+
+#ifdef __SSE__
+    // Four channels at a time, one channel per SSE lane.
+    const __m128 omega  = _mm_set1_ps (_omega);
+    const __m128 omega4 = _mm_set1_ps (4 * _omega);
+
+    for (; c + 4 <= nchan; c += 4)
+    {
+	float  v1 [4], v2 [4];
+	float const *p0 = bufs [c];
+	float const *p1 = bufs [c + 1];
+	float const *p2 = bufs [c + 2];
+	float const *p3 = bufs [c + 3];
+
+	for (int j = 0; j < 4; ++j) meters [c + j]->get_state (v1 [j], v2 [j]);
+	__m128 z1 = _mm_loadu_ps (v1);
+	__m128 z2 = _mm_loadu_ps (v2);
+
+	for (int i = n / 4; i > 0; --i)
+	{
+	    __m128 s0 = _mm_loadu_ps (p0);
+	    __m128 s1 = _mm_loadu_ps (p1);
+	    __m128 s2 = _mm_loadu_ps (p2);
+	    __m128 s3 = _mm_loadu_ps (p3);
+	    p0 += 4; p1 += 4; p2 += 4; p3 += 4;
+	    // s0 .. s3 now hold consecutive samples of all four channels.
+	    _MM_TRANSPOSE4_PS (s0, s1, s2, s3);
+	    z1 = _mm_add_ps (z1, _mm_mul_ps (omega, _mm_sub_ps (_mm_mul_ps (s0, s0), z1)));
+	    z1 = _mm_add_ps (z1, _mm_mul_ps (omega, _mm_sub_ps (_mm_mul_ps (s1, s1), z1)));
+	    z1 = _mm_add_ps (z1, _mm_mul_ps (omega, _mm_sub_ps (_mm_mul_ps (s2, s2), z1)));
+	    z1 = _mm_add_ps (z1, _mm_mul_ps (omega, _mm_sub_ps (_mm_mul_ps (s3, s3), z1)));
+	    z2 = _mm_add_ps (z2, _mm_mul_ps (omega4, _mm_sub_ps (z1, z2)));
+	}
+
+	_mm_storeu_ps (v1, z1);
+	_mm_storeu_ps (v2, z2);
+	for (int j = 0; j < 4; ++j) meters [c + j]->set_state (v1 [j], v2 [j]);
+    }
+#endif
+
+    for (; c < nchan; ++c)
+    {
+	meters [c]->process (bufs [c], n);
+    }
+}
+
+void Kmeterdsp::get_state (float& z1, float& z2) const
+{
+    z1 = _z1 > 50 ? 50 : (_z1 < 0 ? 0 : _z1);
+    z2 = _z2 > 50 ? 50 : (_z2 < 0 ? 0 : _z2);
+}
+
+void Kmeterdsp::set_state (float z1, float z2)
+{
+    float  s;
+
     if (isnan(z1)) z1 = 0;
     if (isnan(z2)) z2 = 0;
     // Save filter state. The added constants avoid denormals.
@@ -26,6 +26,7 @@
 #include "ardour/buffer_set.h"
 #include "ardour/dB.h"
 #include "ardour/meter.h"
+#include "ardour/meter_snapshot.h"
 #include "ardour/midi_buffer.h"
 #include "ardour/session.h"
 #include "ardour/rc_configuration.h"
@@ -48,10 +49,20 @@ PeakMeter::PeakMeter (Session& s, const std::string& name)
 	_reset_max = true;
 	_bufcnt = 0;
 	_combined_peak = 0;
+	_polled_types = 0;
+	_active_types = 0;
+	_recent_types = 0;
+	_poll_window = 0;
+	_snapshot = s.meter_snapshot ();
+	_snapshot_slot = MeterSnapshot::invalid_slot;
 }
 
 PeakMeter::~PeakMeter ()
 {
+	if (_snapshot_slot != MeterSnapshot::invalid_slot) {
+		_snapshot->release (_snapshot_slot);
+	}
+
 	while (_kmeter.size() > 0) {
 		delete (_kmeter.back());
 		delete (_iec1meter.back());
@@ -99,6 +110,20 @@ PeakMeter::run (BufferSet& bufs, framepos_t /*start_frame*/, framepos_t /*end_fr
 	const uint32_t zoh = _session.nominal_frame_rate() * .021;
 	_bufcnt += nframes;
 
+	/* find out which meter types are being looked at. A type stays active
+	 * for between one and two seconds after it was last polled.
+	 */
+	const guint polled = g_atomic_int_and (&_polled_types, 0) | _snapshot->collect_polled (_snapshot_slot);
+	const guint activated = polled & ~_active_types;
+	_active_types |= polled;
+	_recent_types |= polled;
+	_poll_window += nframes;
+	if (_poll_window > _session.nominal_frame_rate()) {
+		_active_types = _recent_types;
+		_recent_types = 0;
+		_poll_window = 0;
+	}
+
 	// Meter MIDI in to the first n_midi peaks
 	for (uint32_t i = 0; i < n_midi; ++i, ++n) {
 		float val = 0.0f;
@@ -164,17 +189,34 @@ PeakMeter::run (BufferSet& bufs, framepos_t /*start_frame*/, framepos_t /*end_fr
 			}
 		}
 
-		if (_meter_type & (MeterKrms | MeterK20 | MeterK14 | MeterK12)) {
-			_kmeter[i]->process(bufs.get_audio(i).data(), nframes);
+		_audio_data[i] = bufs.get_audio(i).data();
+	}
+
+	/* run the ballistics meters that someone is looking at, all channels at once */
+	if (n_audio > 0) {
+		if (_active_types & (MeterKrms | MeterK20 | MeterK14 | MeterK12)) {
+			if (activated & (MeterKrms | MeterK20 | MeterK14 | MeterK12)) {
+				for (uint32_t i = 0; i < n_audio; ++i) { _kmeter[i]->reset(); }
+			}
+			Kmeterdsp::process (&_kmeter[0], &_audio_data[0], n_audio, nframes);
 		}
-		if (_meter_type & (MeterIEC1DIN | MeterIEC1NOR)) {
-			_iec1meter[i]->process(bufs.get_audio(i).data(), nframes);
+		if (_active_types & (MeterIEC1DIN | MeterIEC1NOR)) {
+			if (activated & (MeterIEC1DIN | MeterIEC1NOR)) {
+				for (uint32_t i = 0; i < n_audio; ++i) { _iec1meter[i]->reset(); }
+			}
+			Iec1ppmdsp::process (&_iec1meter[0], &_audio_data[0], n_audio, nframes);
 		}
-		if (_meter_type & (MeterIEC2BBC | MeterIEC2EBU)) {
-			_iec2meter[i]->process(bufs.get_audio(i).data(), nframes);
+		if (_active_types & (MeterIEC2BBC | MeterIEC2EBU)) {
+			if (activated & (MeterIEC2BBC | MeterIEC2EBU)) {
+				for (uint32_t i = 0; i < n_audio; ++i) { _iec2meter[i]->reset(); }
+			}
+			Iec2ppmdsp::process (&_iec2meter[0], &_audio_data[0], n_audio, nframes);
 		}
-		if (_meter_type & MeterVU) {
-			_vumeter[i]->process(bufs.get_audio(i).data(), nframes);
+		if (_active_types & MeterVU) {
+			if (activated & MeterVU) {
+				for (uint32_t i = 0; i < n_audio; ++i) { _vumeter[i]->reset(); }
+			}
+			Vumeterdsp::process (&_vumeter[0], &_audio_data[0], n_audio, nframes);
 		}
 	}
 
@@ -188,9 +230,64 @@ PeakMeter::run (BufferSet& bufs, framepos_t /*start_frame*/, framepos_t /*end_fr
 		_bufcnt = 0;
 	}
 
+	if (_snapshot->writing ()) {
+		write_snapshot (n_midi, n_audio);
+	}
+
 	_active = _pending_active;
 }
 
+/** Copy the current state of all channels into our slot of the session's
+ *  MeterSnapshot (runs in jack realtime context)
+ */
+void
+PeakMeter::write_snapshot (uint32_t n_midi, uint32_t n_audio)
+{
+	float* d = _snapshot->back (_snapshot_slot);
+
+	if (!d) {
+		return;
+	}
+
+	const uint32_t limit = _peak_power.size();
+
+	for (uint32_t n = 0; n < limit; ++n) {
+		float* c = d + MeterSnapshot::NHeader + n * MeterSnapshot::NFields;
+
+		c[MeterSnapshot::Peak] = _peak_power[n];
+		c[MeterSnapshot::MaxPeak] = _max_peak_signal[n];
+		c[MeterSnapshot::KRMS] = 0;
+		c[MeterSnapshot::IEC1] = 0;
+		c[MeterSnapshot::IEC2] = 0;
+		c[MeterSnapshot::VU] = 0;
+
+		if (n < n_midi || n >= n_midi + n_audio) {
+			continue;
+		}
+
+		const uint32_t a = n - n_midi;
+
+		if (_active_types & (MeterKrms | MeterK20 | MeterK14 | MeterK12)) {
+			c[MeterSnapshot::KRMS] = _kmeter[a]->read ();
+		}
+		if (_active_types & (MeterIEC1DIN | MeterIEC1NOR)) {
+			c[MeterSnapshot::IEC1] = _iec1meter[a]->read ();
+		}
+		if (_active_types & (MeterIEC2BBC | MeterIEC2EBU)) {
+			c[MeterSnapshot::IEC2] = _iec2meter[a]->read ();
+		}
+		if (_active_types & MeterVU) {
+			c[MeterSnapshot::VU] = _vumeter[a]->read ();
+		}
+	}
+
+	d[MeterSnapshot::NMidi] = n_midi;
+
+	/* accumulated over all cycles since the last write */
+	_snapshot->hold_peak (_snapshot_slot, _combined_peak);
+	_combined_peak = 0;
+}
+
 void
 PeakMeter::reset ()
 {
@@ -266,6 +363,12 @@ PeakMeter::set_max_channels (const ChanCount& chn)
 	uint32_t const limit = chn.n_total();
 	const size_t n_audio = chn.n_audio();
 
+	if (_snapshot_slot == MeterSnapshot::invalid_slot) {
+		_snapshot_slot = _snapshot->allocate (limit);
+	} else if (limit != _peak_power.size()) {
+		_snapshot_slot = _snapshot->reallocate (_snapshot_slot, limit);
+	}
+
 	while (_peak_power.size() > limit) {
 		_peak_buffer.pop_back();
 		_peak_power.pop_back();
@@ -299,6 +402,7 @@ PeakMeter::set_max_channels (const ChanCount& chn)
 		_iec2meter.push_back(new Iec2ppmdsp());
 		_vumeter.push_back(new Vumeterdsp());
 	}
+	_audio_data.resize (n_audio, 0);
 	assert(_kmeter.size() == n_audio);
 	assert(_iec1meter.size() == n_audio);
 	assert(_iec2meter.size() == n_audio);
@@ -318,6 +422,7 @@ PeakMeter::set_max_channels (const ChanCount& chn)
 float
 PeakMeter::meter_level(uint32_t n, MeterType type) {
 	float mcptmp;
+	g_atomic_int_or (&_polled_types, type);
 	switch (type) {
 		case MeterKrms:
 		case MeterK20:
@@ -0,0 +1,324 @@
+/*
+    Copyright (C) 2016 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "pbd/fastlog.h"
+
+#include "ardour/dB.h"
+#include "ardour/meter_snapshot.h"
+
+using namespace ARDOUR;
+
+MeterSnapshot::MeterSnapshot ()
+	: _size (0)
+	, _layout (0)
+	, _generation (0)
+	, _writing (false)
+	, _since_publish (0)
+{
+}
+
+uint32_t
+MeterSnapshot::allocate (uint32_t n_channels)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	return allocate_unlocked (n_channels);
+}
+
+uint32_t
+MeterSnapshot::reallocate (uint32_t slot, uint32_t n_channels)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	if (slot < _slots.size()) {
+		if (_slots[slot].capacity >= n_channels) {
+			_slots[slot].n_channels = n_channels;
+			clear (slot);
+			++_layout;
+			return slot;
+		}
+		_slots[slot].used = false;
+		_slots[slot].n_channels = 0;
+	}
+
+	return allocate_unlocked (n_channels);
+}
+
+void
+MeterSnapshot::release (uint32_t slot)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	if (slot < _slots.size()) {
+		_slots[slot].used = false;
+		_slots[slot].n_channels = 0;
+		++_layout;
+	}
+}
+
+uint32_t
+MeterSnapshot::allocate_unlocked (uint32_t n_channels)
+{
+	uint32_t slot;
+
+	/* re-use a free slot that is big enough */
+
+	for (slot = 0; slot < _slots.size(); ++slot) {
+		if (!_slots[slot].used && _slots[slot].capacity >= n_channels) {
+			break;
+		}
+	}
+
+	if (slot == _slots.size()) {
+		Slot s;
+		s.offset = _size;
+		s.capacity = n_channels;
+		_slots.push_back (s);
+		_polled.push_back (0);
+		_held.push_back (0);
+		_size += slot_size (n_channels);
+		_data[0].resize (_size);
+		_data[1].resize (_size);
+	}
+
+	_slots[slot].used = true;
+	_slots[slot].n_channels = n_channels;
+	clear (slot);
+	++_layout;
+
+	return slot;
+}
+
+void
+MeterSnapshot::clear (uint32_t slot)
+{
+	Slot const & s (_slots[slot]);
+
+	for (int b = 0; b < 2; ++b) {
+		float* d = &_data[b][s.offset];
+		memset (d, 0, slot_size (s.capacity) * sizeof (float));
+		for (uint32_t n = 0; n < s.capacity; ++n) {
+			d[NHeader + n * NFields + Peak] = -std::numeric_limits<float>::infinity();
+		}
+	}
+
+	g_atomic_int_set (&_held[slot], 0);
+}
+
+float*
+MeterSnapshot::back (uint32_t slot)
+{
+	if (slot >= _slots.size() || !_slots[slot].used) {
+		return 0;
+	}
+	return &_data[(g_atomic_int_get (&_generation) + 1) & 1][_slots[slot].offset];
+}
+
+guint
+MeterSnapshot::collect_polled (uint32_t slot)
+{
+	if (slot >= _polled.size()) {
+		return 0;
+	}
+	return g_atomic_int_and (&_polled[slot], 0);
+}
+
+void
+MeterSnapshot::hold_peak (uint32_t slot, float coeff)
+{
+	if (slot >= _held.size() || !(coeff > 0)) {
+		return;
+	}
+
+	gint bits;
+	memcpy (&bits, &coeff, sizeof (bits));
+
+	/* non-negative floats compare like their bit patterns */
+
+	gint old;
+
+	do {
+		old = g_atomic_int_get (&_held[slot]);
+		if (old >= bits) {
+			return;
+		}
+	} while (!g_atomic_int_compare_and_exchange (&_held[slot], old, bits));
+}
+
+/** @return the peak held for @a slot, which is reset to 0 */
+float
+MeterSnapshot::take_held (uint32_t slot)
+{
+	gint old;
+
+	do {
+		old = g_atomic_int_get (&_held[slot]);
+	} while (old != 0 && !g_atomic_int_compare_and_exchange (&_held[slot], old, 0));
+
+	float coeff;
+	memcpy (&coeff, &old, sizeof (coeff));
+	return coeff;
+}
+
+void
+MeterSnapshot::cycle_done (pframes_t nframes, framecnt_t interval)
+{
+	if (_writing && _size > 0) {
+		const gint g = g_atomic_int_get (&_generation) + 1;
+
+		g_atomic_int_set (&_generation, g);
+
+		/* the buffer written next still holds older values: bring it
+		 * up to date, so that meters which do not run in a given
+		 * cycle keep what they last wrote.
+		 */
+		memcpy (&_data[(g + 1) & 1][0], &_data[g & 1][0], _size * sizeof (float));
+
+		_since_publish = 0;
+	}
+
+	_since_publish += nframes;
+	_writing = _since_publish >= interval;
+}
+
+MeterSnapshot::View::View ()
+	: _generation (-1)
+	, _layout (0)
+{
+}
+
+bool
+MeterSnapshot::View::update (MeterSnapshot& snap)
+{
+	Glib::Threads::Mutex::Lock lm (snap._lock);
+
+	/* tell the meters which types are being looked at */
+
+	for (uint32_t n = 0; n < _slots.size() && n < snap._polled.size(); ++n) {
+		if (_slots[n].wanted) {
+			g_atomic_int_or (&snap._polled[n], _slots[n].wanted);
+			_slots[n].wanted = 0;
+		}
+	}
+
+	/* take held peaks whether or not anything was published since */
+
+	for (uint32_t n = 0; n < _slots.size() && n < snap._held.size(); ++n) {
+		if (_slots[n].hold) {
+			_slots[n].held = std::max (_slots[n].held, snap.take_held (n));
+		}
+	}
+
+	gint g = g_atomic_int_get (&snap._generation);
+
+	if (g == _generation && _layout == snap._layout) {
+		return false;
+	}
+
+	if (_layout != snap._layout || _slots.size() != snap._slots.size()) {
+		_slots.resize (snap._slots.size());
+		for (uint32_t n = 0; n < _slots.size(); ++n) {
+			_slots[n].offset = snap._slots[n].offset;
+			_slots[n].n_channels = snap._slots[n].used ? snap._slots[n].n_channels : 0;
+		}
+		_layout = snap._layout;
+	}
+
+	/* the process thread may publish while we copy; try again if it did */
+
+	do {
+		g = g_atomic_int_get (&snap._generation);
+		_data.assign (snap._data[g & 1].begin(), snap._data[g & 1].begin() + snap._size);
+	} while (g_atomic_int_get (&snap._generation) != g);
+
+	_generation = g;
+
+	return true;
+}
+
+uint32_t
+MeterSnapshot::View::n_channels (uint32_t slot) const
+{
+	if (slot >= _slots.size()) {
+		return 0;
+	}
+	return _slots[slot].n_channels;
+}
+
+float
+MeterSnapshot::View::level (uint32_t slot, uint32_t chn, MeterType type)
+{
+	if (slot >= _slots.size() || chn >= _slots[slot].n_channels) {
+		return minus_infinity();
+	}
+
+	_slots[slot].wanted |= type;
+
+	float const * d = &_data[_slots[slot].offset];
+	float const * c = d + NHeader + chn * NFields;
+	const uint32_t n_midi = (uint32_t) d[NMidi];
+
+	switch (type) {
+		case MeterKrms:
+		case MeterK20:
+		case MeterK14:
+		case MeterK12:
+			if (chn >= n_midi) {
+				return accurate_coefficient_to_dB (c[KRMS]);
+			}
+			break;
+		case MeterIEC1DIN:
+		case MeterIEC1NOR:
+			if (chn >= n_midi) {
+				return accurate_coefficient_to_dB (c[IEC1]);
+			}
+			break;
+		case MeterIEC2BBC:
+		case MeterIEC2EBU:
+			if (chn >= n_midi) {
+				return accurate_coefficient_to_dB (c[IEC2]);
+			}
+			break;
+		case MeterVU:
+			if (chn >= n_midi) {
+				return accurate_coefficient_to_dB (c[VU]);
+			}
+			break;
+		case MeterPeak:
+		case MeterPeak0dB:
+			return c[Peak];
+		case MeterMCP:
+			{
+				/* like PeakMeter::meter_level(), reading clears it */
+				float const held = _slots[slot].held;
+				_slots[slot].hold = true;
+				_slots[slot].held = 0;
+				return accurate_coefficient_to_dB (held);
+			}
+		case MeterMaxSignal:
+			break;
+		default:
+		case MeterMaxPeak:
+			return accurate_coefficient_to_dB (c[MaxPeak]);
+	}
+
+	return minus_infinity();
+}
@@ -17,6 +17,7 @@
     675 Mass Ave, Cambridge, MA 02139, USA.
 */
 
+#include <algorithm>
 #include <iostream>
 
 #include "pbd/malign.h"
@@ -35,6 +36,9 @@ using namespace PBD;
 MidiBuffer::MidiBuffer(size_t capacity)
 	: Buffer (DataType::MIDI)
 	, _data (0)
+	, _scratch (0)
+	, _index (0)
+	, _index_capacity (0)
 {
 	if (capacity) {
 		resize (capacity);
@@ -45,6 +49,8 @@ MidiBuffer::MidiBuffer(size_t capacity)
 MidiBuffer::~MidiBuffer()
 {
 	cache_aligned_free(_data);
+	cache_aligned_free(_scratch);
+	delete [] _index;
 }
 
 void
@@ -61,13 +67,21 @@ MidiBuffer::resize(size_t size)
 	}
 
 	cache_aligned_free (_data);
+	cache_aligned_free (_scratch);
+	delete [] _index;
 
 	cache_aligned_malloc ((void**) &_data, size);
+	cache_aligned_malloc ((void**) &_scratch, size);
+
+	/* the smallest event is a timestamp plus a single status byte */
+	_index_capacity = size / (sizeof (TimeType) + 1) + 1;
+	_index = new uint32_t[_index_capacity];
 
 	_size = 0;
 	_capacity = size;
 
 	assert(_data);
+	assert(_scratch);
 }
 
 void
@@ -209,7 +223,7 @@ MidiBuffer::insert_event(const Evoral::MIDIEvent<TimeType>& ev)
 		}
 		if ((*m).time() == t) {
 			const uint8_t our_midi_status_byte = *(_data + m.offset + sizeof (TimeType));
-			if (second_simultaneous_midi_byte_is_first (ev.type(), our_midi_status_byte)) {
+			if (second_simultaneous_midi_byte_is_first (ev.buffer()[0], our_midi_status_byte)) {
 				continue;
 			}
 		}
@@ -403,7 +417,101 @@ MidiBuffer::second_simultaneous_midi_byte_is_first (uint8_t a, uint8_t b)
 	return b_first;
 }
 
-/** Merge \a other into this buffer.  Realtime safe. */
+/** Position of a channel message among simultaneous events on the same
+ * channel, following the order used by second_simultaneous_midi_byte_is_first().
+ * System messages have no preferred position and go first.
+ */
+static inline int
+simultaneous_rank (uint8_t status)
+{
+	switch (status & 0xf0) {
+	case MIDI_CMD_CONTROL:
+		return 1;
+	case MIDI_CMD_PGM_CHANGE:
+		return 2;
+	case MIDI_CMD_NOTE_OFF:
+		return 3;
+	case MIDI_CMD_NOTE_ON:
+		return 4;
+	case MIDI_CMD_NOTE_PRESSURE:
+		return 5;
+	case MIDI_CMD_CHANNEL_PRESSURE:
+		return 6;
+	case MIDI_CMD_BENDER:
+		return 7;
+	default:
+		return 0;
+	}
+}
+
+namespace {
+
+/* orders event offsets by time, then by simultaneous_rank(), then by
+ * offset so that the sort is stable.
+ */
+struct EventOffsetOrder {
+	EventOffsetOrder (const uint8_t* d) : data (d) {}
+
+	bool operator() (uint32_t a, uint32_t b) const {
+		const MidiBuffer::TimeType ta = *(reinterpret_cast<const MidiBuffer::TimeType*>((uintptr_t)(data + a)));
+		const MidiBuffer::TimeType tb = *(reinterpret_cast<const MidiBuffer::TimeType*>((uintptr_t)(data + b)));
+		if (ta != tb) {
+			return ta < tb;
+		}
+		const int ra = simultaneous_rank (data[a + sizeof (MidiBuffer::TimeType)]);
+		const int rb = simultaneous_rank (data[b + sizeof (MidiBuffer::TimeType)]);
+		if (ra != rb) {
+			return ra < rb;
+		}
+		return a < b;
+	}
+
+	const uint8_t* data;
+};
+
+}
+
+void
+MidiBuffer::sort ()
+{
+	const size_t stamp_size = sizeof (TimeType);
+	EventOffsetOrder order (_data);
+	size_t n = 0;
+	bool in_order = true;
+
+	for (iterator i = begin(); i != end(); ++i) {
+		assert (n < _index_capacity);
+		_index[n] = i.offset;
+		if (n > 0 && order (_index[n], _index[n - 1])) {
+			in_order = false;
+		}
+		++n;
+	}
+
+	if (in_order) {
+		return;
+	}
+
+	std::sort (_index, _index + n, order);
+
+	size_t out = 0;
+
+	for (size_t e = 0; e < n; ++e) {
+		const uint8_t* ev = _data + _index[e];
+		const size_t sz = stamp_size + Evoral::midi_event_size (ev + stamp_size);
+		memcpy (_scratch + out, ev, sz);
+		out += sz;
+	}
+
+	assert (out == _size);
+	std::swap (_data, _scratch);
+}
+
+/** Merge \a other into this buffer.  Realtime safe.
+ *
+ * Both buffers are assumed to be in time order.  The result is built in the
+ * scratch buffer in one linear pass and then swapped in.
+ */
 bool
 MidiBuffer::merge_in_place (const MidiBuffer &other)
 {
@@ -424,146 +532,56 @@ MidiBuffer::merge_in_place (const MidiBuffer &other)
 		return false;
 	}
 
-	const_iterator them = other.begin();
-	iterator us = begin();
+	const size_t stamp_size = sizeof (TimeType);
+	size_t us = 0;
+	size_t them = 0;
+	size_t out = 0;
 
-	while (them != other.end()) {
+	while (us < _size && them < other._size) {
 
-		size_t bytes_to_merge;
-		ssize_t merge_offset;
+		const uint8_t* ours = _data + us;
+		const uint8_t* theirs = other._data + them;
+		const TimeType our_time = *(reinterpret_cast<const TimeType*>((uintptr_t)ours));
+		const TimeType their_time = *(reinterpret_cast<const TimeType*>((uintptr_t)theirs));
+		bool them_first;
 
-		/* gather up total size of events that are earlier than
-		   the event referenced by "us"
-		*/
-
-		merge_offset = -1;
-		bytes_to_merge = 0;
-
-		while (them != other.end() && (*them).time() < (*us).time()) {
-			if (merge_offset == -1) {
-				merge_offset = them.offset;
-			}
-			bytes_to_merge += sizeof (TimeType) + (*them).size();
-			++them;
-		}
-
-		/* "them" now points to either:
-		 *
-		 * 1) an event that has the same or later timestamp than the
-		 *        event pointed to by "us"
-		 *
-		 * OR
-		 *
-		 * 2) the end of the "other" buffer
-		 *
-		 * if "sz" is non-zero, there is data to be merged from "other"
-		 * into this buffer before we do anything else, corresponding
-		 * to the events from "other" that we skipped while advancing
-		 * "them".
-		 */
-
-		if (bytes_to_merge) {
-			assert(merge_offset >= 0);
-			/* move existing */
-			memmove (_data + us.offset + bytes_to_merge, _data + us.offset, _size - us.offset);
-			/* increase _size */
-			_size += bytes_to_merge;
-			assert (_size <= _capacity);
-			/* insert new stuff */
-			memcpy  (_data + us.offset, other._data + merge_offset, bytes_to_merge);
-			/* update iterator to our own events. this is a miserable hack */
-			us.offset += bytes_to_merge;
-		}
-
-		/* if we're at the end of the other buffer, we're done */
-
-		if (them == other.end()) {
-			break;
-		}
-
-		/* if we have two messages messages with the same timestamp. we
-		 * must order them correctly.
-		 */
-
-		if ((*us).time() == (*them).time()) {
+		if (our_time != their_time) {
+			them_first = their_time < our_time;
+		} else {
+			/* two messages with the same timestamp: we must order them correctly */
+			them_first = second_simultaneous_midi_byte_is_first (ours[stamp_size], theirs[stamp_size]);
 
 			DEBUG_TRACE (DEBUG::MidiIO,
-				     string_compose ("simultaneous MIDI events discovered during merge, times %1/%2 status %3/%4\n",
-						     (*us).time(), (*them).time(),
-						     (int) *(_data + us.offset + sizeof (TimeType)),
-						     (int) *(other._data + them.offset + sizeof (TimeType))));
-
-			uint8_t our_midi_status_byte = *(_data + us.offset + sizeof (TimeType));
-			uint8_t their_midi_status_byte = *(other._data + them.offset + sizeof (TimeType));
-			bool them_first = second_simultaneous_midi_byte_is_first (our_midi_status_byte, their_midi_status_byte);
-
-			DEBUG_TRACE (DEBUG::MidiIO, string_compose ("other message came first ? %1\n", them_first));
-
-			if (!them_first) {
-				/* skip past our own event */
-				++us;
-			}
-
-			bytes_to_merge = sizeof (TimeType) + (*them).size();
-
-			/* move our remaining events later in the buffer by
-			 * enough to fit the one message we're going to merge
-			 */
-
-			memmove (_data + us.offset + bytes_to_merge, _data + us.offset, _size - us.offset);
-			/* increase _size */
-			_size += bytes_to_merge;
-			assert(_size <= _capacity);
-			/* insert new stuff */
-			memcpy  (_data + us.offset, other._data + them.offset, bytes_to_merge);
-			/* update iterator to our own events. this is a miserable hack */
-			us.offset += bytes_to_merge;
-			/* 'us' is now an iterator to the event right after the
-			   new ones that we merged
-			*/
-			if (them_first) {
-				/* need to skip the event pointed to by 'us'
-				   since its at the same time as 'them'
-				   (still), and we'll enter
-				*/
-
-				if (us != end()) {
-					++us;
-				}
-			}
+				     string_compose ("simultaneous MIDI events discovered during merge, times %1/%2 status %3/%4, other first ? %5\n",
+						     our_time, their_time, (int) ours[stamp_size], (int) theirs[stamp_size], them_first));
+		}
 
-			/* we merged one event from the other buffer, so
-			 * advance the iterator there.
-			 */
+		const uint8_t* src = them_first ? theirs : ours;
+		const int event_size = Evoral::midi_event_size (src + stamp_size);
+		assert (event_size >= 0);
+		const size_t sz = stamp_size + event_size;
 
-			++them;
+		memcpy (_scratch + out, src, sz);
+		out += sz;
 
+		if (them_first) {
+			them += sz;
 		} else {
-
-			/* advance past our own events to get to the correct insertion
-			   point for the next event(s) from "other"
-			*/
-
-			while (us != end() && (*us).time() <= (*them).time()) {
-				++us;
-			}
+			us += sz;
 		}
+	}
 
-		/* check to see if we reached the end of this buffer while
-		 * looking for the insertion point.
-		 */
+	/* at most one of these has anything left */
 
-		if (us == end()) {
+	memcpy (_scratch + out, _data + us, _size - us);
+	out += _size - us;
+	memcpy (_scratch + out, other._data + them, other._size - them);
+	out += other._size - them;
 
-			/* just append the rest of other and we're done*/
+	assert (out <= _capacity);
 
-			memcpy (_data + us.offset, other._data + them.offset, other._size - them.offset);
-			_size += other._size - them.offset;
-			assert(_size <= _capacity);
-			break;
-		}
-	}
+	std::swap (_data, _scratch);
+	_size = out;
 
 	return true;
 }
-
@@ -449,6 +449,8 @@ MidiDiskstream::process (BufferSet& bufs, framepos_t transport_frame, pframes_t
 		}
 		g_atomic_int_add(const_cast<gint*>(&_frames_pending_write), nframes);
 
+		_io_stats.capture_fill (1.0 - (double) _capture_buf->write_space() / (double) _capture_buf->bufsize());
+
 		if (buf.size() != 0) {
 			Glib::Threads::Mutex::Lock lm (_gui_feed_buffer_mutex, Glib::Threads::TRY_LOCK);
 
@@ -507,6 +509,24 @@ MidiDiskstream::process (BufferSet& bufs, framepos_t transport_frame, pframes_t
 	}
 
 	if (need_disk_signal) {
+
+		if (playback_distance > 0) {
+			/* the butler keeps up to midi_readahead frames' worth of events
+			   ahead of playback; if it is further behind than this cycle,
+			   the events we are about to play are missing.
+			*/
+			uint32_t const frames_read = g_atomic_int_get (&_frames_read_from_ringbuffer);
+			uint32_t const frames_written = g_atomic_int_get (&_frames_written_to_ringbuffer);
+			framecnt_t const ahead = (frames_written > frames_read) ? (framecnt_t) (frames_written - frames_read) : 0;
+
+			_io_stats.playback_fill ((double) ahead / (double) midi_readahead);
+
+			if (ahead < playback_distance) {
+				_io_stats.underrun (transport_frame, playback_distance, ahead,
+				                    _pending_overwrite || _session.butler()->transport_work_requested());
+			}
+		}
+
 		/* copy the diskstream data to all output buffers */
 
 		MidiBuffer& mbuf (bufs.get_midi (0));
@@ -827,10 +847,16 @@ MidiDiskstream::do_refill ()
 	to_read = min (to_read, (framecnt_t) (max_framepos - file_frame));
 	to_read = min (to_read, (framecnt_t) write_space);
 
+	_io_stats.refill_started ();
+
 	if (read (file_frame, to_read, reversed)) {
 		ret = -1;
 	}
 
+	/* approximate: the process thread may have read meanwhile */
+	size_t const remaining = _playback_buf->write_space();
+	_io_stats.refill_done (remaining < write_space ? write_space - remaining : 0, 1);
+
 	return ret;
 }
 
@@ -23,7 +23,6 @@
 #include <iostream>
 #include <utility>
 
-#include "evoral/EventList.hpp"
 #include "evoral/Control.hpp"
 
 #include "ardour/beats_frames_converter.h"
@@ -90,20 +89,107 @@ MidiPlaylist::~MidiPlaylist ()
 {
 }
 
-template<typename Time>
-struct EventsSortByTimeAndType {
-    bool operator() (Evoral::Event<Time>* a, Evoral::Event<Time>* b) {
-	    if (a->time() == b->time()) {
-		    if (parameter_is_midi ((AutomationType)a->event_type()) &&
-		        parameter_is_midi ((AutomationType)b->event_type())) {
-			    /* negate return value since we must return whether
-			     * or not a should sort before b, not b before a
-			     */
-			    return !MidiBuffer::second_simultaneous_midi_byte_is_first (a->buffer()[0], b->buffer()[0]);
-		    }
-	    }
-	    return a->time() < b->time();
-    }
+/** @return true if an event at @a ta of type @a ya starting with @a ba has
+ *  to be written before one at @a tb of type @a yb starting with @a bb.
+ */
+static bool
+event_before (framepos_t ta, Evoral::EventType ya, uint8_t ba, framepos_t tb, Evoral::EventType yb, uint8_t bb)
+{
+	if (ta != tb) {
+		return ta < tb;
+	}
+
+	if (parameter_is_midi ((AutomationType) ya) && parameter_is_midi ((AutomationType) yb)) {
+		return MidiBuffer::second_simultaneous_midi_byte_is_first (bb, ba);
+	}
+
+	return false;
+}
+
+bool
+MidiPlaylist::ReadBuffer::before (size_t a, ReadBuffer const & other, size_t b) const
+{
+	Event const & ea (_events[a]);
+	Event const & eb (other._events[b]);
+
+	return event_before (ea.time, ea.type, _data[ea.offset], eb.time, eb.type, other._data[eb.offset]);
+}
+
+uint32_t
+MidiPlaylist::ReadBuffer::write (framepos_t time, Evoral::EventType type, uint32_t size, const uint8_t* buf)
+{
+	Event ev;
+
+	ev.time = time;
+	ev.type = type;
+	ev.size = size;
+	ev.offset = _data.size();
+
+	_data.insert (_data.end(), buf, buf + size);
+	_events.push_back (ev);
+
+	if (_sorted && _events.size() > 1 && before (_events.size() - 1, *this, _events.size() - 2)) {
+		_sorted = false;
+	}
+
+	return size;
+}
+
+/** Order events by time and type, and by the order they were written in
+ *  when neither has to go first.
+ */
+struct MidiPlaylist::ReadBuffer::EventOrder {
+	EventOrder (ReadBuffer const & b) : buf (b) {}
+
+	bool operator() (Event const & a, Event const & b) const {
+		if (event_before (a.time, a.type, buf._data[a.offset], b.time, b.type, buf._data[b.offset])) {
+			return true;
+		}
+		if (event_before (b.time, b.type, buf._data[b.offset], a.time, a.type, buf._data[a.offset])) {
+			return false;
+		}
+		return a.offset < b.offset;
+	}
+
+	ReadBuffer const & buf;
+};
+
+void
+MidiPlaylist::ReadBuffer::sort ()
+{
+	/* regions normally deliver their events in order */
+	if (!_sorted) {
+		std::sort (_events.begin(), _events.end(), EventOrder (*this));
+		_sorted = true;
+	}
+}
+
+void
+MidiPlaylist::ReadBuffer::clear ()
+{
+	/* keeps the allocated space */
+	_events.clear ();
+	_data.clear ();
+	_sorted = true;
+}
+
+/** Heap order for the merge: the cursor whose event has to be written
+ *  last sorts first, ties going to the region read first.
+ */
+struct MidiPlaylist::MergeOrder {
+	MergeOrder (std::vector<ReadBuffer> const & b) : bufs (b) {}
+
+	bool operator() (MergeCursor const & a, MergeCursor const & b) const {
+		if (bufs[b.buffer].before (b.pos, bufs[a.buffer], a.pos)) {
+			return true;
+		}
+		if (bufs[a.buffer].before (a.pos, bufs[b.buffer], b.pos)) {
+			return false;
+		}
+		return a.buffer > b.buffer;
+	}
+
+	std::vector<ReadBuffer> const & bufs;
 };
 
 framecnt_t
@@ -127,9 +213,9 @@ MidiPlaylist::read (Evoral::EventSink<framepos_t>& dst,
 	}
 
 	/* Find relevant regions that overlap [start..end] */
-	const framepos_t                         end = start + dur - 1;
-	std::vector< boost::shared_ptr<Region> > regs;
-	std::vector< boost::shared_ptr<Region> > ended;
+	const framepos_t                          end = start + dur - 1;
+	std::vector< boost::shared_ptr<Region> >& regs (_read_regions);
+	std::vector< boost::shared_ptr<Region> >& ended (_ended_regions);
 	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
 		switch ((*i)->coverage (start, end)) {
 		case Evoral::OverlapStart:
@@ -156,12 +242,13 @@ MidiPlaylist::read (Evoral::EventSink<framepos_t>& dst,
 	}
 
 	/* If we are reading from a single region, we can read directly into dst.  Otherwise,
-	   we read into a temporarily list, sort it, then write that to dst. */
+	   each region is read into a buffer of its own, and the buffers are merged into dst. */
 	const bool direct_read = regs.size() == 1 &&
 		(ended.empty() || (ended.size() == 1 && ended.front() == regs.front()));
 
-	Evoral::EventList<framepos_t>  evlist;
-	Evoral::EventSink<framepos_t>& tgt = direct_read ? dst : evlist;
+	if (!direct_read && _read_buffers.size() < regs.size()) {
+		_read_buffers.resize (regs.size());
+	}
 
 	DEBUG_TRACE (DEBUG::MidiPlaylistIO,
 	             string_compose ("\t%1 regions to read, direct: %2\n", regs.size(), direct_read));
@@ -172,6 +259,8 @@ MidiPlaylist::read (Evoral::EventSink<framepos_t>& dst,
 			continue;
 		}
 
+		Evoral::EventSink<framepos_t>& tgt = direct_read ? dst : _read_buffers[i - regs.begin()];
+
 		/* Get the existing note tracker for this region, or create a new one. */
 		NoteTrackers::iterator           t           = _note_trackers.find (mr.get());
 		bool                             new_tracker = false;
@@ -216,19 +305,46 @@ MidiPlaylist::read (Evoral::EventSink<framepos_t>& dst,
 		}
 	}
 
-	if (!direct_read && !evlist.empty()) {
-		/* We've read from multiple regions, sort the event list by time. */
-		EventsSortByTimeAndType<framepos_t> cmp;
-		evlist.sort (cmp);
+	if (!direct_read) {
+		/* We've read from multiple regions, merge their events into dst in time order. */
+		MergeOrder const order (_read_buffers);
+
+		_merge_heap.clear ();
 
-		/* Copy ordered events from event list to dst. */
-		for (Evoral::EventList<framepos_t>::iterator e = evlist.begin(); e != evlist.end(); ++e) {
-			Evoral::Event<framepos_t>* ev (*e);
-			dst.write (ev->time(), ev->event_type(), ev->size(), ev->buffer());
-			delete ev;
+		for (uint32_t n = 0; n < regs.size(); ++n) {
+			_read_buffers[n].sort ();
+			if (_read_buffers[n].size()) {
+				_merge_heap.push_back (MergeCursor (n, 0));
+			}
+		}
+
+		std::make_heap (_merge_heap.begin(), _merge_heap.end(), order);
+
+		while (!_merge_heap.empty()) {
+			std::pop_heap (_merge_heap.begin(), _merge_heap.end(), order);
+
+			MergeCursor& c (_merge_heap.back());
+			ReadBuffer const & buf (_read_buffers[c.buffer]);
+			ReadBuffer::Event const & ev (buf[c.pos]);
+
+			dst.write (ev.time, ev.type, ev.size, buf.data (ev));
+
+			if (++c.pos < buf.size()) {
+				std::push_heap (_merge_heap.begin(), _merge_heap.end(), order);
+			} else {
+				_merge_heap.pop_back ();
+			}
+		}
+
+		for (uint32_t n = 0; n < regs.size(); ++n) {
+			_read_buffers[n].clear ();
 		}
 	}
 
+	/* don't hold on to the regions until the next read */
+	regs.clear ();
+	ended.clear ();
+
 	DEBUG_TRACE (DEBUG::MidiPlaylistIO, "---- End MidiPlaylist::read ----\n");
 	_read_end = start + dur;
 	return dur;
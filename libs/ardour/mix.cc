@@ -17,6 +17,7 @@
 
 */
 
+#include <cassert>
 #include <cmath>
 #include "ardour/types.h"
 #include "ardour/utils.h"
@@ -142,6 +143,44 @@ default_copy_vector (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t
 	memcpy(dst, src, nframes*sizeof(ARDOUR::Sample));
 }
 
+void
+default_mix_buffers_with_gain_vector (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t nframes, const float * gain)
+{
+	for (pframes_t i = 0; i < nframes; i++) {
+		dst[i] += src[i] * gain[i];
+	}
+}
+
+void
+default_mix_buffer_to_outputs (ARDOUR::Sample * const * dst, uint32_t n_outputs, const ARDOUR::Sample * src, pframes_t nframes,
+                               const float * initial, const float * target, pframes_t ramp)
+{
+	assert (ramp <= nframes);
+
+	for (uint32_t o = 0; o < n_outputs; ++o) {
+
+		if (initial[o] == 0 && target[o] == 0) {
+			continue;
+		}
+
+		ARDOUR::Sample* const d = dst[o];
+		pframes_t i = 0;
+
+		if (ramp && initial[o] != target[o]) {
+			float const delta = (target[o] - initial[o]) / ramp;
+			for (; i < ramp; ++i) {
+				d[i] += src[i] * (initial[o] + i * delta);
+			}
+		}
+
+		float const gain = target[o];
+
+		for (; i < nframes; ++i) {
+			d[i] += src[i] * gain;
+		}
+	}
+}
+
 #if defined (__APPLE__) && defined (BUILD_VECLIB_OPTIMIZATIONS)
 #include <Accelerate/Accelerate.h>
 
@@ -21,6 +21,8 @@
 #include "libardour-config.h"
 #endif
 
+#include <algorithm>
+#include <limits>
 #include <string>
 
 #include "pbd/failed_constructor.h"
@@ -35,6 +37,7 @@
 #include "ardour/ladspa_plugin.h"
 #include "ardour/plugin.h"
 #include "ardour/plugin_insert.h"
+#include "ardour/rc_configuration.h"
 
 #ifdef LV2_SUPPORT
 #include "ardour/lv2_plugin.h"
@@ -67,6 +70,7 @@ PluginInsert::PluginInsert (Session& s, boost::shared_ptr<Plugin> plug)
 	: Processor (s, (plug ? plug->name() : string ("toBeRenamed")))
 	, _signal_analysis_collected_nframes(0)
 	, _signal_analysis_collect_nframes_max(0)
+	, _automated_controls (new AutomatedControls)
 {
 	/* the first is the master */
 
@@ -109,6 +113,11 @@ PluginInsert::set_count (uint32_t num)
 		}
 	}
 
+	_instance_tasks.resize (_plugins.size ());
+	for (uint32_t n = 0; n < _plugins.size (); ++n) {
+		_instance_tasks[n].plugin = _plugins[n];
+	}
+
 	return true;
 }
 
@@ -130,6 +139,40 @@ PluginInsert::control_list_automation_state_changed (Evoral::Parameter which, Au
 	}
 }
 
+void
+PluginInsert::automation_list_automation_state_changed (Evoral::Parameter which, AutoState s)
+{
+	boost::shared_ptr<AutomationControl> c = automation_control (which);
+
+	if (!c || !c->list ()) {
+		return;
+	}
+
+	const bool playback = (s & (Play | Touch));
+
+	{
+		boost::shared_ptr<AutomatedControls> cur = _automated_controls.reader ();
+		const bool listed = find (cur->begin (), cur->end (), c) != cur->end ();
+		if (listed == playback) {
+			return;
+		}
+	}
+
+	{
+		RCUWriter<AutomatedControls> writer (_automated_controls);
+		boost::shared_ptr<AutomatedControls> cl = writer.get_copy ();
+		AutomatedControls::iterator i = find (cl->begin (), cl->end (), c);
+
+		if (playback && i == cl->end ()) {
+			cl->push_back (c);
+		} else if (!playback && i != cl->end ()) {
+			cl->erase (i);
+		}
+	}
+
+	_automated_controls.flush ();
+}
+
 ChanCount
 PluginInsert::output_streams() const
 {
@@ -365,20 +408,19 @@ PluginInsert::connect_and_run (BufferSet& bufs, pframes_t nframes, framecnt_t of
 
 	if (with_auto) {
 
-		uint32_t n = 0;
+		boost::shared_ptr<AutomatedControls> ac = _automated_controls.reader ();
 
-		for (Controls::iterator li = controls().begin(); li != controls().end(); ++li, ++n) {
+		for (AutomatedControls::const_iterator li = ac->begin(); li != ac->end(); ++li) {
 
-			boost::shared_ptr<AutomationControl> c
-				= boost::dynamic_pointer_cast<AutomationControl>(li->second);
+			AutomationControl& c (**li);
 
-			if (c->list() && c->automation_playback()) {
+			if (c.automation_playback()) {
 				bool valid;
 
-				const float val = c->list()->rt_safe_eval (now, valid);
+				const float val = c.list()->rt_safe_eval (now, valid);
 
 				if (valid) {
-					c->set_value(val);
+					c.set_value(val);
 				}
 
 			}
@@ -402,11 +444,40 @@ PluginInsert::connect_and_run (BufferSet& bufs, pframes_t nframes, framecnt_t of
 
 	}
 
-	for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
-		(*i)->connect_and_run(bufs, in_map, out_map, nframes, offset);
-		for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
-			in_map.offset_to(*t, natural_input_streams().get(*t));
-			out_map.offset_to(*t, natural_output_streams().get(*t));
+	if (can_run_instances_in_parallel (bufs)) {
+
+		/* each instance works on its own set of buffers, so all
+		   but the first can be handed to other process threads.
+		*/
+
+		boost::shared_ptr<Graph> graph = _session.process_graph ();
+
+		graph->start_tasks (_instance_tasks_group);
+
+		for (std::vector<PluginInstanceTask>::iterator i = _instance_tasks.begin(); i != _instance_tasks.end(); ++i) {
+			i->bufs = &bufs;
+			i->in_map = in_map;
+			i->out_map = out_map;
+			i->nframes = nframes;
+			i->offset = offset;
+			if (i != _instance_tasks.begin()) {
+				graph->dispatch_task (_instance_tasks_group, &(*i));
+			}
+			in_map.offset_to (DataType::AUDIO, natural_input_streams().n_audio());
+			out_map.offset_to (DataType::AUDIO, natural_output_streams().n_audio());
+		}
+
+		_instance_tasks.front().run ();
+
+		graph->join_tasks (_instance_tasks_group);
+
+	} else {
+		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
+			(*i)->connect_and_run(bufs, in_map, out_map, nframes, offset);
+			for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
+				in_map.offset_to(*t, natural_input_streams().get(*t));
+				out_map.offset_to(*t, natural_output_streams().get(*t));
+			}
 		}
 	}
 
@@ -438,6 +509,38 @@ PluginInsert::connect_and_run (BufferSet& bufs, pframes_t nframes, framecnt_t of
 	/* leave remaining channel buffers alone */
 }
 
+void
+PluginInsert::PluginInstanceTask::run ()
+{
+	plugin->connect_and_run (*bufs, in_map, out_map, nframes, offset);
+}
+
+/** @return true if our replicated plugin instances may be run concurrently
+ *  on the session's process threads for @param bufs.
+ */
+bool
+PluginInsert::can_run_instances_in_parallel (BufferSet const & bufs) const
+{
+	if (_plugins.size() < 2 || _instance_tasks.size() != _plugins.size()) {
+		return false;
+	}
+
+	if (!Config->get_parallel_plugin_instances ()) {
+		return false;
+	}
+
+	/* plugins share (and may write to) the first MIDI buffer, so
+	   only plain audio replication can be split up.
+	*/
+	if (bufs.count().n_midi() > 0 || _match.method != Replicate) {
+		return false;
+	}
+
+	boost::shared_ptr<Graph> graph = _session.process_graph ();
+
+	return graph && graph->in_process_thread ();
+}
+
 void
 PluginInsert::silence (framecnt_t nframes)
 {
@@ -541,6 +644,36 @@ PluginInsert::get_parameter (Evoral::Parameter param)
 	}
 }
 
+bool
+PluginInsert::find_next_automation_event (AutomatedControls const & ac, framepos_t now, framepos_t end, Evoral::ControlEvent& next_event) const
+{
+	next_event.when = std::numeric_limits<double>::max();
+
+	for (AutomatedControls::const_iterator li = ac.begin(); li != ac.end(); ++li) {
+
+		if (!(*li)->automation_playback()) {
+			continue;
+		}
+
+		boost::shared_ptr<const Evoral::ControlList> alist ((*li)->list());
+		Evoral::ControlEvent cp (now, 0.0f);
+		Evoral::ControlList::const_iterator i;
+
+		for (i = lower_bound (alist->begin(), alist->end(), &cp, Evoral::ControlList::time_comparator);
+		     i != alist->end() && (*i)->when < end; ++i) {
+			if ((*i)->when > now) {
+				break;
+			}
+		}
+
+		if (i != alist->end() && (*i)->when < end && (*i)->when < next_event.when) {
+			next_event.when = (*i)->when;
+		}
+	}
+
+	return next_event.when != std::numeric_limits<double>::max();
+}
+
 void
 PluginInsert::automation_run (BufferSet& bufs, framepos_t start, pframes_t nframes)
 {
@@ -549,6 +682,13 @@ PluginInsert::automation_run (BufferSet& bufs, framepos_t start, pframes_t nfram
 	framepos_t end = now + nframes;
 	framecnt_t offset = 0;
 
+	boost::shared_ptr<AutomatedControls> ac = _automated_controls.reader ();
+
+	if (ac->empty ()) {
+		connect_and_run (bufs, nframes, offset, false);
+		return;
+	}
+
 	Glib::Threads::Mutex::Lock lm (control_lock(), Glib::Threads::TRY_LOCK);
 
 	if (!lm.locked()) {
@@ -556,7 +696,7 @@ PluginInsert::automation_run (BufferSet& bufs, framepos_t start, pframes_t nfram
 		return;
 	}
 
-	if (!find_next_event (now, end, next_event) || requires_fixed_sized_buffers()) {
+	if (requires_fixed_sized_buffers() || !find_next_automation_event (*ac, now, end, next_event)) {
 
 		/* no events have a time within the relevant range */
 
@@ -564,9 +704,15 @@ PluginInsert::automation_run (BufferSet& bufs, framepos_t start, pframes_t nfram
 		return;
 	}
 
+	/* split the cycle at automation events, but never into sub-blocks
+	 * smaller than the configured minimum (except for the tail end).
+	 */
+	const framecnt_t min_block = max ((framecnt_t) 1, (framecnt_t) Config->get_plugin_automation_min_block ());
+
 	while (nframes) {
 
 		framecnt_t cnt = min (((framecnt_t) ceil (next_event.when) - now), (framecnt_t) nframes);
+		cnt = max (cnt, min (min_block, (framecnt_t) nframes));
 
 		connect_and_run (bufs, cnt, offset, true, now);
 
@@ -574,7 +720,7 @@ PluginInsert::automation_run (BufferSet& bufs, framepos_t start, pframes_t nfram
 		offset += cnt;
 		now += cnt;
 
-		if (!find_next_event (now, end, next_event)) {
+		if (!find_next_automation_event (*ac, now, end, next_event)) {
 			break;
 		}
 	}
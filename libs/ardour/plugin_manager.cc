@@ -26,6 +26,7 @@
 #include <sys/types.h>
 #include <cstdio>
 #include <cstdlib>
+#include <algorithm>
 
 #include <glib.h>
 #include "pbd/gstdio_compat.h"
@@ -60,6 +61,7 @@
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
 
+#include "pbd/cpus.h"
 #include "pbd/whitespace.h"
 #include "pbd/file_utils.h"
 
@@ -271,6 +273,8 @@ PluginManager::refresh (bool cache_only)
 #endif //Native linuxVST SUPPORT
 
 #if (defined WINDOWS_VST_SUPPORT || defined LXVST_SUPPORT)
+		vstfx_save_index ();
+
 		if (!cache_only) {
 			string fn = Glib::build_filename (ARDOUR::user_cache_directory(), VST_BLACKLIST);
 			if (Glib::file_test (fn, Glib::FILE_TEST_EXISTS)) {
@@ -302,6 +306,18 @@ PluginManager::refresh (bool cache_only)
 	_cancel_scan = false;
 }
 
+#if (defined WINDOWS_VST_SUPPORT || defined LXVST_SUPPORT)
+int
+PluginManager::vst_scan_jobs () const
+{
+	int jobs = Config->get_vst_scan_jobs ();
+	if (jobs <= 0) {
+		jobs = hardware_concurrency ();
+	}
+	return std::max (1, jobs);
+}
+#endif
+
 void
 PluginManager::cancel_plugin_scan ()
 {
@@ -376,6 +392,7 @@ PluginManager::clear_vst_cache ()
 #endif // old cache cleanup
 
 #if (defined WINDOWS_VST_SUPPORT || defined LXVST_SUPPORT)
+	vstfx_clear_index ();
 	{
 		string dn = Glib::build_filename (ARDOUR::user_cache_directory(), "vst");
 		vector<string> fsi_files;
@@ -780,6 +797,11 @@ PluginManager::windows_vst_discover_from_path (string path, bool cache_only)
 
 	find_files_matching_filter (plugin_objects, Config->get_plugin_path_vst(), windows_vst_filter, 0, false, true, true);
 
+	if (!cache_only && !cancelled()) {
+		_cancel_timeout = false;
+		vstfx_scan_parallel (plugin_objects, _("VST"), vst_scan_jobs ());
+	}
+
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x) {
 		ARDOUR::PluginScanMessage(_("VST"), *x, !cache_only && !cancelled());
 		windows_vst_discover (*x, cache_only || cancelled());
@@ -980,6 +1002,11 @@ PluginManager::lxvst_discover_from_path (string path, bool cache_only)
 
 	find_files_matching_filter (plugin_objects, Config->get_plugin_path_lxvst(), lxvst_filter, 0, false, true, true);
 
+	if (!cache_only && !cancelled()) {
+		_cancel_timeout = false;
+		vstfx_scan_parallel (plugin_objects, _("LXVST"), vst_scan_jobs ());
+	}
+
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x) {
 		ARDOUR::PluginScanMessage(_("LXVST"), *x, !cache_only && !cancelled());
 		lxvst_discover (*x, cache_only || cancelled());
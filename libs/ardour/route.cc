@@ -479,6 +479,8 @@ Route::process_output_buffers (BufferSet& bufs,
 		return;
 	}
 
+	_dsp_timing.start ();
+
 	/* figure out if we're going to use gain automation */
 	if (gain_automation_ok) {
 		_amp->set_gain_automation_buffer (_session.gain_automation_buffer ());
@@ -605,13 +607,17 @@ Route::process_output_buffers (BufferSet& bufs,
 			boost::dynamic_pointer_cast<Send>(*i)->set_delay_in(_signal_latency - latency);
 		}
 
+		(*i)->dsp_timing().start ();
 		(*i)->run (bufs, start_frame - latency, end_frame - latency, nframes, *i != _processors.back());
+		(*i)->dsp_timing().stop ();
 		bufs.set_count ((*i)->output_streams());
 
 		if ((*i)->active ()) {
 			latency += (*i)->signal_latency ();
 		}
 	}
+
+	_dsp_timing.stop ();
 }
 
 void
@@ -4750,6 +4756,16 @@ Route::processor_by_id (PBD::ID id) const
 	return boost::shared_ptr<Processor> ();
 }
 
+void
+Route::reset_dsp_timing ()
+{
+	Glib::Threads::RWLock::ReaderLock lm (_processor_lock);
+	for (ProcessorList::const_iterator i = _processors.begin(); i != _processors.end(); ++i) {
+		(*i)->dsp_timing().reset ();
+	}
+	_dsp_timing.reset ();
+}
+
 /** @return the monitoring state, or in other words what data we are pushing
  *  into the route (data from the inputs, data from disk or silence)
  */
@@ -4830,6 +4846,22 @@ Route::non_realtime_locate (framepos_t pos)
 	_roll_delay = _initial_delay;
 }
 
+void
+Route::render_automation (framepos_t start, framecnt_t len)
+{
+	Automatable::render_automation (start, len);
+
+	if (_pannable) {
+		_pannable->render_automation (start, len);
+	}
+
+	Glib::Threads::RWLock::ReaderLock lm (_processor_lock);
+
+	for (ProcessorList::iterator i = _processors.begin(); i != _processors.end(); ++i) {
+		(*i)->render_automation (start, len);
+	}
+}
+
 void
 Route::fill_buffers_with_input (BufferSet& bufs, boost::shared_ptr<IO> io, pframes_t nframes)
 {
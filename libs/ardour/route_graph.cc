@@ -59,14 +59,28 @@ GraphEdges::find_in_from_to_with_sends (GraphVertex from, GraphVertex to)
 	return _from_to_with_sends.end ();
 }
 
+GraphEdges::EdgeMapWithSends::const_iterator
+GraphEdges::find_in_from_to_with_sends (GraphVertex from, GraphVertex to) const
+{
+	typedef EdgeMapWithSends::const_iterator Iter;
+	pair<Iter, Iter> r = _from_to_with_sends.equal_range (from);
+	for (Iter i = r.first; i != r.second; ++i) {
+		if (i->second.first == to) {
+			return i;
+		}
+	}
+
+	return _from_to_with_sends.end ();
+}
+
 /** @param via_sends_only if non-0, filled in with true if the edge is a
  *  path via a send only.
  *  @return true if the given edge is present.
  */
 bool
-GraphEdges::has (GraphVertex from, GraphVertex to, bool* via_sends_only)
+GraphEdges::has (GraphVertex from, GraphVertex to, bool* via_sends_only) const
 {
-	EdgeMapWithSends::iterator i = find_in_from_to_with_sends (from, to);
+	EdgeMapWithSends::const_iterator i = find_in_from_to_with_sends (from, to);
 	if (i == _from_to_with_sends.end ()) {
 		return false;
 	}
@@ -239,3 +253,82 @@ ARDOUR::topological_sort (
 
 	return sorted_routes;
 }
+
+/** Compute the transitive closure of `edges'.  Because `sorted' is in
+ *  topological order, everything that feeds a route has been completed
+ *  by the time we reach it, so a single pass pushing each route's fed-by
+ *  set on to the routes that it directly feeds is enough.
+ *
+ *  One route feeds another `other than only via sends' if the first hop of
+ *  some path between them is not a send; this is what the solo code has
+ *  always used.
+ */
+void
+RouteReachability::build (RouteList const & sorted, GraphEdges const & edges)
+{
+	size_t const n = sorted.size ();
+
+	_routes.clear ();
+	_routes.reserve (n);
+	_index.clear ();
+
+	for (RouteList::const_iterator i = sorted.begin(); i != sorted.end(); ++i) {
+		_index[i->get()] = _routes.size ();
+		_routes.push_back (i->get());
+	}
+
+	_fed_by.assign (n, boost::dynamic_bitset<> (n));
+	_fed_by_signal.assign (n, boost::dynamic_bitset<> (n));
+
+	size_t a = 0;
+	for (RouteList::const_iterator i = sorted.begin(); i != sorted.end(); ++i, ++a) {
+
+		set<GraphVertex> const fed = edges.from (*i);
+
+		for (set<GraphVertex>::const_iterator j = fed.begin(); j != fed.end(); ++j) {
+
+			int const b = index_of (j->get());
+			if (b < 0 || (size_t) b == a) {
+				continue;
+			}
+
+			bool via_sends_only = false;
+			edges.has (*i, *j, &via_sends_only);
+
+			_fed_by[b] |= _fed_by[a];
+			_fed_by[b].set (a);
+
+			_fed_by_signal[b] |= _fed_by_signal[a];
+			if (!via_sends_only) {
+				_fed_by_signal[b].set (a);
+			}
+		}
+	}
+}
+
+bool
+RouteReachability::matches (RouteList const & r) const
+{
+	if (r.size () != _routes.size ()) {
+		return false;
+	}
+
+	vector<Route const *>::const_iterator j = _routes.begin ();
+	for (RouteList::const_iterator i = r.begin(); i != r.end(); ++i, ++j) {
+		if (i->get() != *j) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int
+RouteReachability::index_of (Route const * r) const
+{
+	map<Route const *, int>::const_iterator i = _index.find (r);
+	if (i == _index.end ()) {
+		return -1;
+	}
+	return i->second;
+}
@@ -75,6 +75,7 @@
 #include "ardour/midiport_manager.h"
 #include "ardour/scene_changer.h"
 #include "ardour/midi_track.h"
+#include "ardour/meter_snapshot.h"
 #include "ardour/midi_ui.h"
 #include "ardour/operations.h"
 #include "ardour/playlist.h"
@@ -225,6 +226,7 @@ Session::Session (AudioEngine &eng,
 	, pending_abort (false)
 	, pending_auto_loop (false)
 	, _butler (new Butler (*this))
+	, _meter_snapshot (new MeterSnapshot)
 	, _post_transport_work (0)
 	,  cumulative_rf_motion (0)
 	, rf_scale (1.0)
@@ -288,9 +290,15 @@ Session::Session (AudioEngine &eng,
 	, have_looped (false)
 	, _have_rec_enabled_track (false)
     , _have_rec_disabled_track (true)
+	, _rt_control_ops (4096)
+	, _rt_control_events (0)
 	, _step_editors (0)
 	, _suspend_timecode_transmission (0)
+	, _automation_rendered_seq (0)
+	, _automation_rendered_from (0)
+	, _automation_rendered_until (0)
 	,  _speakers (new Speakers)
+	, _route_reachability (new RouteReachability)
 	, _order_hint (-1)
 	, ignore_route_processor_changes (false)
 	, _scene_changer (0)
@@ -647,6 +655,9 @@ Session::destroy ()
 	}
 	routes.flush ();
 
+	/* make sure that no analysis threads are still using our sources */
+	Analyser::flush ();
+
 	{
 		DEBUG_TRACE (DEBUG::Destruction, "delete sources\n");
 		Glib::Threads::Mutex::Lock lm (source_lock);
@@ -2001,57 +2012,6 @@ Session::set_block_size (pframes_t nframes)
 	}
 }
 
-
-static void
-trace_terminal (boost::shared_ptr<Route> r1, boost::shared_ptr<Route> rbase)
-{
-	boost::shared_ptr<Route> r2;
-
-	if (r1->feeds (rbase) && rbase->feeds (r1)) {
-		info << string_compose(_("feedback loop setup between %1 and %2"), r1->name(), rbase->name()) << endmsg;
-		return;
-	}
-
-	/* make a copy of the existing list of routes that feed r1 */
-
-	Route::FedBy existing (r1->fed_by());
-
-	/* for each route that feeds r1, recurse, marking it as feeding
-	   rbase as well.
-	*/
-
-	for (Route::FedBy::iterator i = existing.begin(); i != existing.end(); ++i) {
-		if (!(r2 = i->r.lock ())) {
-			/* (*i) went away, ignore it */
-			continue;
-		}
-
-		/* r2 is a route that feeds r1 which somehow feeds base. mark
-		   base as being fed by r2
-		*/
-
-		rbase->add_fed_by (r2, i->sends_only);
-
-		if (r2 != rbase) {
-
-			/* 2nd level feedback loop detection. if r1 feeds or is fed by r2,
-			   stop here.
-			*/
-
-			if (r1->feeds (r2) && r2->feeds (r1)) {
-				continue;
-			}
-
-			/* now recurse, so that we can mark base as being fed by
-			   all routes that feed r2
-			*/
-
-			trace_terminal (r2, rbase);
-		}
-
-	}
-}
-
 void
 Session::resort_routes ()
 {
@@ -2155,11 +2115,25 @@ Session::resort_routes_using (boost::shared_ptr<RouteList> r)
 
 		_current_route_graph = edges;
 
-		/* Complete the building of the routes' lists of what directly
-		   or indirectly feeds them.
+		/* Work out which routes directly or indirectly feed which others,
+		   and use that to complete the building of the routes' lists of
+		   what feeds them.
 		*/
-		for (RouteList::iterator i = r->begin(); i != r->end(); ++i) {
-			trace_terminal (*i, *i);
+		{
+			RCUWriter<RouteReachability> writer (_route_reachability);
+			boost::shared_ptr<RouteReachability> reach = writer.get_copy ();
+			reach->build (*sorted_routes, edges);
+
+			vector<boost::shared_ptr<Route> > sorted (sorted_routes->begin(), sorted_routes->end());
+
+			for (size_t b = 0; b < sorted.size(); ++b) {
+				boost::dynamic_bitset<> const & fb (reach->fed_by (b));
+				for (size_t a = fb.find_first (); a != boost::dynamic_bitset<>::npos; a = fb.find_next (a)) {
+					bool via_sends_only;
+					reach->feeds (a, b, &via_sends_only);
+					sorted[b]->add_fed_by (sorted[a], via_sends_only);
+				}
+			}
 		}
 
 		*r = *sorted_routes;
@@ -2179,11 +2153,18 @@ Session::resort_routes_using (boost::shared_ptr<RouteList> r)
 		   and stick to the old graph; this will continue to be processed, so
 		   until the feedback is fixed, what is played back will not quite
 		   reflect what is actually connected.  Note also that we do not
-		   do trace_terminal here, as it would fail due to an endless recursion,
-		   so the solo code will think that everything is still connected
-		   as it was before.
+		   compute indirect feeds here, as that needs a sorted graph,
+		   so the solo code will only see the direct ones.
 		*/
 
+		{
+			/* the fed-by lists now only hold direct feeds, so stop
+			   using the old closure until we have a new one.
+			*/
+			RCUWriter<RouteReachability> writer (_route_reachability);
+			*writer.get_copy () = RouteReachability ();
+		}
+
 		FeedbackDetected (); /* EMIT SIGNAL */
 	}
 
@@ -3604,7 +3585,14 @@ Session::route_solo_changed (bool self_solo_change, bool group_override,  boost:
 
 	DEBUG_TRACE (DEBUG::Solo, string_compose ("%1\n", route->name()));
 
-	for (RouteList::iterator i = r->begin(); i != r->end(); ++i) {
+	/* use the cached reachability if it describes the current route
+	   list, otherwise fall back to searching the fed-by lists.
+	*/
+	boost::shared_ptr<RouteReachability> reach = _route_reachability.reader ();
+	int const ri = reach->matches (*r) ? reach->index_of (route.get()) : -1;
+	size_t n = 0;
+
+	for (RouteList::iterator i = r->begin(); i != r->end(); ++i, ++n) {
 		bool via_sends_only;
 		bool in_signal_flow;
 
@@ -3617,7 +3605,9 @@ Session::route_solo_changed (bool self_solo_change, bool group_override,  boost:
 
 		DEBUG_TRACE (DEBUG::Solo, string_compose ("check feed from %1\n", (*i)->name()));
 
-		if ((*i)->feeds (route, &via_sends_only)) {
+		bool const feeds_route = (ri < 0) ? (*i)->feeds (route, &via_sends_only) : reach->feeds (n, ri, &via_sends_only);
+
+		if (feeds_route) {
 			DEBUG_TRACE (DEBUG::Solo, string_compose ("\tthere is a feed from %1\n", (*i)->name()));
 			if (!via_sends_only) {
 				if (!route->soloed_by_others_upstream()) {
@@ -3635,7 +3625,9 @@ Session::route_solo_changed (bool self_solo_change, bool group_override,  boost:
 
 		DEBUG_TRACE (DEBUG::Solo, string_compose ("check feed to %1\n", (*i)->name()));
 
-		if (route->feeds (*i, &via_sends_only)) {
+		bool const fed_by_route = (ri < 0) ? route->feeds (*i, &via_sends_only) : reach->feeds (ri, n, &via_sends_only);
+
+		if (fed_by_route) {
 			/* propagate solo upstream only if routing other than
 			   sends is involved, but do consider the other route
 			   (*i) to be part of the signal flow even if only
@@ -4185,6 +4177,8 @@ Session::remove_source (boost::weak_ptr<Source> src)
 		}
 	}
 
+	Analyser::cancel_source_analysis (source);
+
 	if (!(_state_of_the_state & StateOfTheState (InCleanup|Loading))) {
 
 		/* save state so we don't end up with a session file
@@ -5454,6 +5448,54 @@ Session::get_mix_buffers (ChanCount count)
 	return ProcessThread::get_mix_buffers (count);
 }
 
+static void
+add_processor_timing (std::vector<Session::ProcessorTiming>& timings, boost::shared_ptr<Route> route, boost::weak_ptr<Processor> wp)
+{
+	boost::shared_ptr<Processor> p = wp.lock ();
+	Session::ProcessorTiming t;
+
+	if (p && p->dsp_timing().get_stats (t.stats)) {
+		t.route = route;
+		t.processor = p;
+		timings.push_back (t);
+	}
+}
+
+struct ProcessorTimingSorter {
+	bool operator() (Session::ProcessorTiming const & a, Session::ProcessorTiming const & b) const {
+		return a.stats.avg > b.stats.avg;
+	}
+};
+
+void
+Session::get_dsp_timing (std::vector<ProcessorTiming>& timings) const
+{
+	boost::shared_ptr<RouteList> r = routes.reader ();
+
+	timings.clear ();
+
+	for (RouteList::const_iterator i = r->begin(); i != r->end(); ++i) {
+		ProcessorTiming t;
+		if ((*i)->dsp_timing().get_stats (t.stats)) {
+			t.route = *i;
+			timings.push_back (t);
+		}
+		(*i)->foreach_processor (boost::bind (&add_processor_timing, boost::ref (timings), *i, _1));
+	}
+
+	std::stable_sort (timings.begin(), timings.end(), ProcessorTimingSorter ());
+}
+
+void
+Session::reset_dsp_timing ()
+{
+	boost::shared_ptr<RouteList> r = routes.reader ();
+
+	for (RouteList::const_iterator i = r->begin(); i != r->end(); ++i) {
+		(*i)->reset_dsp_timing ();
+	}
+}
+
 uint32_t
 Session::ntracks () const
 {
@@ -22,6 +22,7 @@
 #include "pbd/stacktrace.h"
 
 #include "ardour/butler.h"
+#include "ardour/disk_io_stats.h"
 #include "ardour/route.h"
 #include "ardour/session.h"
 #include "ardour/session_event.h"
@@ -121,3 +122,41 @@ Session::capture_load ()
 {
 	return (uint32_t) g_atomic_int_get (&_capture_load);
 }
+
+void
+Session::disk_io_report (std::ostream& out) const
+{
+	Butler::Stats const bs (_butler->stats ());
+
+	out << "butler passes " << bs.passes
+	    << " usecs avg " << (bs.passes ? bs.pass_total / (gint64) bs.passes : 0)
+	    << " max " << bs.pass_max
+	    << endl;
+	out << "butler transport work " << bs.transport_work
+	    << " usecs avg " << (bs.transport_work ? bs.transport_work_total / (gint64) bs.transport_work : 0)
+	    << " max " << bs.transport_work_max
+	    << endl;
+
+	boost::shared_ptr<RouteList> rl = routes.reader ();
+	for (RouteList::iterator i = rl->begin(); i != rl->end(); ++i) {
+		boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+		if (tr) {
+			out << tr->name () << endl;
+			tr->io_stats ().dump (out);
+		}
+	}
+}
+
+void
+Session::reset_disk_io_stats ()
+{
+	_butler->reset_stats ();
+
+	boost::shared_ptr<RouteList> rl = routes.reader ();
+	for (RouteList::iterator i = rl->begin(); i != rl->end(); ++i) {
+		boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+		if (tr) {
+			tr->io_stats ().reset ();
+		}
+	}
+}
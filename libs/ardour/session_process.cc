@@ -33,6 +33,7 @@
 #include "ardour/cycle_timer.h"
 #include "ardour/debug.h"
 #include "ardour/graph.h"
+#include "ardour/meter_snapshot.h"
 #include "ardour/port.h"
 #include "ardour/process_thread.h"
 #include "ardour/scene_changer.h"
@@ -75,6 +76,9 @@ Session::process (pframes_t nframes)
 
 	(this->*process_function) (nframes);
 
+	/* publish meter levels every 10ms or so */
+	_meter_snapshot->cycle_done (nframes, nominal_frame_rate () / 100);
+
 	/* realtime-safe meter-position and processor-order changes
 	 *
 	 * ideally this would be done in
@@ -314,6 +318,10 @@ Session::process_with_events (pframes_t nframes)
 		process_event (ev);
 	}
 
+	if (!non_realtime_work_pending()) {
+		process_rt_controls ();
+	}
+
 	/* Decide on what to do with quarter-frame MTC during this cycle */
 
 	bool const was_sending_qf_mtc = _send_qf_mtc;
@@ -480,6 +488,12 @@ Session::process_with_events (pframes_t nframes)
 
 	} /* implicit release of route lock */
 
+	/* have the butler render automation curves before they run out */
+
+	if (automation_render_wanted ()) {
+		session_needs_butler = true;
+	}
+
 	if (session_needs_butler) {
 		_butler->summon ();
 	}
@@ -923,6 +937,10 @@ Session::process_audition (pframes_t nframes)
 		process_event (ev);
 	}
 
+	if (!non_realtime_work_pending()) {
+		process_rt_controls ();
+	}
+
 	if (!auditioner->auditioning()) {
 		/* auditioner no longer active, so go back to the normal process callback */
 		process_function = &Session::process_with_events;
@@ -16,6 +16,8 @@
     Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 */
 
+#include <set>
+
 #include <boost/bind.hpp>
 
 #include "pbd/error.h"
@@ -35,6 +37,10 @@ using namespace Glib;
 void
 Session::set_monitoring (boost::shared_ptr<RouteList> rl, MonitorChoice mc, SessionEvent::RTeventCallback after, bool group_override)
 {
+	if (queue_rt_control (rl, RTControlOp::Monitoring, mc, after, group_override)) {
+		return;
+	}
+
 	queue_event (get_rt_event (rl, mc, after, group_override, &Session::rt_set_monitoring));
 }
 
@@ -56,6 +62,10 @@ Session::rt_set_monitoring (boost::shared_ptr<RouteList> rl, MonitorChoice mc, b
 void
 Session::clear_all_solo_state (boost::shared_ptr<RouteList> rl)
 {
+	if (queue_rt_control (rl, RTControlOp::ClearAllSolo, false, rt_cleanup, false)) {
+		return;
+	}
+
 	queue_event (get_rt_event (rl, false, rt_cleanup, false, &Session::rt_clear_all_solo_state));
 }
 
@@ -74,6 +84,10 @@ Session::rt_clear_all_solo_state (boost::shared_ptr<RouteList> rl, bool /* yn */
 void
 Session::set_solo (boost::shared_ptr<RouteList> rl, bool yn, SessionEvent::RTeventCallback after, bool group_override)
 {
+	if (queue_rt_control (rl, RTControlOp::Solo, yn, after, group_override)) {
+		return;
+	}
+
 	queue_event (get_rt_event (rl, yn, after, group_override, &Session::rt_set_solo));
 }
 
@@ -104,6 +118,10 @@ Session::set_just_one_solo (boost::shared_ptr<Route> r, bool yn, SessionEvent::R
 	boost::shared_ptr<RouteList> rl (new RouteList);
 	rl->push_back (r);
 
+	if (queue_rt_control (rl, RTControlOp::JustOneSolo, yn, after, false)) {
+		return;
+	}
+
 	queue_event (get_rt_event (rl, yn, after, false, &Session::rt_set_just_one_solo));
 }
 
@@ -127,6 +145,10 @@ Session::rt_set_just_one_solo (boost::shared_ptr<RouteList> just_one, bool yn, b
 void
 Session::set_listen (boost::shared_ptr<RouteList> rl, bool yn, SessionEvent::RTeventCallback after, bool group_override)
 {
+	if (queue_rt_control (rl, RTControlOp::Listen, yn, after, group_override)) {
+		return;
+	}
+
 	queue_event (get_rt_event (rl, yn, after, group_override, &Session::rt_set_listen));
 }
 
@@ -151,6 +173,10 @@ Session::set_mute (boost::shared_ptr<RouteList> rl, bool yn, SessionEvent::RTeve
 		mc->set_superficial_value(yn);
 	}
 
+	if (queue_rt_control (rl, RTControlOp::Mute, yn, after, group_override)) {
+		return;
+	}
+
 	queue_event (get_rt_event (rl, yn, after, group_override, &Session::rt_set_mute));
 }
 
@@ -169,6 +195,10 @@ Session::rt_set_mute (boost::shared_ptr<RouteList> rl, bool yn, bool /*group_ove
 void
 Session::set_solo_isolated (boost::shared_ptr<RouteList> rl, bool yn, SessionEvent::RTeventCallback after, bool group_override)
 {
+	if (queue_rt_control (rl, RTControlOp::SoloIsolate, yn, after, group_override)) {
+		return;
+	}
+
 	queue_event (get_rt_event (rl, yn, after, group_override, &Session::rt_set_solo_isolated));
 }
 
@@ -210,6 +240,10 @@ Session::set_record_enabled (boost::shared_ptr<RouteList> rl, bool yn, SessionEv
 		}
 	}
 
+	if (queue_rt_control (rl, RTControlOp::RecordEnable, yn, after, group_override)) {
+		return;
+	}
+
 	queue_event (get_rt_event (rl, yn, after, group_override, &Session::rt_set_record_enabled));
 }
 
@@ -236,6 +270,10 @@ void
 Session::set_record_safe (boost::shared_ptr<RouteList> rl, bool yn, SessionEvent::RTeventCallback after, bool group_override)
 {
 	set_record_enabled (rl, false, after, group_override);
+	if (queue_rt_control (rl, RTControlOp::RecordSafe, yn, after, group_override)) {
+		return;
+	}
+
 	queue_event (get_rt_event (rl, yn, after, group_override, &Session::rt_set_record_safe));
 }
 
@@ -260,8 +298,16 @@ Session::rt_set_record_safe (boost::shared_ptr<RouteList> rl, bool yn, bool grou
 void
 Session::process_rtop (SessionEvent* ev)
 {
+	/* every RT event comes from a change that could not use the RT
+	 * control ring. Whatever is still in the ring was queued before
+	 * this event, so apply that first.
+	 */
+	process_rt_controls ();
+
 	ev->rt_slot ();
 
+	g_atomic_int_add (&_rt_control_events, -1);
+
 	if (ev->event_loop) {
 		ev->event_loop->call_slot (MISSING_INVALIDATOR, boost::bind (ev->rt_return, ev));
 	} else {
@@ -269,3 +315,210 @@ Session::process_rtop (SessionEvent* ev)
 		ev->rt_return (ev);
 	}
 }
+
+namespace {
+	typedef void (*CleanupFunction) (SessionEvent*);
+}
+
+/** Queue a change to the routes in @a rl on the allocation-free RT path.
+ *  @return false if the change needs to go through a SessionEvent instead,
+ *  e.g. because the caller wants to be called back once it is done. The
+ *  caller must then queue that event (see get_rt_event()).
+ *
+ *  Changes must be applied in the order they were made, but the process
+ *  thread handles SessionEvents before the ring. So once a change has
+ *  fallen back to an event, later ones follow it until it has been
+ *  applied, and process_rtop() applies anything still in the ring before
+ *  the event itself.
+ */
+bool
+Session::queue_rt_control (boost::shared_ptr<RouteList> rl, RTControlOp::Type type, int32_t value, SessionEvent::RTeventCallback const & after, bool group_override)
+{
+	Glib::Threads::Mutex::Lock lm (_rt_control_write_lock);
+
+	if (g_atomic_int_get (&_rt_control_events) == 0 && write_rt_control (rl, type, value, after, group_override)) {
+		return true;
+	}
+
+	g_atomic_int_inc (&_rt_control_events);
+	return false;
+}
+
+/** Must be called with _rt_control_write_lock held */
+bool
+Session::write_rt_control (boost::shared_ptr<RouteList> rl, RTControlOp::Type type, int32_t value, SessionEvent::RTeventCallback const & after, bool group_override)
+{
+	if (_state_of_the_state & (Loading|Deletion)) {
+		return false;
+	}
+
+	CleanupFunction const * cb = after.target<CleanupFunction> ();
+	CleanupFunction const * cleanup = rt_cleanup.target<CleanupFunction> ();
+
+	if (!cb || !cleanup || *cb != *cleanup) {
+		return false;
+	}
+
+	std::set<Route const *> wanted;
+
+	for (RouteList::const_iterator i = rl->begin(); i != rl->end(); ++i) {
+		wanted.insert (i->get());
+	}
+
+	/* resolve routes to their position in the session's route list, so
+	 * that the process thread can find them without touching any
+	 * shared_ptr<Route>.
+	 */
+
+	boost::shared_ptr<RouteList> r = routes.reader ();
+	uint32_t n = 0;
+
+	_rt_control_batch.clear ();
+
+	for (RouteList::const_iterator i = r->begin(); i != r->end(); ++i, ++n) {
+		if (wanted.find (i->get()) == wanted.end()) {
+			continue;
+		}
+
+		RTControlOp op;
+		op.type = type;
+		op.index = n;
+		op.route = i->get();
+		op.value = value;
+		op.group_override = group_override;
+
+		_rt_control_batch.push_back (op);
+	}
+
+	if (_rt_control_batch.size() != wanted.size()) {
+		/* not all of them are session routes (e.g. the auditioner) */
+		return false;
+	}
+
+	if (_rt_control_batch.empty()) {
+		return true;
+	}
+
+	/* a batch is written in one go, so the process thread sees all of it or nothing */
+
+	if (_rt_control_ops.write_space() < _rt_control_batch.size()) {
+		return false;
+	}
+
+	_rt_control_ops.write (&_rt_control_batch[0], _rt_control_batch.size());
+
+	return true;
+}
+
+/** Apply changes queued by queue_rt_control(); called from the process thread. */
+void
+Session::process_rt_controls ()
+{
+	if (_rt_control_ops.read_space() == 0) {
+		return;
+	}
+
+	boost::shared_ptr<RouteList> r = routes.reader ();
+	RouteList::const_iterator i = r->begin();
+	uint32_t n = 0;
+	RTControlOp op;
+
+	while (_rt_control_ops.read (&op, 1) == 1) {
+
+		/* ops of a batch are in route order, so this is usually a
+		 * single forward walk over the route list.
+		 */
+
+		if (op.index < n) {
+			i = r->begin();
+			n = 0;
+		}
+
+		while (n < op.index && i != r->end()) {
+			++i;
+			++n;
+		}
+
+		if (i != r->end() && i->get() == op.route) {
+			apply_rt_control (i->get(), op, *r);
+			continue;
+		}
+
+		/* routes were added or removed since the op was queued */
+
+		for (RouteList::const_iterator j = r->begin(); j != r->end(); ++j) {
+			if (j->get() == op.route) {
+				apply_rt_control (j->get(), op, *r);
+				break;
+			}
+		}
+	}
+
+	set_dirty ();
+}
+
+void
+Session::apply_rt_control (Route* route, RTControlOp const & op, RouteList const & all)
+{
+	bool const yn = (op.value != 0);
+
+	if (route->is_auditioner()) {
+		return;
+	}
+
+	switch (op.type) {
+	case RTControlOp::Solo:
+		route->set_solo (yn, this, op.group_override);
+		break;
+
+	case RTControlOp::ClearAllSolo:
+		route->clear_all_solo_state ();
+		break;
+
+	case RTControlOp::JustOneSolo:
+		for (RouteList::const_iterator i = all.begin(); i != all.end(); ++i) {
+			if (!(*i)->is_auditioner() && i->get() != route) {
+				(*i)->set_solo (!yn, (*i)->route_group());
+			}
+		}
+		route->set_solo (yn, route->route_group());
+		break;
+
+	case RTControlOp::Listen:
+		route->set_listen (yn, this, op.group_override);
+		break;
+
+	case RTControlOp::Mute:
+		if (!route->is_monitor()) {
+			route->set_mute (yn, this);
+		}
+		break;
+
+	case RTControlOp::SoloIsolate:
+		if (!route->is_master() && !route->is_monitor()) {
+			route->set_solo_isolated (yn, this);
+		}
+		break;
+
+	case RTControlOp::RecordEnable:
+		if (!route->record_safe ()) {
+			Track* t = dynamic_cast<Track*> (route);
+			if (t) {
+				t->set_record_enabled (yn, (op.group_override ? (void*) t->route_group() : (void *) this));
+			}
+		}
+		break;
+
+	case RTControlOp::RecordSafe:
+		if (Track* t = dynamic_cast<Track*> (route)) {
+			t->set_record_safe (yn, (op.group_override ? (void*) t->route_group () : (void *) this));
+		}
+		break;
+
+	case RTControlOp::Monitoring:
+		if (Track* t = dynamic_cast<Track*> (route)) {
+			t->set_monitoring ((MonitorChoice) op.value);
+		}
+		break;
+	}
+}
@@ -76,6 +76,7 @@
 
 #include "ardour/amp.h"
 #include "ardour/async_midi_port.h"
+#include "ardour/audio_block_cache.h"
 #include "ardour/audio_diskstream.h"
 #include "ardour/audio_track.h"
 #include "ardour/audioengine.h"
@@ -178,6 +179,8 @@ Session::pre_engine_init (string fullpath)
 	last_rr_session_dir = session_dirs.begin();
 
 	set_history_depth (Config->get_history_depth());
+	_history.set_memory_budget ((size_t) Config->get_history_memory_budget() * 1048576);
+	AudioBlockCache::instance().set_capacity ((size_t) Config->get_audio_block_cache_size() * 1048576);
 
         /* default: assume simple stereo speaker configuration */
 
@@ -3782,6 +3785,10 @@ Session::config_changed (std::string p, bool ours)
 		setup_fpu ();
 	} else if (p == "history-depth") {
 		set_history_depth (Config->get_history_depth());
+	} else if (p == "history-memory-budget") {
+		_history.set_memory_budget ((size_t) Config->get_history_memory_budget() * 1048576);
+	} else if (p == "audio-block-cache-size") {
+		AudioBlockCache::instance().set_capacity ((size_t) Config->get_audio_block_cache_size() * 1048576);
 	} else if (p == "remote-model") {
 		/* XXX DO SOMETHING HERE TO TELL THE GUI THAT WE NEED
 		   TO SET REMOTE ID'S
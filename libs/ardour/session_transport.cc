@@ -531,6 +531,8 @@ Session::non_realtime_locate ()
 
 	_scene_changer->locate (_transport_frame);
 
+	render_automation ();
+
 	/* XXX: it would be nice to generate the new clicks here (in the non-RT thread)
 	   rather than clearing them so that the RT thread has to spend time constructing
 	   them (in Session::click).
@@ -538,6 +540,62 @@ Session::non_realtime_locate ()
 	clear_clicks ();
 }
 
+/** Make sure automation curves have values rendered for the stretch of
+ *  the timeline the transport is about to play.  Called from the butler.
+ *
+ *  Rendered values are one per frame going forwards, so they are of no
+ *  use while the transport runs backwards or at any speed other than 1.
+ */
+void
+Session::render_automation ()
+{
+	if (_transport_speed != 0 && _transport_speed != 1.0) {
+		return;
+	}
+
+	framepos_t const start = _transport_frame;
+	framecnt_t const len = automation_render_window ();
+
+	boost::shared_ptr<RouteList> rl = routes.reader();
+
+	for (RouteList::iterator i = rl->begin(); i != rl->end(); ++i) {
+		(*i)->render_automation (start, len);
+	}
+
+	g_atomic_int_inc (&_automation_rendered_seq);
+	_automation_rendered_from = start;
+	_automation_rendered_until = start + len;
+	g_atomic_int_inc (&_automation_rendered_seq);
+}
+
+/** @return true if the transport is playing forwards at normal speed and
+ *  is about to run out of what render_automation() last covered.
+ *  Called from the process thread.
+ */
+bool
+Session::automation_render_wanted () const
+{
+	if (_transport_speed != 1.0) {
+		return false;
+	}
+
+	gint const seq = g_atomic_int_get (const_cast<gint*> (&_automation_rendered_seq));
+
+	if (seq & 1) {
+		/* the butler is publishing a new range right now */
+		return false;
+	}
+
+	framepos_t const from = _automation_rendered_from;
+	framepos_t const until = _automation_rendered_until;
+
+	if (g_atomic_int_get (const_cast<gint*> (&_automation_rendered_seq)) != seq) {
+		return false;
+	}
+
+	return _transport_frame < from || _transport_frame + automation_render_window() / 2 > until;
+}
+
 #ifdef USE_TRACKS_CODE_FEATURES
 bool
 Session::select_playhead_priority_target (framepos_t& jump_to)
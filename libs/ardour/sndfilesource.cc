@@ -21,14 +21,21 @@
 #include "libardour-config.h"
 #endif
 
+#include <algorithm>
 #include <cstring>
 #include <cerrno>
 #include <climits>
 #include <cstdarg>
 #include <fcntl.h>
+#include <stdint.h>
 
 #include <sys/stat.h>
 
+#ifndef PLATFORM_WINDOWS
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #include <glib.h>
 #include "pbd/gstdio_compat.h"
 
@@ -57,11 +64,404 @@ const Source::Flag SndFileSource::default_writable_flags = Source::Flag (
 		Source::RemovableIfEmpty |
 		Source::CanRename );
 
+/** The data chunk of an uncompressed WAV, RF64 or CAF file, mapped into memory.
+ *
+ *  libsndfile remains in charge of the file: the header is only parsed
+ *  here to find where the samples start, and the mapping is only used if
+ *  what we find agrees with what libsndfile reported.
+ *
+ *  Touching a page of the mapping that is beyond the end of the file
+ *  raises SIGBUS, which would happen if some other program truncated or
+ *  rewrote the file while it is mapped. read() therefore checks the size
+ *  of the file before each read, and refuses once it has shrunk, so that
+ *  the source goes back to reading through libsndfile. This narrows the
+ *  window but cannot close it: a file truncated during a read still
+ *  crashes, where libsndfile would have returned a short read.
+ */
+class SndFileSource::Mapping {
+  public:
+	enum Encoding {
+		Int16,
+		Int24,
+		Int32,
+		Float32
+	};
+
+	static Mapping* create (std::string const & path, SF_INFO const & info);
+	~Mapping ();
+
+	bool read (Sample* dst, framepos_t start, framecnt_t cnt, uint32_t channel) const;
+
+  private:
+	Mapping () : _fd (-1), _base (0), _length (0), _data (0), _data_length (0), _channels (0), _block_align (0), _bytes (0), _encoding (Int16), _big_endian (false) {}
+
+	bool parse_wav ();
+	bool parse_caf ();
+	bool set_format (uint32_t bits, bool is_float, uint32_t channels);
+
+	template<typename Decode> void convert (Sample* dst, uint8_t const * src, framecnt_t cnt) const {
+		for (framecnt_t n = 0; n < cnt; ++n) {
+			dst[n] = Decode::sample (src);
+			src += _block_align;
+		}
+	}
+
+	int            _fd;     ///< kept open to check the file's size before reading
+	void*          _base;
+	size_t         _length;
+	uint8_t const* _data;
+	uint64_t       _data_length;
+	uint32_t       _channels;
+	uint32_t       _block_align;
+	uint32_t       _bytes;
+	Encoding       _encoding;
+	bool           _big_endian;
+};
+
+namespace {
+
+inline uint16_t le16 (uint8_t const * p) { return p[0] | (p[1] << 8); }
+inline uint32_t le32 (uint8_t const * p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t) p[3] << 24); }
+inline uint64_t le64 (uint8_t const * p) { return le32 (p) | ((uint64_t) le32 (p + 4) << 32); }
+inline uint32_t be32 (uint8_t const * p) { return ((uint32_t) p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3]; }
+inline uint64_t be64 (uint8_t const * p) { return ((uint64_t) be32 (p) << 32) | be32 (p + 4); }
+
+/* same scaling as libsndfile uses for integer to float conversion */
+
+struct DecodeInt16LE { static Sample sample (uint8_t const * p) { return (int16_t) le16 (p) * (1.f / 32768.f); } };
+struct DecodeInt16BE { static Sample sample (uint8_t const * p) { return (int16_t) (p[1] | (p[0] << 8)) * (1.f / 32768.f); } };
+struct DecodeInt24LE { static Sample sample (uint8_t const * p) { return (int32_t) ((p[0] << 8) | (p[1] << 16) | ((uint32_t) p[2] << 24)) * (1.f / 2147483648.f); } };
+struct DecodeInt24BE { static Sample sample (uint8_t const * p) { return (int32_t) ((p[2] << 8) | (p[1] << 16) | ((uint32_t) p[0] << 24)) * (1.f / 2147483648.f); } };
+struct DecodeInt32LE { static Sample sample (uint8_t const * p) { return (int32_t) le32 (p) * (1.f / 2147483648.f); } };
+struct DecodeInt32BE { static Sample sample (uint8_t const * p) { return (int32_t) be32 (p) * (1.f / 2147483648.f); } };
+struct DecodeFloatLE { static Sample sample (uint8_t const * p) { uint32_t v = le32 (p); float f; memcpy (&f, &v, sizeof (f)); return f; } };
+struct DecodeFloatBE { static Sample sample (uint8_t const * p) { uint32_t v = be32 (p); float f; memcpy (&f, &v, sizeof (f)); return f; } };
+
+}
+
+SndFileSource::Mapping*
+SndFileSource::Mapping::create (std::string const & path, SF_INFO const & info)
+{
+#ifdef PLATFORM_WINDOWS
+	return 0;
+#else
+	switch (info.format & SF_FORMAT_TYPEMASK) {
+	case SF_FORMAT_WAV:
+	case SF_FORMAT_WAVEX:
+	case SF_FORMAT_RF64:
+	case SF_FORMAT_CAF:
+		break;
+	default:
+		return 0;
+	}
+
+	switch (info.format & SF_FORMAT_SUBMASK) {
+	case SF_FORMAT_PCM_16:
+	case SF_FORMAT_PCM_24:
+	case SF_FORMAT_PCM_32:
+	case SF_FORMAT_FLOAT:
+		break;
+	default:
+		return 0;
+	}
+
+	int fd = ::open (path.c_str(), O_RDONLY);
+
+	if (fd < 0) {
+		return 0;
+	}
+
+	struct stat statbuf;
+
+	if (fstat (fd, &statbuf) != 0 || statbuf.st_size <= 0 || (uint64_t) statbuf.st_size > (uint64_t) SIZE_MAX) {
+		::close (fd);
+		return 0;
+	}
+
+	Mapping* m = new Mapping;
+
+	m->_length = statbuf.st_size;
+	m->_fd = fd;
+	m->_base = mmap (0, m->_length, PROT_READ, MAP_SHARED, fd, 0);
+
+	if (m->_base == MAP_FAILED) {
+		m->_base = 0;
+		delete m;
+		return 0;
+	}
+
+	bool ok;
+
+	if ((info.format & SF_FORMAT_TYPEMASK) == SF_FORMAT_CAF) {
+		ok = m->parse_caf ();
+	} else {
+		ok = m->parse_wav ();
+	}
+
+	/* cross-check against libsndfile */
+
+	if (ok) {
+		ok = m->_channels == (uint32_t) info.channels
+			&& m->_data_length / m->_block_align >= (uint64_t) info.frames
+			&& (uint64_t) (m->_data - (uint8_t const *) m->_base) + (uint64_t) info.frames * m->_block_align <= m->_length;
+	}
+
+	if (!ok) {
+		delete m;
+		return 0;
+	}
+
+	/* playback reads run forwards through the file */
+	madvise (m->_base, m->_length, MADV_SEQUENTIAL);
+
+	return m;
+#endif
+}
+
+SndFileSource::Mapping::~Mapping ()
+{
+#ifndef PLATFORM_WINDOWS
+	if (_base) {
+		munmap (_base, _length);
+	}
+	if (_fd >= 0) {
+		::close (_fd);
+	}
+#endif
+}
+
+bool
+SndFileSource::Mapping::set_format (uint32_t bits, bool is_float, uint32_t channels)
+{
+	if (is_float) {
+		if (bits != 32) {
+			return false;
+		}
+		_encoding = Float32;
+	} else {
+		switch (bits) {
+		case 16:
+			_encoding = Int16;
+			break;
+		case 24:
+			_encoding = Int24;
+			break;
+		case 32:
+			_encoding = Int32;
+			break;
+		default:
+			return false;
+		}
+	}
+
+	_channels = channels;
+	_bytes = bits / 8;
+	_block_align = _bytes * channels;
+
+	return _block_align > 0;
+}
+
+bool
+SndFileSource::Mapping::parse_wav ()
+{
+	uint8_t const * const base = (uint8_t const *) _base;
+	uint8_t const * const end = base + _length;
+
+	if (_length < 12 || memcmp (base + 8, "WAVE", 4)) {
+		return false;
+	}
+
+	bool const rf64 = !memcmp (base, "RF64", 4);
+
+	if (!rf64 && memcmp (base, "RIFF", 4)) {
+		return false;
+	}
+
+	uint64_t ds64_data_length = 0;
+	bool have_fmt = false;
+	uint8_t const * p = base + 12;
+
+	while (end - p >= 8) {
+
+		uint64_t size = le32 (p + 4);
+		uint8_t const * const body = p + 8;
+
+		if (!memcmp (p, "ds64", 4) && size >= 16 && end - body >= 16) {
+			ds64_data_length = le64 (body + 8);
+		} else if (!memcmp (p, "fmt ", 4) && size >= 16 && end - body >= 16) {
+			uint32_t tag = le16 (body);
+			uint32_t const channels = le16 (body + 2);
+			uint32_t const block_align = le16 (body + 12);
+			uint32_t const bits = le16 (body + 14);
+
+			if (tag == 0xfffe) {
+				/* WAVE_FORMAT_EXTENSIBLE: the real tag starts the sub-format GUID */
+				if (size < 40 || end - body < 40) {
+					return false;
+				}
+				tag = le16 (body + 24);
+			}
+
+			if ((tag != 1 && tag != 3) || !set_format (bits, tag == 3, channels) || block_align != _block_align) {
+				return false;
+			}
+
+			have_fmt = true;
+
+		} else if (!memcmp (p, "data", 4)) {
+			if (!have_fmt) {
+				return false;
+			}
+			if (rf64 && size == 0xffffffff) {
+				size = ds64_data_length;
+			}
+			_data = body;
+			_data_length = std::min (size, (uint64_t) (end - body));
+			_big_endian = false;
+			return true;
+		}
+
+		/* chunks are padded to an even length */
+		size += size & 1;
+
+		if (size > (uint64_t) (end - body)) {
+			break;
+		}
+
+		p = body + size;
+	}
+
+	return false;
+}
+
+bool
+SndFileSource::Mapping::parse_caf ()
+{
+	uint8_t const * const base = (uint8_t const *) _base;
+	uint8_t const * const end = base + _length;
+
+	if (_length < 8 || memcmp (base, "caff", 4)) {
+		return false;
+	}
+
+	bool have_desc = false;
+	uint8_t const * p = base + 8;
+
+	while (end - p >= 12) {
+
+		int64_t size = (int64_t) be64 (p + 4);
+		uint8_t const * const body = p + 12;
+
+		if (!memcmp (p, "desc", 4) && size >= 32 && end - body >= 32) {
+			uint32_t const flags = be32 (body + 12);
+			uint32_t const bytes_per_packet = be32 (body + 16);
+			uint32_t const frames_per_packet = be32 (body + 20);
+			uint32_t const channels = be32 (body + 24);
+			uint32_t const bits = be32 (body + 28);
+
+			if (memcmp (body + 8, "lpcm", 4) || frames_per_packet != 1 || !set_format (bits, flags & 1, channels) || bytes_per_packet != _block_align) {
+				return false;
+			}
+
+			_big_endian = !(flags & 2);
+			have_desc = true;
+
+		} else if (!memcmp (p, "data", 4)) {
+			if (!have_desc || end - body < 4) {
+				return false;
+			}
+			/* the data chunk starts with an edit count; a size of -1
+			 * means the data runs to the end of the file
+			 */
+			_data = body + 4;
+			if (size < 0 || size - 4 > end - _data) {
+				_data_length = end - _data;
+			} else {
+				_data_length = size - 4;
+			}
+			return true;
+		}
+
+		if (size < 0 || size > end - body) {
+			break;
+		}
+
+		p = body + size;
+	}
+
+	return false;
+}
+
+/** @return false, having read nothing, if the file is now shorter than the mapping */
+bool
+SndFileSource::Mapping::read (Sample* dst, framepos_t start, framecnt_t cnt, uint32_t channel) const
+{
+	uint8_t const * src = _data + (uint64_t) start * _block_align + channel * _bytes;
+
+#ifndef PLATFORM_WINDOWS
+	{
+		struct stat statbuf;
+
+		if (fstat (_fd, &statbuf) != 0 || (uint64_t) statbuf.st_size < (uint64_t) _length) {
+			return false;
+		}
+	}
+
+	/* ask the kernel to start reading what the next refill will want */
+	{
+		static const uintptr_t page_mask = ~((uintptr_t) sysconf (_SC_PAGESIZE) - 1);
+		uint8_t const * const ahead = src + (uint64_t) cnt * _block_align;
+		uint8_t const * const ahead_end = std::min (ahead + (uint64_t) cnt * _block_align, _data + _data_length);
+		if (ahead < ahead_end) {
+			uint8_t* const page = (uint8_t*) ((uintptr_t) ahead & page_mask);
+			madvise (page, ahead_end - page, MADV_WILLNEED);
+		}
+	}
+#endif
+
+	switch (_encoding) {
+	case Int16:
+		if (_big_endian) {
+			convert<DecodeInt16BE> (dst, src, cnt);
+		} else {
+			convert<DecodeInt16LE> (dst, src, cnt);
+		}
+		break;
+	case Int24:
+		if (_big_endian) {
+			convert<DecodeInt24BE> (dst, src, cnt);
+		} else {
+			convert<DecodeInt24LE> (dst, src, cnt);
+		}
+		break;
+	case Int32:
+		if (_big_endian) {
+			convert<DecodeInt32BE> (dst, src, cnt);
+		} else {
+			convert<DecodeInt32LE> (dst, src, cnt);
+		}
+		break;
+	case Float32:
+		if (_big_endian) {
+			convert<DecodeFloatBE> (dst, src, cnt);
+		} else if (_channels == 1 && G_BYTE_ORDER == G_LITTLE_ENDIAN) {
+			memcpy (dst, src, sizeof (Sample) * cnt);
+		} else {
+			convert<DecodeFloatLE> (dst, src, cnt);
+		}
+		break;
+	}
+
+	return true;
+}
+
 SndFileSource::SndFileSource (Session& s, const XMLNode& node)
 	: Source(s, node)
 	, AudioFileSource (s, node)
 	, _sndfile (0)
 	, _broadcast_info (0)
+	, _mapping (0)
+	, _mapping_checked (false)
 	, _capture_start (false)
 	, _capture_end (false)
 	, file_pos (0)
@@ -86,6 +486,8 @@ SndFileSource::SndFileSource (Session& s, const string& path, int chn, Flag flag
 	, AudioFileSource (s, path, Flag (flags & ~(Writable|Removable|RemovableIfEmpty|RemoveAtDestroy)))
 	, _sndfile (0)
 	, _broadcast_info (0)
+	, _mapping (0)
+	, _mapping_checked (false)
 	, _capture_start (false)
 	, _capture_end (false)
 	, file_pos (0)
@@ -112,6 +514,8 @@ SndFileSource::SndFileSource (Session& s, const string& path, const string& orig
 	, AudioFileSource (s, path, origin, flags, sfmt, hf)
 	, _sndfile (0)
 	, _broadcast_info (0)
+	, _mapping (0)
+	, _mapping_checked (false)
 	, _capture_start (false)
 	, _capture_end (false)
 	, file_pos (0)
@@ -215,6 +619,8 @@ SndFileSource::SndFileSource (Session& s, const string& path, int chn)
 	, AudioFileSource (s, path, Flag (0))
 	, _sndfile (0)
 	, _broadcast_info (0)
+	, _mapping (0)
+	, _mapping_checked (false)
 	, _capture_start (false)
 	, _capture_end (false)
 	, file_pos (0)
@@ -252,12 +658,37 @@ SndFileSource::init_sndfile ()
 void
 SndFileSource::close ()
 {
+	unmap_data ();
+
 	if (_sndfile) {
 		sf_close (_sndfile);
 		_sndfile = 0;
 	}
 }
 
+/** Map the file's sample data for reading, if the file is suited to it.
+ *  Only done once per open, and only for files that can no longer change.
+ *  @return true if reads can be served from the mapping.
+ */
+bool
+SndFileSource::map_data () const
+{
+	if (!_mapping_checked && !writable() && _sndfile) {
+		_mapping_checked = true;
+		_mapping = Mapping::create (_path, _info);
+	}
+
+	return _mapping != 0;
+}
+
+void
+SndFileSource::unmap_data ()
+{
+	delete _mapping;
+	_mapping = 0;
+	_mapping_checked = false;
+}
+
 int
 SndFileSource::open ()
 {
@@ -444,6 +875,15 @@ SndFileSource::read_unlocked (Sample *dst, framepos_t start, framecnt_t cnt) con
 		memset (dst+file_cnt, 0, sizeof (Sample) * delta);
 	}
 
+	if (file_cnt && map_data ()) {
+		if (_mapping->read (dst, start, file_cnt, _channel)) {
+			return file_cnt;
+		}
+		/* the file changed under us; leave it to libsndfile from now on */
+		delete _mapping;
+		_mapping = 0;
+	}
+
 	if (file_cnt) {
 
 		if (sf_seek (_sndfile, (sf_count_t) start, SEEK_SET|SFM_READ) != (sf_count_t) start) {
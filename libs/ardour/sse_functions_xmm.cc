@@ -117,3 +117,124 @@ x86_sse_find_peaks(const ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float *
 
 
 
+
+void
+x86_sse_mix_buffers_with_gain_vector (float * dst, const float * src, uint32_t nframes, const float * gain)
+{
+	uint32_t i = 0;
+
+	// buffers are not necessarily aligned alike, so use unaligned access
+	for (; i + 4 <= nframes; i += 4) {
+		__m128 work = _mm_mul_ps (_mm_loadu_ps (src + i), _mm_loadu_ps (gain + i));
+		_mm_storeu_ps (dst + i, _mm_add_ps (_mm_loadu_ps (dst + i), work));
+	}
+
+	for (; i < nframes; ++i) {
+		dst[i] += src[i] * gain[i];
+	}
+}
+
+/* Mix src[from..to) into N outputs at once, so that each block of source
+ * samples is loaded only once. gain[o] is the gain at frame "from", and it
+ * changes by delta[o] per frame.
+ */
+template<uint32_t N> static void
+mix_to_outputs (float * const * dst, const float * src, uint32_t from, uint32_t to, const float * gain, const float * delta)
+{
+	__m128 g[N];
+	__m128 step[N];
+
+	for (uint32_t o = 0; o < N; ++o) {
+		g[o] = _mm_add_ps (_mm_set1_ps (gain[o]), _mm_mul_ps (_mm_set1_ps (delta[o]), _mm_set_ps (3.f, 2.f, 1.f, 0.f)));
+		step[o] = _mm_set1_ps (4.f * delta[o]);
+	}
+
+	uint32_t i = from;
+
+	for (; i + 4 <= to; i += 4) {
+		__m128 const s = _mm_loadu_ps (src + i);
+		for (uint32_t o = 0; o < N; ++o) {
+			float* const d = dst[o] + i;
+			_mm_storeu_ps (d, _mm_add_ps (_mm_loadu_ps (d), _mm_mul_ps (s, g[o])));
+			g[o] = _mm_add_ps (g[o], step[o]);
+		}
+	}
+
+	for (uint32_t o = 0; o < N; ++o) {
+		for (uint32_t j = i; j < to; ++j) {
+			dst[o][j] += src[j] * (gain[o] + (j - from) * delta[o]);
+		}
+	}
+}
+
+static void
+mix_to_outputs (uint32_t n, float * const * dst, const float * src, uint32_t from, uint32_t to, const float * gain, const float * delta)
+{
+	switch (n) {
+	case 1: mix_to_outputs<1> (dst, src, from, to, gain, delta); break;
+	case 2: mix_to_outputs<2> (dst, src, from, to, gain, delta); break;
+	case 3: mix_to_outputs<3> (dst, src, from, to, gain, delta); break;
+	case 4: mix_to_outputs<4> (dst, src, from, to, gain, delta); break;
+	default: break;
+	}
+}
+
+static void
+flush_outputs (uint32_t n, float * const * dst, const float * src, uint32_t nframes,
+               const float * gain, const float * delta, const float * target, uint32_t ramp)
+{
+	static const float none[4] = { 0, 0, 0, 0 };
+	uint32_t from = 0;
+
+	for (uint32_t o = 0; o < n; ++o) {
+		if (delta[o] != 0) {
+			mix_to_outputs (n, dst, src, 0, ramp, gain, delta);
+			from = ramp;
+			break;
+		}
+	}
+
+	mix_to_outputs (n, dst, src, from, nframes, target, none);
+}
+
+void
+x86_sse_mix_buffer_to_outputs (float * const * dst, uint32_t n_outputs, const float * src, uint32_t nframes,
+                               const float * initial, const float * target, uint32_t ramp)
+{
+	/* work through the outputs in groups of up to 4, so that the
+	   gains of a group stay in registers
+	*/
+
+	float* group[4];
+	float gain[4];
+	float delta[4];
+	float final[4];
+	uint32_t n = 0;
+
+	for (uint32_t o = 0; o < n_outputs; ++o) {
+
+		if (initial[o] == 0 && target[o] == 0) {
+			continue;
+		}
+
+		group[n] = dst[o];
+		final[n] = target[o];
+
+		if (ramp && initial[o] != target[o]) {
+			gain[n] = initial[o];
+			delta[n] = (target[o] - initial[o]) / ramp;
+		} else {
+			gain[n] = target[o];
+			delta[n] = 0;
+		}
+
+		if (++n == 4) {
+			flush_outputs (n, group, src, nframes, gain, delta, final, ramp);
+			n = 0;
+		}
+	}
+
+	if (n) {
+		flush_outputs (n, group, src, nframes, gain, delta, final, ramp);
+	}
+}
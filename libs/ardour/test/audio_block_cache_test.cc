@@ -0,0 +1,128 @@
+#include <vector>
+
+#include "ardour/audio_block_cache.h"
+
+#include "audio_block_cache_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (AudioBlockCacheTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+/* the cache only compares source pointers, so these never need to exist */
+static AudioSource const * const source_a = reinterpret_cast<AudioSource const *> (0x1000);
+static AudioSource const * const source_b = reinterpret_cast<AudioSource const *> (0x2000);
+
+static size_t const block_bytes = AudioBlockCache::block_frames * sizeof (Sample);
+
+static void
+insert_block (AudioSource const * src, framepos_t block, framecnt_t valid)
+{
+	vector<Sample> data (AudioBlockCache::block_frames);
+
+	for (framecnt_t n = 0; n < valid; ++n) {
+		data[n] = block + n;
+	}
+
+	AudioBlockCache::instance().insert (src, block, data, valid);
+	CPPUNIT_ASSERT (data.empty ());
+}
+
+void
+AudioBlockCacheTest::setUp ()
+{
+	AudioBlockCache::instance().clear ();
+	AudioBlockCache::instance().reset_stats ();
+	AudioBlockCache::instance().set_capacity (64 * block_bytes);
+}
+
+void
+AudioBlockCacheTest::tearDown ()
+{
+	AudioBlockCache::instance().clear ();
+}
+
+void
+AudioBlockCacheTest::lookupTest ()
+{
+	AudioBlockCache& cache (AudioBlockCache::instance());
+	Sample buf[8];
+	framecnt_t valid;
+
+	CPPUNIT_ASSERT (!cache.lookup (source_a, 3, 0, 8, buf, valid));
+
+	insert_block (source_a, 3, 100);
+
+	CPPUNIT_ASSERT (cache.lookup (source_a, 3, 10, 8, buf, valid));
+	CPPUNIT_ASSERT_EQUAL ((framecnt_t) 8, valid);
+	CPPUNIT_ASSERT_EQUAL ((Sample) 13, buf[0]);
+	CPPUNIT_ASSERT_EQUAL ((Sample) 20, buf[7]);
+
+	/* reading across the end of the file data zero-fills */
+	CPPUNIT_ASSERT (cache.lookup (source_a, 3, 96, 8, buf, valid));
+	CPPUNIT_ASSERT_EQUAL ((framecnt_t) 4, valid);
+	CPPUNIT_ASSERT_EQUAL ((Sample) 102, buf[3]);
+	CPPUNIT_ASSERT_EQUAL ((Sample) 0, buf[4]);
+
+	/* same block number of another source */
+	CPPUNIT_ASSERT (!cache.lookup (source_b, 3, 0, 8, buf, valid));
+
+	AudioBlockCache::Stats s = cache.stats ();
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 2, s.hits);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 2, s.misses);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1, s.blocks);
+	CPPUNIT_ASSERT_EQUAL (block_bytes, s.bytes);
+}
+
+void
+AudioBlockCacheTest::evictionTest ()
+{
+	AudioBlockCache& cache (AudioBlockCache::instance());
+	Sample buf[1];
+	framecnt_t valid;
+
+	/* with 16 shards, every 16th block of a source lands in the same
+	 * shard, which has room for 4 blocks
+	 */
+	for (framepos_t b = 0; b < 16 * 4; b += 16) {
+		insert_block (source_a, b, AudioBlockCache::block_frames);
+	}
+
+	/* touch block 0 so that 16 and 32 are the least recently used */
+	CPPUNIT_ASSERT (cache.lookup (source_a, 0, 0, 1, buf, valid));
+
+	insert_block (source_a, 16 * 4, AudioBlockCache::block_frames);
+	insert_block (source_a, 16 * 5, AudioBlockCache::block_frames);
+
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 2, cache.stats().evictions);
+	CPPUNIT_ASSERT (cache.lookup (source_a, 0, 0, 1, buf, valid));
+	CPPUNIT_ASSERT (!cache.lookup (source_a, 16, 0, 1, buf, valid));
+	CPPUNIT_ASSERT (!cache.lookup (source_a, 32, 0, 1, buf, valid));
+	CPPUNIT_ASSERT (cache.lookup (source_a, 48, 0, 1, buf, valid));
+	CPPUNIT_ASSERT (cache.lookup (source_a, 80, 0, 1, buf, valid));
+
+	cache.set_capacity (0);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 0, cache.stats().blocks);
+}
+
+void
+AudioBlockCacheTest::dropTest ()
+{
+	AudioBlockCache& cache (AudioBlockCache::instance());
+	Sample buf[1];
+	framecnt_t valid;
+
+	for (framepos_t b = 0; b < 20; ++b) {
+		insert_block (source_a, b, 10);
+		insert_block (source_b, b, 10);
+	}
+
+	cache.drop (source_a);
+
+	for (framepos_t b = 0; b < 20; ++b) {
+		CPPUNIT_ASSERT (!cache.lookup (source_a, b, 0, 1, buf, valid));
+		CPPUNIT_ASSERT (cache.lookup (source_b, b, 0, 1, buf, valid));
+	}
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 20, cache.stats().blocks);
+}
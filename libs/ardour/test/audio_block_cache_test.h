@@ -0,0 +1,19 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class AudioBlockCacheTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (AudioBlockCacheTest);
+	CPPUNIT_TEST (lookupTest);
+	CPPUNIT_TEST (evictionTest);
+	CPPUNIT_TEST (dropTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void lookupTest ();
+	void evictionTest ();
+	void dropTest ();
+};
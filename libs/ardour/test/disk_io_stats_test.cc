@@ -0,0 +1,127 @@
+#include "ardour/disk_io_stats.h"
+
+#include "disk_io_stats_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (DiskIOStatsTest);
+
+using namespace ARDOUR;
+
+void
+DiskIOStatsTest::binTest ()
+{
+	/* refill latency: [2^n, 2^(n+1)) usecs, the last bin open-ended */
+	CPPUNIT_ASSERT_EQUAL (0, DiskIOStats::latency_bin (0));
+	CPPUNIT_ASSERT_EQUAL (0, DiskIOStats::latency_bin (1));
+	CPPUNIT_ASSERT_EQUAL (1, DiskIOStats::latency_bin (2));
+	CPPUNIT_ASSERT_EQUAL (1, DiskIOStats::latency_bin (3));
+	CPPUNIT_ASSERT_EQUAL (10, DiskIOStats::latency_bin (1024));
+	CPPUNIT_ASSERT_EQUAL (10, DiskIOStats::latency_bin (2047));
+	CPPUNIT_ASSERT_EQUAL (DiskIOStats::latency_bins - 1, DiskIOStats::latency_bin (1 << 20));
+
+	/* buffer fill: 10% steps, out of range values clamped */
+	CPPUNIT_ASSERT_EQUAL (0, DiskIOStats::fill_bin (-0.5));
+	CPPUNIT_ASSERT_EQUAL (0, DiskIOStats::fill_bin (0.05));
+	CPPUNIT_ASSERT_EQUAL (5, DiskIOStats::fill_bin (0.55));
+	CPPUNIT_ASSERT_EQUAL (DiskIOStats::fill_bins - 1, DiskIOStats::fill_bin (1.0));
+	CPPUNIT_ASSERT_EQUAL (DiskIOStats::fill_bins - 1, DiskIOStats::fill_bin (2.0));
+
+	DiskIOStats stats;
+
+	stats.playback_fill (0.25);
+	stats.playback_fill (0.29);
+	stats.capture_fill (0.95);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 2, stats.playback_fill_histogram (2));
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 1, stats.capture_fill_histogram (9));
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 0, stats.capture_fill_histogram (2));
+
+	stats.refill_started ();
+	stats.refill_done (4096, 2);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 1, stats.refills ());
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 4096, stats.bytes_read ());
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 2, stats.reads ());
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 1, stats.refill_histogram (DiskIOStats::latency_bin (stats.refill_max ())));
+}
+
+void
+DiskIOStatsTest::underrunRingTest ()
+{
+	DiskIOStats stats;
+
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 0, stats.n_underruns ());
+
+	const uint32_t n = DiskIOStats::max_underruns + 8;
+
+	for (uint32_t i = 0; i < n; ++i) {
+		stats.underrun (i * 100, 64, i, false);
+	}
+
+	CPPUNIT_ASSERT_EQUAL (n, stats.n_underruns ());
+
+	/* most recent first, the oldest ones overwritten */
+	CPPUNIT_ASSERT_EQUAL ((framepos_t) (n - 1) * 100, stats.underrun_record (0).position);
+	CPPUNIT_ASSERT_EQUAL ((framecnt_t) (n - 1), stats.underrun_record (0).available);
+	CPPUNIT_ASSERT_EQUAL ((framecnt_t) 64, stats.underrun_record (0).needed);
+	CPPUNIT_ASSERT_EQUAL ((framepos_t) (n - 2) * 100, stats.underrun_record (1).position);
+	CPPUNIT_ASSERT_EQUAL ((framepos_t) 8 * 100, stats.underrun_record (DiskIOStats::max_underruns - 1).position);
+}
+
+void
+DiskIOStatsTest::causeTest ()
+{
+	DiskIOStats stats;
+
+	/* never refilled */
+	stats.underrun (0, 64, 0, false);
+	CPPUNIT_ASSERT_EQUAL (DiskIOStats::ButlerStarved, stats.underrun_record (0).cause);
+	CPPUNIT_ASSERT_EQUAL ((gint64) -1, stats.underrun_record (0).idle);
+
+	/* the butler is reading for this stream right now */
+	stats.refill_started ();
+	stats.underrun (64, 64, 0, false);
+	CPPUNIT_ASSERT_EQUAL (DiskIOStats::DiskSlow, stats.underrun_record (0).cause);
+
+	/* pending transport work wins */
+	stats.underrun (128, 64, 0, true);
+	CPPUNIT_ASSERT_EQUAL (DiskIOStats::TransportWork, stats.underrun_record (0).cause);
+
+	/* refilled, but not again since */
+	stats.refill_done (0, 0);
+	stats.underrun (192, 64, 0, false);
+	CPPUNIT_ASSERT_EQUAL (DiskIOStats::ButlerStarved, stats.underrun_record (0).cause);
+	CPPUNIT_ASSERT (stats.underrun_record (0).idle >= 0);
+}
+
+void
+DiskIOStatsTest::resetTest ()
+{
+	DiskIOStats stats;
+
+	stats.refill_started ();
+	stats.refill_done (100, 1);
+	stats.playback_fill (0.5);
+	stats.underrun (0, 64, 0, false);
+
+	/* a refill is in progress when the reset is asked for */
+	stats.refill_started ();
+	stats.reset ();
+
+	/* nothing cleared yet, but it all reads as zero */
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 0, stats.refills ());
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 0, stats.playback_fill_histogram (5));
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 0, stats.n_underruns ());
+
+	/* the refill under way is still known about */
+	stats.underrun (64, 64, 0, false);
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 1, stats.n_underruns ());
+	CPPUNIT_ASSERT_EQUAL (DiskIOStats::DiskSlow, stats.underrun_record (0).cause);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 0, stats.playback_fill_histogram (5));
+
+	stats.refill_done (100, 1);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 0, stats.refills ());
+
+	/* the next refill clears the butler's side */
+	stats.refill_started ();
+	stats.refill_done (50, 1);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 1, stats.refills ());
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 50, stats.bytes_read ());
+}
@@ -0,0 +1,18 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class DiskIOStatsTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (DiskIOStatsTest);
+	CPPUNIT_TEST (binTest);
+	CPPUNIT_TEST (underrunRingTest);
+	CPPUNIT_TEST (causeTest);
+	CPPUNIT_TEST (resetTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void binTest ();
+	void underrunRingTest ();
+	void causeTest ();
+	void resetTest ();
+};
@@ -0,0 +1,60 @@
+#include "ardour/dsp_timing.h"
+
+#include "dsp_timing_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (DSPTimingTest);
+
+using namespace ARDOUR;
+
+void
+DSPTimingTest::windowTest ()
+{
+	DSPTiming timing (4);
+	DSPTiming::Stats stats;
+
+	/* nothing is published until the first window is complete */
+	timing.update (10);
+	timing.update (20);
+	timing.update (30);
+	CPPUNIT_ASSERT (!timing.get_stats (stats));
+
+	timing.update (40);
+	CPPUNIT_ASSERT (timing.get_stats (stats));
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 10, stats.min);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 40, stats.max);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (25.0, stats.avg, 1e-9);
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 4, stats.count);
+
+	/* the previous window stays visible while the next one is collected */
+	timing.update (100);
+	CPPUNIT_ASSERT (timing.get_stats (stats));
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 40, stats.max);
+
+	timing.update (100);
+	timing.update (100);
+	timing.update (100);
+	CPPUNIT_ASSERT (timing.get_stats (stats));
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 100, stats.min);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (100.0, stats.avg, 1e-9);
+}
+
+void
+DSPTimingTest::resetTest ()
+{
+	DSPTiming timing (2);
+	DSPTiming::Stats stats;
+
+	timing.update (5);
+	timing.update (7);
+	CPPUNIT_ASSERT (timing.get_stats (stats));
+
+	/* reset is applied by the next update from the process thread */
+	timing.reset ();
+	timing.update (1000);
+	CPPUNIT_ASSERT (!timing.get_stats (stats));
+
+	timing.update (2000);
+	CPPUNIT_ASSERT (timing.get_stats (stats));
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 1000, stats.min);
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 2000, stats.max);
+}
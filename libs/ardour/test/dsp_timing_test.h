@@ -0,0 +1,14 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class DSPTimingTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (DSPTimingTest);
+	CPPUNIT_TEST (windowTest);
+	CPPUNIT_TEST (resetTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void windowTest ();
+	void resetTest ();
+};
@@ -170,3 +170,52 @@ InterpolationTest::cubicInterpolationTest ()
 		CPPUNIT_ASSERT_EQUAL (1.0f, output[i]);
 	}
 }
+
+void
+InterpolationTest::polyphaseInterpolationTest ()
+{
+	double const speeds[] = { 0.02, 0.5, 0.97, 1.5, 3.7 };
+
+	/* a DC signal on one channel and a slow sine on the other */
+	for (int i = 0; i < NUM_SAMPLES; ++i) {
+		input[i] = 1.0f;
+		output[i] = sinf (2.0 * M_PI * i / 200.0);
+	}
+
+	for (size_t n = 0; n < sizeof (speeds) / sizeof (speeds[0]); ++n) {
+
+		PolyphaseInterpolation polyphase;
+		polyphase.add_channel_to (NUM_SAMPLES, NUM_SAMPLES);
+		polyphase.add_channel_to (NUM_SAMPLES, NUM_SAMPLES);
+		polyphase.set_speed (speeds[n]);
+
+		Sample dc[1024];
+		Sample sine[1024];
+		framecnt_t pos = 0;
+		framecnt_t out = 0;
+
+		for (int cycle = 0; cycle < 16 && pos + 1024 * speeds[n] + PolyphaseInterpolation::lookahead < NUM_SAMPLES; ++cycle) {
+
+			/* silent roll must advance exactly as far as real playback */
+			framecnt_t const expected = polyphase.distance (1024);
+
+			polyphase.set_buffers (0, input + pos, dc);
+			polyphase.set_buffers (1, output + pos, sine);
+			framecnt_t const result = polyphase.interpolate (1024);
+			CPPUNIT_ASSERT_EQUAL (expected, result);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL ((out + 1024) * speeds[n], (double) (pos + result), 1.0);
+
+			/* skip the first cycle, which starts from silent history */
+			if (cycle > 0) {
+				for (int i = 0; i < 1024; ++i) {
+					CPPUNIT_ASSERT_DOUBLES_EQUAL (1.0, dc[i], 1e-4);
+					double const t = (out + i) * speeds[n];
+					CPPUNIT_ASSERT_DOUBLES_EQUAL (sin (2.0 * M_PI * t / 200.0), sine[i], 1e-2);
+				}
+			}
+
+			pos += result;
+			out += 1024;
+		}
+	}
+}
@@ -27,6 +27,7 @@ class InterpolationTest : public CppUnit::TestFixture
 	CPPUNIT_TEST_SUITE(InterpolationTest);
 	CPPUNIT_TEST(cubicInterpolationTest);
 	CPPUNIT_TEST(linearInterpolationTest);
+	CPPUNIT_TEST(polyphaseInterpolationTest);
 	CPPUNIT_TEST_SUITE_END();
 
 #define NUM_SAMPLES 1000000
@@ -58,4 +59,5 @@ class InterpolationTest : public CppUnit::TestFixture
 
 	void linearInterpolationTest();
 	void cubicInterpolationTest();
+	void polyphaseInterpolationTest();
 };
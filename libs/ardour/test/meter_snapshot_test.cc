@@ -0,0 +1,161 @@
+#include <limits>
+
+#include "ardour/dB.h"
+
+#include "ardour/meter_snapshot.h"
+
+#include "meter_snapshot_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MeterSnapshotTest);
+
+using namespace ARDOUR;
+
+static bool
+silent (float dB)
+{
+	return dB == -std::numeric_limits<float>::infinity();
+}
+
+static void
+write_peak (MeterSnapshot& snap, uint32_t slot, uint32_t chn, float dB)
+{
+	float* d = snap.back (slot);
+	CPPUNIT_ASSERT (d);
+	d[MeterSnapshot::NHeader + chn * MeterSnapshot::NFields + MeterSnapshot::Peak] = dB;
+}
+
+void
+MeterSnapshotTest::publishTest ()
+{
+	MeterSnapshot snap;
+	MeterSnapshot::View view;
+
+	uint32_t const a = snap.allocate (2);
+	uint32_t const b = snap.allocate (1);
+
+	/* nothing published yet */
+	view.update (snap);
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 2, view.n_channels (a));
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 1, view.n_channels (b));
+	CPPUNIT_ASSERT (silent (view.level (a, 0, MeterPeak)));
+
+	/* 64 frames per cycle, publish every 128 */
+	snap.cycle_done (64, 128);
+	CPPUNIT_ASSERT (!snap.writing ());
+	snap.cycle_done (64, 128);
+	CPPUNIT_ASSERT (snap.writing ());
+
+	write_peak (snap, a, 1, -6.0f);
+	write_peak (snap, b, 0, -12.0f);
+
+	/* not visible until published */
+	CPPUNIT_ASSERT (!view.update (snap));
+	CPPUNIT_ASSERT (silent (view.level (a, 1, MeterPeak)));
+
+	snap.cycle_done (64, 128);
+	CPPUNIT_ASSERT (!snap.writing ());
+
+	CPPUNIT_ASSERT (view.update (snap));
+	CPPUNIT_ASSERT_EQUAL (-6.0f, view.level (a, 1, MeterPeak));
+	CPPUNIT_ASSERT_EQUAL (-12.0f, view.level (b, 0, MeterPeak));
+
+	/* nothing new */
+	CPPUNIT_ASSERT (!view.update (snap));
+
+	/* out of range */
+	CPPUNIT_ASSERT (silent (view.level (b, 1, MeterPeak)));
+	CPPUNIT_ASSERT (silent (view.level (7, 0, MeterPeak)));
+}
+
+void
+MeterSnapshotTest::carryOverTest ()
+{
+	MeterSnapshot snap;
+	MeterSnapshot::View view;
+
+	uint32_t const a = snap.allocate (1);
+	uint32_t const b = snap.allocate (1);
+
+	snap.cycle_done (128, 128);
+	write_peak (snap, a, 0, -3.0f);
+	write_peak (snap, b, 0, -9.0f);
+	snap.cycle_done (128, 128);
+
+	/* only a runs in the next published cycle: b keeps its value */
+	write_peak (snap, a, 0, -4.0f);
+	snap.cycle_done (128, 128);
+
+	CPPUNIT_ASSERT (view.update (snap));
+	CPPUNIT_ASSERT_EQUAL (-4.0f, view.level (a, 0, MeterPeak));
+	CPPUNIT_ASSERT_EQUAL (-9.0f, view.level (b, 0, MeterPeak));
+}
+
+void
+MeterSnapshotTest::slotTest ()
+{
+	MeterSnapshot snap;
+	MeterSnapshot::View view;
+
+	uint32_t const a = snap.allocate (4);
+	uint32_t const b = snap.allocate (2);
+
+	/* shrinking stays in place */
+	CPPUNIT_ASSERT_EQUAL (a, snap.reallocate (a, 2));
+
+	/* growing beyond capacity moves */
+	uint32_t const c = snap.reallocate (b, 8);
+	CPPUNIT_ASSERT (c != b);
+
+	/* released slots are re-used */
+	snap.release (a);
+	CPPUNIT_ASSERT_EQUAL (a, snap.allocate (3));
+
+	/* views see layout changes without anything being published */
+	view.update (snap);
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 3, view.n_channels (a));
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 0, view.n_channels (b));
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 8, view.n_channels (c));
+
+	snap.release (c);
+	view.update (snap);
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 0, view.n_channels (c));
+}
+
+void
+MeterSnapshotTest::heldPeakTest ()
+{
+	MeterSnapshot snap;
+	MeterSnapshot::View view;
+
+	uint32_t const a = snap.allocate (2);
+
+	/* the first read asks for held peaks to be collected */
+	view.update (snap);
+	CPPUNIT_ASSERT (silent (view.level (a, 0, MeterMCP)));
+
+	/* a peak in one cycle, silence in the ones after it */
+	snap.cycle_done (128, 128);
+	snap.hold_peak (a, 0.25f);
+	snap.cycle_done (128, 128);
+	snap.hold_peak (a, 0.0f);
+	snap.cycle_done (128, 128);
+	snap.hold_peak (a, 0.0f);
+	snap.cycle_done (128, 128);
+
+	/* still reported at the next poll */
+	view.update (snap);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (accurate_coefficient_to_dB (0.25f), view.level (a, 0, MeterMCP), 1e-5);
+
+	/* and cleared by reading it */
+	CPPUNIT_ASSERT (silent (view.level (a, 0, MeterMCP)));
+	view.update (snap);
+	CPPUNIT_ASSERT (silent (view.level (a, 0, MeterMCP)));
+
+	/* the highest of several peaks between two polls */
+	snap.hold_peak (a, 0.5f);
+	snap.cycle_done (128, 128);
+	snap.hold_peak (a, 0.125f);
+	snap.cycle_done (128, 128);
+	view.update (snap);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (accurate_coefficient_to_dB (0.5f), view.level (a, 0, MeterMCP), 1e-5);
+}
@@ -0,0 +1,18 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MeterSnapshotTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (MeterSnapshotTest);
+	CPPUNIT_TEST (publishTest);
+	CPPUNIT_TEST (carryOverTest);
+	CPPUNIT_TEST (slotTest);
+	CPPUNIT_TEST (heldPeakTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void publishTest ();
+	void carryOverTest ();
+	void slotTest ();
+	void heldPeakTest ();
+};
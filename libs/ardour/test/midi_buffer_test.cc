@@ -0,0 +1,156 @@
+#include <cstring>
+
+#include <glib.h>
+
+#include "ardour/midi_buffer.h"
+
+#include "midi_buffer_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MidiBufferTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+static const size_t event_bytes = sizeof (MidiBuffer::TimeType) + 3;
+
+/* deterministic pseudo-random event times */
+static uint32_t
+next_random (uint32_t& seed)
+{
+	seed = seed * 1664525 + 1013904223;
+	return seed >> 8;
+}
+
+static void
+push_note (MidiBuffer& buf, MidiBuffer::TimeType time, uint8_t status, uint8_t note)
+{
+	const uint8_t msg[3] = { status, note, 100 };
+	CPPUNIT_ASSERT (buf.push_back (time, 3, msg));
+}
+
+static bool
+in_order (MidiBuffer const & buf, size_t& count)
+{
+	MidiBuffer::TimeType last = 0;
+	count = 0;
+	for (MidiBuffer::const_iterator i = buf.begin(); i != buf.end(); ++i, ++count) {
+		if ((*i).time() < last) {
+			return false;
+		}
+		last = (*i).time();
+	}
+	return true;
+}
+
+void
+MidiBufferTest::sortTest ()
+{
+	MidiBuffer buf (64 * event_bytes);
+	uint32_t seed = 1;
+
+	for (uint8_t n = 0; n < 32; ++n) {
+		push_note (buf, next_random (seed) % 16, 0x90, n);
+	}
+
+	size_t count;
+	CPPUNIT_ASSERT (!in_order (buf, count));
+
+	buf.sort ();
+	CPPUNIT_ASSERT (in_order (buf, count));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 32, count);
+
+	/* events that share a time and type keep the order they were added in */
+	int last_note[16];
+	for (int t = 0; t < 16; ++t) {
+		last_note[t] = -1;
+	}
+	for (MidiBuffer::iterator i = buf.begin(); i != buf.end(); ++i) {
+		const int note = (*i).buffer()[1];
+		CPPUNIT_ASSERT (note > last_note[(*i).time()]);
+		last_note[(*i).time()] = note;
+	}
+}
+
+void
+MidiBufferTest::simultaneousTest ()
+{
+	MidiBuffer buf (16 * event_bytes);
+
+	push_note (buf, 10, 0x90, 60);
+	push_note (buf, 10, 0x80, 60);
+	push_note (buf, 10, 0xb0, 7);
+	push_note (buf, 5, 0x90, 62);
+
+	buf.sort ();
+
+	/* controller before note off before note on, as for merge_in_place() */
+	MidiBuffer::iterator i = buf.begin();
+	CPPUNIT_ASSERT_EQUAL ((MidiBuffer::TimeType) 5, (*i).time());
+	++i;
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 0xb0, (*i).buffer()[0]);
+	++i;
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 0x80, (*i).buffer()[0]);
+	++i;
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 0x90, (*i).buffer()[0]);
+	++i;
+	CPPUNIT_ASSERT (i == buf.end());
+}
+
+void
+MidiBufferTest::mergeTest ()
+{
+	MidiBuffer a (256 * event_bytes);
+	MidiBuffer b (128 * event_bytes);
+
+	for (int n = 0; n < 100; ++n) {
+		push_note (a, n * 2, 0x90, 1);
+		push_note (b, n * 3, 0x80, 2);
+	}
+
+	CPPUNIT_ASSERT (a.merge_in_place (b));
+
+	size_t count;
+	CPPUNIT_ASSERT (in_order (a, count));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 200, count);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 200 * event_bytes, a.size());
+
+	/* at equal times the note off from "b" goes before the note on from "a" */
+	MidiBuffer::iterator i = a.begin();
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 0x80, (*i).buffer()[0]);
+
+	/* too much to fit: refused, and this buffer is left untouched */
+	MidiBuffer c (16 * event_bytes);
+	push_note (c, 0, 0x90, 1);
+	CPPUNIT_ASSERT (!c.merge_in_place (a));
+	CPPUNIT_ASSERT_EQUAL (event_bytes, c.size());
+}
+
+void
+MidiBufferTest::largeBatchTest ()
+{
+	const size_t counts[] = { 1000, 5000, 10000 };
+
+	for (size_t c = 0; c < sizeof (counts) / sizeof (counts[0]); ++c) {
+
+		const size_t n = counts[c];
+		MidiBuffer inserted (n * event_bytes + 1);
+		MidiBuffer sorted (n * event_bytes + 1);
+		uint32_t seed = 42;
+
+		for (size_t e = 0; e < n; ++e) {
+			const uint8_t msg[3] = { 0x90, (uint8_t) (e & 0x7f), 100 };
+			inserted.insert_event (Evoral::MIDIEvent<MidiBuffer::TimeType> (0, next_random (seed) % 1024, 3, const_cast<uint8_t*> (msg)));
+		}
+
+		seed = 42;
+		for (size_t e = 0; e < n; ++e) {
+			const uint8_t msg[3] = { 0x90, (uint8_t) (e & 0x7f), 100 };
+			sorted.push_back (next_random (seed) % 1024, 3, msg);
+		}
+		sorted.sort ();
+
+		/* both must end up with the same content */
+		CPPUNIT_ASSERT_EQUAL (inserted.size(), sorted.size());
+		CPPUNIT_ASSERT (memcmp (inserted.data(), sorted.data(), sorted.size()) == 0);
+	}
+}
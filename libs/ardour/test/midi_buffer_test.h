@@ -0,0 +1,18 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MidiBufferTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (MidiBufferTest);
+	CPPUNIT_TEST (sortTest);
+	CPPUNIT_TEST (simultaneousTest);
+	CPPUNIT_TEST (mergeTest);
+	CPPUNIT_TEST (largeBatchTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void sortTest ();
+	void simultaneousTest ();
+	void mergeTest ();
+	void largeBatchTest ();
+};
@@ -0,0 +1,135 @@
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "pbd/fpu.h"
+
+#include "ardour/mix.h"
+
+#include "mix_functions_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MixFunctionsTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+/* the SSE kernels must give the same results as the portable ones */
+
+#if defined (ARCH_X86) && defined (BUILD_SSE_OPTIMIZATIONS)
+
+static bool
+have_sse ()
+{
+	return PBD::FPU::instance()->has_sse ();
+}
+
+static void
+fill (vector<Sample>& v, unsigned seed)
+{
+	srand (seed);
+	for (vector<Sample>::iterator i = v.begin(); i != v.end(); ++i) {
+		*i = (rand() / (float) RAND_MAX) * 2.0f - 1.0f;
+	}
+}
+
+static void
+check_equal (vector<Sample> const & a, vector<Sample> const & b)
+{
+	CPPUNIT_ASSERT_EQUAL (a.size(), b.size());
+	for (size_t i = 0; i < a.size(); ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (a[i], b[i], 1e-5);
+	}
+}
+
+#endif
+
+void
+MixFunctionsTest::gainVectorTest ()
+{
+#if defined (ARCH_X86) && defined (BUILD_SSE_OPTIMIZATIONS)
+	if (!have_sse ()) {
+		return;
+	}
+
+	/* odd lengths and offsets so that both the aligned loop
+	   and the unaligned head and tail get exercised.
+	*/
+	pframes_t const lengths[] = { 1, 3, 4, 7, 16, 61, 256, 1023 };
+	uint32_t const offsets[] = { 0, 1, 3 };
+
+	for (size_t l = 0; l < sizeof (lengths) / sizeof (lengths[0]); ++l) {
+		for (size_t o = 0; o < sizeof (offsets) / sizeof (offsets[0]); ++o) {
+			pframes_t const n = lengths[l];
+			uint32_t const off = offsets[o];
+
+			vector<Sample> src (n + off);
+			vector<float> gain (n + off);
+			vector<Sample> expected (n + off);
+
+			fill (src, 1 + l);
+			fill (gain, 100 + l);
+			fill (expected, 200 + l);
+
+			vector<Sample> actual (expected);
+
+			default_mix_buffers_with_gain_vector (&expected[off], &src[off], n, &gain[off]);
+			x86_sse_mix_buffers_with_gain_vector (&actual[off], &src[off], n, &gain[off]);
+
+			check_equal (expected, actual);
+		}
+	}
+#endif
+}
+
+void
+MixFunctionsTest::bufferToOutputsTest ()
+{
+#if defined (ARCH_X86) && defined (BUILD_SSE_OPTIMIZATIONS)
+	if (!have_sse ()) {
+		return;
+	}
+
+	pframes_t const lengths[] = { 1, 5, 8, 37, 64, 255, 1024 };
+	uint32_t const n_outputs = 6;
+
+	for (size_t l = 0; l < sizeof (lengths) / sizeof (lengths[0]); ++l) {
+		pframes_t const n = lengths[l];
+
+		/* ramp over none, some and all of the block */
+		pframes_t const ramps[] = { 0, n / 2, n };
+
+		for (size_t r = 0; r < sizeof (ramps) / sizeof (ramps[0]); ++r) {
+			/* start each output one sample further in, so that
+			   they are not all aligned the same way.
+			*/
+			vector<Sample> src (n);
+			vector<vector<Sample> > expected (n_outputs, vector<Sample> (n + n_outputs));
+			fill (src, 7 + l);
+			for (uint32_t o = 0; o < n_outputs; ++o) {
+				fill (expected[o], 300 + o);
+			}
+			vector<vector<Sample> > actual (expected);
+
+			Sample* expected_dst[n_outputs];
+			Sample* actual_dst[n_outputs];
+			for (uint32_t o = 0; o < n_outputs; ++o) {
+				expected_dst[o] = &expected[o][o];
+				actual_dst[o] = &actual[o][o];
+			}
+
+			/* a steady output, fading in, fading out, moving,
+			   silent throughout, and a negative gain.
+			*/
+			float const initial[n_outputs] = { 0.5, 0.0, 0.8, 0.2, 0.0, -0.3 };
+			float const target[n_outputs]  = { 0.5, 0.7, 0.0, 0.9, 0.0, -0.6 };
+
+			default_mix_buffer_to_outputs (expected_dst, n_outputs, &src[0], n, initial, target, ramps[r]);
+			x86_sse_mix_buffer_to_outputs (actual_dst, n_outputs, &src[0], n, initial, target, ramps[r]);
+
+			for (uint32_t o = 0; o < n_outputs; ++o) {
+				check_equal (expected[o], actual[o]);
+			}
+		}
+	}
+#endif
+}
@@ -0,0 +1,14 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MixFunctionsTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (MixFunctionsTest);
+	CPPUNIT_TEST (gainVectorTest);
+	CPPUNIT_TEST (bufferToOutputsTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void gainVectorTest ();
+	void bufferToOutputsTest ();
+};
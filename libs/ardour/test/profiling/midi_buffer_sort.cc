@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <glib.h>
+
+#include "ardour/ardour.h"
+#include "ardour/midi_buffer.h"
+
+using namespace std;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+static const size_t event_bytes = sizeof (MidiBuffer::TimeType) + 3;
+
+/* deterministic pseudo-random event times */
+static uint32_t
+next_random (uint32_t& seed)
+{
+	seed = seed * 1664525 + 1013904223;
+	return seed >> 8;
+}
+
+/* Time filling a MidiBuffer with unordered events one insert_event() at a
+ * time against push_back() followed by a single sort().
+ */
+int
+main (int argc, char* argv[])
+{
+	ARDOUR::init (false, true, localedir);
+
+	const size_t counts[] = { 1000, 5000, 10000 };
+	const int runs = (argc > 1) ? std::max (1, atoi (argv[1])) : 10;
+
+	for (size_t c = 0; c < sizeof (counts) / sizeof (counts[0]); ++c) {
+
+		const size_t n = counts[c];
+		gint64 insert_time = 0;
+		gint64 sort_time = 0;
+
+		for (int r = 0; r < runs; ++r) {
+			MidiBuffer inserted (n * event_bytes + 1);
+			MidiBuffer sorted (n * event_bytes + 1);
+			uint32_t seed = 42 + r;
+
+			gint64 start = g_get_monotonic_time ();
+			for (size_t e = 0; e < n; ++e) {
+				const uint8_t msg[3] = { 0x90, (uint8_t) (e & 0x7f), 100 };
+				inserted.insert_event (Evoral::MIDIEvent<MidiBuffer::TimeType> (0, next_random (seed) % 1024, 3, const_cast<uint8_t*> (msg)));
+			}
+			insert_time += g_get_monotonic_time () - start;
+
+			seed = 42 + r;
+			start = g_get_monotonic_time ();
+			for (size_t e = 0; e < n; ++e) {
+				const uint8_t msg[3] = { 0x90, (uint8_t) (e & 0x7f), 100 };
+				sorted.push_back (next_random (seed) % 1024, 3, msg);
+			}
+			sorted.sort ();
+			sort_time += g_get_monotonic_time () - start;
+
+			if (inserted.size () != sorted.size () || memcmp (inserted.data (), sorted.data (), sorted.size ()) != 0) {
+				cerr << "ERROR: results differ for " << n << " events\n";
+				return 1;
+			}
+		}
+
+		cout << n << " events: insert_event " << insert_time / runs << "us, push_back + sort " << sort_time / runs << "us\n";
+	}
+
+	return 0;
+}
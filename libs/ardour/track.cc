@@ -686,6 +686,12 @@ Track::capture_buffer_load () const
 	return _diskstream->capture_buffer_load ();
 }
 
+DiskIOStats&
+Track::io_stats ()
+{
+	return _diskstream->io_stats ();
+}
+
 int
 Track::do_refill ()
 {
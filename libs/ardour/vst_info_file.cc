@@ -22,12 +22,16 @@
  *  e.g. its name, creator etc.
  */
 
+#include <algorithm>
 #include <cassert>
+#include <list>
+#include <map>
 
 #include <sys/types.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <errno.h>
+#include <inttypes.h>
 
 #include <stdlib.h>
 #include <stddef.h>
@@ -77,6 +81,9 @@ static bool vstfx_instantiate_and_get_info_lx (const char* dllpath, vector<VSTIn
 /* ID for shell plugins */
 static int vstfx_current_loading_id = 0;
 
+/* if false, the caller takes care of blacklisting (parallel scan) */
+static bool vstfx_manage_blacklist = true;
+
 /* *** CACHE FILE PATHS *** */
 
 static string
@@ -419,11 +426,36 @@ vstfx_write_info_file (FILE* fp, vector<VSTInfo *> *infos)
 
 /* *** CACHE MANAGEMENT *** */
 
+#ifndef VST_SCANNER_APP
+static void vstfx_index_remove (const char *dllpath);
+#endif
+
 /** remove info file from cache */
 static void
 vstfx_remove_infofile (const char *dllpath)
 {
 	::g_unlink (vstfx_infofile_path (dllpath).c_str ());
+#ifndef VST_SCANNER_APP
+	vstfx_index_remove (dllpath);
+#endif
+}
+
+/** @return true if the info file at @param path is not older than the plugin */
+static bool
+vstfx_infofile_is_current (const char* dllpath, string const & path)
+{
+	GStatBuf dllstat;
+	GStatBuf fsistat;
+
+	if (g_stat (dllpath, &dllstat) == 0) {
+		if (g_stat (path.c_str (), &fsistat) == 0) {
+			if (dllstat.st_mtime <= fsistat.st_mtime) {
+				/* plugin is older than info file */
+				return true;
+			}
+		}
+	}
+	return false;
 }
 
 /** cache file for given plugin
@@ -443,16 +475,8 @@ vstfx_infofile_for_read (const char* dllpath)
 	string const path = vstfx_infofile_path (dllpath);
 
 	if (Glib::file_test (path, Glib::FileTest (Glib::FILE_TEST_EXISTS | Glib::FILE_TEST_IS_REGULAR))) {
-		GStatBuf dllstat;
-		GStatBuf fsistat;
-
-		if (g_stat (dllpath, &dllstat) == 0) {
-			if (g_stat (path.c_str (), &fsistat) == 0) {
-				if (dllstat.st_mtime <= fsistat.st_mtime) {
-					/* plugin is older than info file */
-					return g_fopen (path.c_str (), "rb");
-				}
-			}
+		if (vstfx_infofile_is_current (dllpath, path)) {
+			return g_fopen (path.c_str (), "rb");
 		}
 		PBD::warning << string_compose (_("Ignored VST plugin which is newer than cache: '%1' (cache: '%2')"), dllpath, path) << endmsg;
 		PBD::info << _("Re-Scan Plugins (Preferences > Plugins) to update the cache, also make sure your system-time is set correctly.") << endmsg;
@@ -500,6 +524,208 @@ vstfx_get_info_from_file (const char* dllpath, vector<VSTInfo*> *infos)
 
 
 
+/* *** CONSOLIDATED CACHE INDEX *** */
+#ifndef VST_SCANNER_APP
+
+/* All .fsi files that were successfully read are collected in a single
+ * index file keyed by plugin path, modification time and size.
+ * A cache-only refresh then only needs to stat() each plugin instead
+ * of locating, opening and parsing one info file per plugin.
+ */
+
+struct VSTIndexEntry {
+	VSTIndexEntry () : mtime (0), size (0) {}
+	int64_t mtime;
+	int64_t size;
+	vector<VSTInfo*> infos;
+};
+
+typedef std::map<std::string, VSTIndexEntry> VSTIndex;
+
+static VSTIndex _vst_index;
+static bool     _vst_index_loaded = false;
+static bool     _vst_index_dirty = false;
+
+static string
+vstfx_index_path ()
+{
+	return Glib::build_filename (get_vst_info_cache_dir (), VST_INDEXFILE);
+}
+
+/** deep copy a VSTInfo, the result must be free'd with vstfx_free_info() */
+static VSTInfo*
+vstfx_copy_info (VSTInfo const * src)
+{
+	VSTInfo* info = (VSTInfo*) calloc (1, sizeof (VSTInfo));
+	*info = *src;
+	info->name = strdup (src->name);
+	info->creator = strdup (src->creator);
+	info->Category = strdup (src->Category);
+
+	if (src->numParams > 0) {
+		info->ParamNames = (char **) malloc (sizeof (char*) * src->numParams);
+		info->ParamLabels = (char **) malloc (sizeof (char*) * src->numParams);
+		for (int i = 0; i < src->numParams; ++i) {
+			info->ParamNames[i] = strdup (src->ParamNames[i]);
+			info->ParamLabels[i] = strdup (src->ParamLabels[i]);
+		}
+	} else {
+		info->ParamNames = NULL;
+		info->ParamLabels = NULL;
+	}
+	return info;
+}
+
+/** read a complete line (of arbitrary length) without the trailing newline
+ * @return true on success
+ */
+static bool
+read_line (FILE *fp, string& line)
+{
+	char buf[MAX_STRING_LEN];
+	line.clear ();
+
+	while (fgets (buf, MAX_STRING_LEN, fp)) {
+		const size_t len = strlen (buf);
+		if (len > 0 && buf[len - 1] == '\n') {
+			line.append (buf, len - 1);
+			return true;
+		}
+		line.append (buf, len);
+	}
+	return !line.empty ();
+}
+
+static bool
+read_int64 (FILE* fp, int64_t* n)
+{
+	string line;
+	if (!read_line (fp, line)) {
+		return false;
+	}
+	char* end;
+	*n = g_ascii_strtoll (line.c_str (), &end, 10);
+	return end != line.c_str ();
+}
+
+static void
+vstfx_clear_index_entries ()
+{
+	for (VSTIndex::iterator i = _vst_index.begin (); i != _vst_index.end (); ++i) {
+		vstfx_clear_info_list (&i->second.infos);
+	}
+	_vst_index.clear ();
+}
+
+static void
+vstfx_load_index ()
+{
+	if (_vst_index_loaded) {
+		return;
+	}
+	_vst_index_loaded = true;
+	_vst_index_dirty = false;
+
+	FILE* fp = g_fopen (vstfx_index_path ().c_str (), "rb");
+	if (!fp) {
+		return;
+	}
+
+	string path;
+	while (read_line (fp, path)) {
+		VSTIndexEntry entry;
+		int64_t cnt;
+		bool ok = read_int64 (fp, &entry.mtime) && read_int64 (fp, &entry.size) && read_int64 (fp, &cnt);
+
+		for (int64_t c = 0; ok && c < cnt; ++c) {
+			VSTInfo* info = (VSTInfo*) calloc (1, sizeof (VSTInfo));
+			if (info && vstfx_load_info_block (fp, info)) {
+				entry.infos.push_back (info);
+			} else {
+				if (info) {
+					vstfx_free_info (info);
+				}
+				ok = false;
+			}
+		}
+
+		if (!ok || entry.infos.empty ()) {
+			/* corrupt index, the individual .fsi files are still available */
+			PBD::warning << string_compose (_("Ignored corrupt VST cache index '%1'"), vstfx_index_path ()) << endmsg;
+			vstfx_clear_info_list (&entry.infos);
+			vstfx_clear_index_entries ();
+			_vst_index_dirty = true;
+			break;
+		}
+		_vst_index[path] = entry;
+	}
+	fclose (fp);
+}
+
+static void
+vstfx_index_remove (const char *dllpath)
+{
+	if (!_vst_index_loaded) {
+		return;
+	}
+	VSTIndex::iterator i = _vst_index.find (dllpath);
+	if (i != _vst_index.end ()) {
+		vstfx_clear_info_list (&i->second.infos);
+		_vst_index.erase (i);
+		_vst_index_dirty = true;
+	}
+}
+
+/** remember the given plugin info, keyed by path and the plugin's current mtime */
+static void
+vstfx_index_add (const char* dllpath, vector<VSTInfo*> const * infos)
+{
+	GStatBuf dllstat;
+	if (infos->empty () || g_stat (dllpath, &dllstat) != 0) {
+		return;
+	}
+
+	vstfx_load_index ();
+	vstfx_index_remove (dllpath);
+
+	VSTIndexEntry& entry (_vst_index[dllpath]);
+	entry.mtime = dllstat.st_mtime;
+	entry.size = dllstat.st_size;
+	for (vector<VSTInfo*>::const_iterator i = infos->begin (); i != infos->end (); ++i) {
+		entry.infos.push_back (vstfx_copy_info (*i));
+	}
+	_vst_index_dirty = true;
+}
+
+/** look up plugin info in the index
+ * @param infos [return] copy of the cached plugin info
+ * @return true if an up-to-date entry was found
+ */
+static bool
+vstfx_get_info_from_index (const char* dllpath, vector<VSTInfo*> *infos)
+{
+	vstfx_load_index ();
+
+	VSTIndex::iterator i = _vst_index.find (dllpath);
+	if (i == _vst_index.end ()) {
+		return false;
+	}
+
+	GStatBuf dllstat;
+	if (g_stat (dllpath, &dllstat) != 0 || dllstat.st_mtime != i->second.mtime || dllstat.st_size != i->second.size) {
+		vstfx_index_remove (dllpath);
+		return false;
+	}
+
+	for (vector<VSTInfo*>::const_iterator x = i->second.infos.begin (); x != i->second.infos.end (); ++x) {
+		infos->push_back (vstfx_copy_info (*x));
+	}
+	return true;
+}
+
+#endif // VST_SCANNER_APP
+
+
 /* *** VST system-under-test methods *** */
 
 static
@@ -902,7 +1128,16 @@ vstfx_get_info (const char* dllpath, enum ARDOUR::PluginType type, enum VSTScanM
 		return infos;
 	}
 
+#ifndef VST_SCANNER_APP
+	if (vstfx_get_info_from_index (dllpath, infos)) {
+		return infos;
+	}
+#endif
+
 	if (vstfx_get_info_from_file (dllpath, infos)) {
+#ifndef VST_SCANNER_APP
+		vstfx_index_add (dllpath, infos);
+#endif
 		return infos;
 	}
 
@@ -959,7 +1194,9 @@ vstfx_get_info (const char* dllpath, enum ARDOUR::PluginType type, enum VSTScanM
 		/* re-read index (generated by external scanner) */
 		vstfx_clear_info_list (infos);
 		if (!vst_is_blacklisted (dllpath)) {
-			vstfx_get_info_from_file (dllpath, infos);
+			if (vstfx_get_info_from_file (dllpath, infos)) {
+				vstfx_index_add (dllpath, infos);
+			}
 		}
 		return infos;
 	}
@@ -970,7 +1207,9 @@ vstfx_get_info (const char* dllpath, enum ARDOUR::PluginType type, enum VSTScanM
 
 	bool ok;
 	/* blacklist in case instantiation fails */
-	vstfx_blacklist (dllpath);
+	if (vstfx_manage_blacklist) {
+		vstfx_blacklist (dllpath);
+	}
 
 	switch (type) {
 #ifdef WINDOWS_VST_SUPPORT
@@ -993,7 +1232,9 @@ vstfx_get_info (const char* dllpath, enum ARDOUR::PluginType type, enum VSTScanM
 	}
 
 	/* remove from blacklist */
-	vstfx_un_blacklist (dllpath);
+	if (vstfx_manage_blacklist) {
+		vstfx_un_blacklist (dllpath);
+	}
 
 	/* crate cache/whitelist */
 	infofile = vstfx_infofile_for_write (dllpath);
@@ -1003,6 +1244,9 @@ vstfx_get_info (const char* dllpath, enum ARDOUR::PluginType type, enum VSTScanM
 	} else {
 		vstfx_write_info_file (infofile, infos);
 		fclose (infofile);
+#ifndef VST_SCANNER_APP
+		vstfx_index_add (dllpath, infos);
+#endif
 	}
 	return infos;
 }
@@ -1019,6 +1263,212 @@ vstfx_free_info_list (vector<VSTInfo *> *infos)
 	delete infos;
 }
 
+#ifndef VST_SCANNER_APP
+
+/** @return true if the plugin is neither blacklisted nor has up-to-date cached info */
+static bool
+vstfx_needs_scan (const char* dllpath)
+{
+	if (vst_is_blacklisted (dllpath)) {
+		return false;
+	}
+
+	vstfx_load_index ();
+	VSTIndex::const_iterator i = _vst_index.find (dllpath);
+	if (i != _vst_index.end ()) {
+		GStatBuf dllstat;
+		if (g_stat (dllpath, &dllstat) == 0 && dllstat.st_mtime == i->second.mtime && dllstat.st_size == i->second.size) {
+			return false;
+		}
+	}
+
+	string const path = vstfx_infofile_path (dllpath);
+	if (Glib::file_test (path, Glib::FileTest (Glib::FILE_TEST_EXISTS | Glib::FILE_TEST_IS_REGULAR))) {
+		return !vstfx_infofile_is_current (dllpath, path);
+	}
+	return true;
+}
+
+struct VSTScanJob {
+	VSTScanJob (std::string const & p) : dllpath (p), scanner (0), timeout (PLUGIN_SCAN_TIMEOUT) {}
+	~VSTScanJob () { cons.drop_connections (); delete scanner; }
+
+	/* called by the scanner's own reader thread, one per job */
+	void append_output (std::string msg, size_t /*len*/) {
+		Glib::Threads::Mutex::Lock lm (output_lock);
+		output += msg;
+	}
+
+	/* log what the scanner printed, from the scanning thread */
+	void report_output () {
+		Glib::Threads::Mutex::Lock lm (output_lock);
+		if (!output.empty ()) {
+			PBD::error << "VST '" << dllpath << "': " << output << endmsg;
+			output.clear ();
+		}
+	}
+
+	std::string                dllpath;
+	ARDOUR::SystemExec*        scanner;
+	int                        timeout;
+	PBD::ScopedConnectionList  cons;
+	Glib::Threads::Mutex       output_lock;
+	std::string                output;
+};
+
+void
+vstfx_scan_parallel (vector<string> const & dllpaths, std::string const & type, int jobs)
+{
+	std::string scanner_bin_path = ARDOUR::PluginManager::scanner_bin_path;
+	if (scanner_bin_path == "") {
+		return;
+	}
+
+	const bool no_timeout = (PLUGIN_SCAN_TIMEOUT <= 0);
+	std::list<VSTScanJob*> running;
+	vector<string>::const_iterator next = dllpaths.begin ();
+	int tick = 0;
+
+	while (true) {
+
+		if (ARDOUR::PluginManager::instance ().cancelled ()) {
+			for (std::list<VSTScanJob*>::iterator i = running.begin (); i != running.end (); ++i) {
+				(*i)->scanner->terminate ();
+				/* remove info file (might be incomplete) */
+				vstfx_remove_infofile ((*i)->dllpath.c_str ());
+				delete *i;
+			}
+			return;
+		}
+
+		/* launch new scanners until the limit is reached */
+		while ((int) running.size () < jobs && next != dllpaths.end ()) {
+			std::string const & dllpath (*next++);
+
+			if (!vstfx_needs_scan (dllpath.c_str ())) {
+				continue;
+			}
+
+			ARDOUR::PluginScanMessage (type, dllpath, true);
+
+			/* -n: the scanner app must not modify the blacklist,
+			 * concurrent read-modify-write of the file would race.
+			 */
+			char **argp= (char**) calloc (4,sizeof (char*));
+			argp[0] = strdup (scanner_bin_path.c_str ());
+			argp[1] = strdup ("-n");
+			argp[2] = strdup (dllpath.c_str ());
+			argp[3] = 0;
+
+			VSTScanJob* job = new VSTScanJob (dllpath);
+			job->scanner = new ARDOUR::SystemExec (scanner_bin_path, argp);
+			job->scanner->ReadStdout.connect_same_thread (job->cons, boost::bind (&VSTScanJob::append_output, job, _1, _2));
+
+			if (job->scanner->start (2 /* send stderr&stdout via signal */)) {
+				PBD::error << string_compose (_("Cannot launch VST scanner app '%1': %2"), scanner_bin_path, strerror (errno)) << endmsg;
+				delete job;
+				continue;
+			}
+			running.push_back (job);
+		}
+
+		if (running.empty ()) {
+			break;
+		}
+
+		ARDOUR::GUIIdle ();
+		Glib::usleep (100000);
+
+		int min_timeout = PLUGIN_SCAN_TIMEOUT;
+
+		for (std::list<VSTScanJob*>::iterator i = running.begin (); i != running.end ();) {
+			VSTScanJob* job = *i;
+			bool done = !job->scanner->is_running ();
+
+			if (!done && !no_timeout && !ARDOUR::PluginManager::instance ().no_timeout ()) {
+				if (--job->timeout <= 0) {
+					PBD::warning << string_compose (_("VST scanner timed out for '%1'"), job->dllpath) << endmsg;
+					done = true;
+				}
+				min_timeout = std::min (min_timeout, job->timeout);
+			}
+
+			if (!done) {
+				++i;
+				continue;
+			}
+
+			job->scanner->terminate ();
+			job->report_output ();
+
+			/* the scanner only writes the info file if the plugin can be used */
+			string const path = vstfx_infofile_path (job->dllpath.c_str ());
+			if (!Glib::file_test (path, Glib::FILE_TEST_EXISTS) || !vstfx_infofile_is_current (job->dllpath.c_str (), path)) {
+				vstfx_blacklist (job->dllpath.c_str ());
+			}
+
+			delete job;
+			i = running.erase (i);
+		}
+
+		if (!no_timeout && (tick++ % 5) == 0) {
+			ARDOUR::PluginScanTimeout (min_timeout);
+		}
+	}
+}
+
+void
+vstfx_save_index ()
+{
+	if (!_vst_index_loaded || !_vst_index_dirty) {
+		return;
+	}
+
+	string const path = vstfx_index_path ();
+	string const tmp = path + ".tmp";
+
+	FILE* fp = g_fopen (tmp.c_str (), "wb");
+	if (!fp) {
+		PBD::warning << string_compose (_("Cannot write VST cache index '%1'"), path) << endmsg;
+		return;
+	}
+
+	for (VSTIndex::const_iterator i = _vst_index.begin (); i != _vst_index.end (); ++i) {
+		if (!Glib::file_test (i->first, Glib::FILE_TEST_EXISTS)) {
+			/* plugin was removed */
+			continue;
+		}
+		fprintf (fp, "%s\n", i->first.c_str ());
+		fprintf (fp, "%" PRId64 "\n", i->second.mtime);
+		fprintf (fp, "%" PRId64 "\n", i->second.size);
+		fprintf (fp, "%d\n", (int) i->second.infos.size ());
+		for (vector<VSTInfo*>::const_iterator x = i->second.infos.begin (); x != i->second.infos.end (); ++x) {
+			vstfx_write_info_block (fp, *x);
+		}
+	}
+
+	if (fclose (fp) == 0) {
+		::g_unlink (path.c_str ());
+		if (::g_rename (tmp.c_str (), path.c_str ()) == 0) {
+			_vst_index_dirty = false;
+			return;
+		}
+	}
+	PBD::warning << string_compose (_("Cannot write VST cache index '%1'"), path) << endmsg;
+	::g_unlink (tmp.c_str ());
+}
+
+void
+vstfx_clear_index ()
+{
+	vstfx_clear_index_entries ();
+	_vst_index_loaded = false;
+	_vst_index_dirty = false;
+	::g_unlink (vstfx_index_path ().c_str ());
+}
+
+#endif
+
 #ifdef LXVST_SUPPORT
 vector<VSTInfo *> *
 vstfx_get_info_lx (char* dllpath, enum VSTScanMode mode)
@@ -18,6 +18,9 @@
 */
 
 #include <math.h>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
 #include "ardour/vumeterdsp.h"
 
 
@@ -43,10 +46,7 @@ void Vumeterdsp::process (float const *p, int n)
 {
     float z1, z2, m, t1, t2;
 
-    z1 = _z1 > 20 ? 20 : (_z1 < -20 ? -20 : _z1);
-    z2 = _z2 > 20 ? 20 : (_z2 < -20 ? -20 : _z2);
-    m = _res ? 0: _m;
-    _res = false;
+    get_state (z1, z2, m);
 
     n /= 4;
     while (n--)
@@ -64,6 +64,73 @@ void Vumeterdsp::process (float const *p, int n)
 	if (z2 > m) m = z2;
     }
 
+    set_state (z1, z2, m);
+}
+
+void Vumeterdsp::process (Vumeterdsp* const *meters, float const * const *bufs, int nchan, int n)
+{
+    int c = 0;
+
+#ifdef __SSE__
+    // Four channels at a time, one channel per SSE lane.
+    const __m128 w    = _mm_set1_ps (_w);
+    const __m128 w4   = _mm_set1_ps (4 * _w);
+    const __m128 half = _mm_set1_ps (0.5f);
+    const __m128 sign = _mm_set1_ps (-0.0f);
+
+    for (; c + 4 <= nchan; c += 4)
+    {
+	float  v1 [4], v2 [4], vm [4];
+	float const *p0 = bufs [c];
+	float const *p1 = bufs [c + 1];
+	float const *p2 = bufs [c + 2];
+	float const *p3 = bufs [c + 3];
+
+	for (int j = 0; j < 4; ++j) meters [c + j]->get_state (v1 [j], v2 [j], vm [j]);
+	__m128 z1 = _mm_loadu_ps (v1);
+	__m128 z2 = _mm_loadu_ps (v2);
+	__m128 m  = _mm_loadu_ps (vm);
+
+	for (int i = n / 4; i > 0; --i)
+	{
+	    __m128 s0 = _mm_loadu_ps (p0);
+	    __m128 s1 = _mm_loadu_ps (p1);
+	    __m128 s2 = _mm_loadu_ps (p2);
+	    __m128 s3 = _mm_loadu_ps (p3);
+	    p0 += 4; p1 += 4; p2 += 4; p3 += 4;
+	    _MM_TRANSPOSE4_PS (s0, s1, s2, s3);
+	    const __m128 t2 = _mm_mul_ps (z2, half);
+	    z1 = _mm_add_ps (z1, _mm_mul_ps (w, _mm_sub_ps (_mm_sub_ps (_mm_andnot_ps (sign, s0), t2), z1)));
+	    z1 = _mm_add_ps (z1, _mm_mul_ps (w, _mm_sub_ps (_mm_sub_ps (_mm_andnot_ps (sign, s1), t2), z1)));
+	    z1 = _mm_add_ps (z1, _mm_mul_ps (w, _mm_sub_ps (_mm_sub_ps (_mm_andnot_ps (sign, s2), t2), z1)));
+	    z1 = _mm_add_ps (z1, _mm_mul_ps (w, _mm_sub_ps (_mm_sub_ps (_mm_andnot_ps (sign, s3), t2), z1)));
+	    z2 = _mm_add_ps (z2, _mm_mul_ps (w4, _mm_sub_ps (z1, z2)));
+	    m  = _mm_max_ps (m, z2);
+	}
+
+	_mm_storeu_ps (v1, z1);
+	_mm_storeu_ps (v2, z2);
+	_mm_storeu_ps (vm, m);
+	for (int j = 0; j < 4; ++j) meters [c + j]->set_state (v1 [j], v2 [j], vm [j]);
+    }
+#endif
+
+    for (; c < nchan; ++c)
+    {
+	meters [c]->process (bufs [c], n);
+    }
+}
+
+void Vumeterdsp::get_state (float& z1, float& z2, float& m)
+{
+    z1 = _z1 > 20 ? 20 : (_z1 < -20 ? -20 : _z1);
+    z2 = _z2 > 20 ? 20 : (_z2 < -20 ? -20 : _z2);
+    m = _res ? 0: _m;
+    _res = false;
+}
+
+void Vumeterdsp::set_state (float z1, float z2, float m)
+{
     if (isnan(z1)) z1 = 0;
     if (isnan(z2)) z2 = 0;
     _z1 = z1;
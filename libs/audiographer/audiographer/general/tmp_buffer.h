@@ -0,0 +1,127 @@
+#ifndef AUDIOGRAPHER_TMP_BUFFER_H
+#define AUDIOGRAPHER_TMP_BUFFER_H
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include <boost/format.hpp>
+
+#include "audiographer/visibility.h"
+#include "audiographer/exception.h"
+#include "audiographer/flag_debuggable.h"
+#include "audiographer/sink.h"
+#include "audiographer/types.h"
+#include "audiographer/type_utils.h"
+#include "audiographer/utils/listed_source.h"
+
+#include "pbd/signals.h"
+
+namespace AudioGrapher
+{
+
+/** An in-memory replacement for TmpFile.
+  * Stores everything that is processed and can play it back via \a read(),
+  * which avoids the disk round trip when the material fits in RAM.
+  */
+template<typename T = DefaultSampleType>
+class /*LIBAUDIOGRAPHER_API*/ TmpBuffer
+  : public ListedSource<T>
+  , public Sink<T>
+  , public Throwing<>
+  , public FlagDebuggable<>
+{
+  public:
+
+	/** Constructor \n Not RT safe
+	  * \a reserve_frames is a hint for the total amount of interleaved frames
+	  * that will be written, used to avoid reallocating during process()
+	  */
+	TmpBuffer (ChannelCount channels, framecnt_t reserve_frames = 0)
+		: _channels (channels)
+		, read_position (0)
+	{
+		add_supported_flag (ProcessContext<T>::EndOfInput);
+		if (reserve_frames > 0) {
+			data.reserve (reserve_frames);
+		}
+	}
+
+	ChannelCount channels () const { return _channels; }
+
+	/// Returns the amount of interleaved frames stored
+	framecnt_t get_frames_written () const { return data.size (); }
+
+	/// Same semantics as SndfileHandle::seek(), but only SEEK_SET and SEEK_CUR are supported
+	framecnt_t seek (framecnt_t frames, int whence)
+	{
+		framecnt_t const total = data.size () / _channels;
+		framecnt_t pos = frames;
+
+		if (whence == SEEK_CUR) {
+			pos += read_position / _channels;
+		}
+
+		pos = std::max ((framecnt_t) 0, std::min (pos, total));
+		read_position = pos * _channels;
+		return pos;
+	}
+
+	/// Stores data in memory \n Not RT safe
+	void process (ProcessContext<T> const & c)
+	{
+		check_flags (*this, c);
+
+		if (throw_level (ThrowStrict) && c.channels () != _channels) {
+			throw Exception (*this, boost::str (boost::format
+				("Wrong number of channels given to process(), %1% instead of %2%")
+				% c.channels () % _channels));
+		}
+
+		data.insert (data.end (), c.data (), c.data () + c.frames ());
+
+		if (c.has_flag (ProcessContext<T>::EndOfInput)) {
+			BufferWritten ();
+		}
+	}
+
+	using Sink<T>::process;
+
+	/** Read data into buffer in \a context, only the data is modified (not frame count)
+	 *  Note that the data read is output to the outputs, as well as read into the context
+	 *  \return number of frames read
+	 */
+	framecnt_t read (ProcessContext<T> & context)
+	{
+		if (throw_level (ThrowStrict) && context.channels () != _channels) {
+			throw Exception (*this, boost::str (boost::format
+				("Wrong number of channels given to read(), %1% instead of %2%")
+				% context.channels () % _channels));
+		}
+
+		framecnt_t const frames_read = std::min (context.frames (), (framecnt_t) data.size () - read_position);
+		if (frames_read > 0) {
+			TypeUtils<T>::copy (&data[read_position], context.data (), frames_read);
+			read_position += frames_read;
+		}
+
+		ProcessContext<T> c_out = context.beginning (frames_read);
+		if (frames_read < context.frames ()) {
+			c_out.set_flag (ProcessContext<T>::EndOfInput);
+		}
+		this->output (c_out);
+		return frames_read;
+	}
+
+	/// Emitted once EndOfInput has been processed, equivalent to SndfileWriter::FileWritten
+	PBD::Signal0<void> BufferWritten;
+
+  private:
+	ChannelCount   _channels;
+	std::vector<T> data;
+	framecnt_t     read_position;
+};
+
+} // namespace
+
+#endif // AUDIOGRAPHER_TMP_BUFFER_H
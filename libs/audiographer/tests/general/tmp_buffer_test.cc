@@ -0,0 +1,70 @@
+#include "tests/utils.h"
+#include "audiographer/general/tmp_buffer.h"
+
+using namespace AudioGrapher;
+
+class TmpBufferTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE (TmpBufferTest);
+  CPPUNIT_TEST (testProcess);
+  CPPUNIT_TEST (testPartialRead);
+  CPPUNIT_TEST_SUITE_END ();
+
+  public:
+	void setUp()
+	{
+		frames = 128;
+		random_data = TestUtils::init_random_data(frames);
+	}
+
+	void tearDown()
+	{
+		delete [] random_data;
+	}
+
+	void testProcess()
+	{
+		uint32_t channels = 2;
+		buffer.reset (new TmpBuffer<float>(channels, frames));
+		AllocatingProcessContext<float> c (random_data, frames, channels);
+		c.set_flag (ProcessContext<float>::EndOfInput);
+		buffer->process (c);
+		CPPUNIT_ASSERT_EQUAL (frames, buffer->get_frames_written());
+
+		TypeUtils<float>::zero_fill (c.data (), c.frames());
+
+		buffer->seek (0, SEEK_SET);
+		CPPUNIT_ASSERT_EQUAL (frames, buffer->read (c));
+		CPPUNIT_ASSERT (TestUtils::array_equals (random_data, c.data(), c.frames()));
+	}
+
+	void testPartialRead()
+	{
+		uint32_t channels = 2;
+		buffer.reset (new TmpBuffer<float>(channels));
+		ProcessContext<float> c (random_data, frames, channels);
+		buffer->process (c);
+
+		sink.reset (new AppendingVectorSink<float>());
+		buffer->add_output (sink);
+
+		AllocatingProcessContext<float> out (frames / 2, channels);
+		buffer->seek (frames / 4, SEEK_SET);
+		framecnt_t read = buffer->read (out);
+		CPPUNIT_ASSERT_EQUAL (frames / 2, read);
+		CPPUNIT_ASSERT (TestUtils::array_equals (&random_data[frames / 2], out.data(), read));
+
+		read = buffer->read (out);
+		CPPUNIT_ASSERT_EQUAL ((framecnt_t) 0, read);
+		CPPUNIT_ASSERT_EQUAL ((size_t) (frames / 2), sink->get_data().size());
+	}
+
+  private:
+	boost::shared_ptr<TmpBuffer<float> > buffer;
+	boost::shared_ptr<AppendingVectorSink<float> > sink;
+
+	float * random_data;
+	framecnt_t frames;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION (TmpBufferTest);
@@ -9,24 +9,28 @@ using namespace std;
 using namespace ArdourCanvas;
 
 static void
-test (int items_per_cell)
+test (int n_rectangles, bool moving)
 {
-	Group::default_items_per_cell = items_per_cell;
-
-	int const n_rectangles = 10000;
 	int const n_tests = 1000;
 	double const rough_size = 1000;
 	srand (1);
 
 	ImageCanvas canvas;
 
-	list<Item*> rectangles;
+	vector<Rectangle*> rectangles;
 
 	for (int i = 0; i < n_rectangles; ++i) {
 		rectangles.push_back (new Rectangle (canvas.root(), rect_random (rough_size)));
 	}
 
 	for (int i = 0; i < n_tests; ++i) {
+
+		if (moving) {
+			/* move something between lookups, as a drag would */
+			Rectangle* r = rectangles[rand() % n_rectangles];
+			r->set_position (Duple (double_random() * rough_size, double_random() * rough_size));
+		}
+
 		Duple test (double_random() * rough_size, double_random() * rough_size);
 
 		/* ask the group what's at this point */
@@ -37,14 +41,16 @@ test (int items_per_cell)
 
 int main ()
 {
-	int tests[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256 };
+	int tests[] = { 100, 1000, 10000, 100000 };
 
-	for (unsigned int i = 0; i < sizeof (tests) / sizeof (int); ++i) {
+	for (unsigned int i = 0; i < 2 * sizeof (tests) / sizeof (int); ++i) {
+		int const n = tests[i / 2];
+		bool const moving = i % 2;
 		timeval start;
 		timeval stop;
 
 		gettimeofday (&start, 0);
-		test (tests[i]);
+		test (n, moving);
 		gettimeofday (&stop, 0);
 
 		int sec = stop.tv_sec - start.tv_sec;
@@ -56,7 +62,7 @@ int main ()
 
 		double seconds = sec + ((double) usec / 1e6);
 
-		cout << "Test " << tests[i] << ": " << seconds << "\n";
+		cout << "Test " << n << (moving ? " moving" : "") << ": " << seconds << "\n";
 	}
 }
 
@@ -81,6 +81,14 @@ Canvas::add_scroller (ScrollGroup& i)
 	scrollers.push_back (&i);
 }
 
+void
+Canvas::damage_scrollers (Rect const & area)
+{
+	for (list<ScrollGroup*>::iterator i = scrollers.begin(); i != scrollers.end(); ++i) {
+		(*i)->damage (area);
+	}
+}
+
 void
 Canvas::zoomed ()
 {
@@ -1051,6 +1059,8 @@ GtkCanvas::request_redraw (Rect const & request)
 	real_area.y0 = max (0.0, min (h, request.y0));
 	real_area.y1 = max (0.0, min (h, request.y1));
 
+	damage_scrollers (real_area);
+
 	queue_draw_area (real_area.x0, real_area.y0, real_area.width(), real_area.height());
 }
 
@@ -115,6 +115,9 @@ public:
         void scroll_to (Coord x, Coord y);
 	void add_scroller (ScrollGroup& i);
 
+	/** Tell scroll groups that an area, in window coordinates, has to be rendered again */
+	void damage_scrollers (Rect const &);
+
         virtual Rect  visible_area () const = 0;
         virtual Coord width () const = 0;
         virtual Coord height () const = 0;
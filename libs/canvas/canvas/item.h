@@ -200,7 +200,7 @@ public:
 	void raise_child_to_top (Item *);
 	void raise_child (Item *, int);
 	void lower_child_to_bottom (Item *);
-	void child_changed ();
+	void child_changed (Item *);
 
 	static int default_items_per_cell;
 
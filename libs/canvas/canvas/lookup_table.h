@@ -20,7 +20,10 @@
 #ifndef __CANVAS_LOOKUP_TABLE_H__
 #define __CANVAS_LOOKUP_TABLE_H__
 
+#include <map>
+#include <set>
 #include <vector>
+#include <stdint.h>
 #include <boost/multi_array.hpp>
 
 #include "canvas/visibility.h"
@@ -42,6 +45,16 @@ public:
     virtual std::vector<Item*> items_at_point (Duple const &) const = 0;
     virtual bool has_item_at_point (Duple const & point) const = 0;
 
+    /* Notification of changes to the item's children, made after the
+       change. Each returns false if the table cannot follow the change,
+       in which case the item throws the table away and builds a new one.
+    */
+    virtual bool child_added (Item *) { return false; }
+    virtual bool child_removed (Item *) { return false; }
+    virtual bool child_changed (Item *) { return false; }
+    virtual bool child_raised_to_top (Item *) { return false; }
+    virtual bool child_lowered_to_bottom (Item *) { return false; }
+
 protected:
 
     Item const & _item;
@@ -55,6 +68,84 @@ public:
     std::vector<Item*> get (Rect const &);
     std::vector<Item*> items_at_point (Duple const &) const;
     bool has_item_at_point (Duple const & point) const;
+
+    /* nothing is cached, so there is nothing to update */
+    bool child_added (Item *) { return true; }
+    bool child_removed (Item *) { return true; }
+    bool child_changed (Item *) { return true; }
+    bool child_raised_to_top (Item *) { return true; }
+    bool child_lowered_to_bottom (Item *) { return true; }
+};
+
+/** An R-tree over the bounding boxes of an item's children, in the item's
+ *  own coordinates (so scrolling or moving the item itself does not touch
+ *  it). Changes to children are queued and applied at the next lookup,
+ *  which makes a burst of changes to one child cost a single update.
+ */
+class LIBCANVAS_API RTreeLookupTable : public LookupTable
+{
+public:
+    RTreeLookupTable (Item const &);
+    ~RTreeLookupTable ();
+
+    std::vector<Item*> get (Rect const &);
+    std::vector<Item*> items_at_point (Duple const &) const;
+    bool has_item_at_point (Duple const & point) const;
+
+    bool child_added (Item *);
+    bool child_removed (Item *);
+    bool child_changed (Item *);
+    bool child_raised_to_top (Item *);
+    bool child_lowered_to_bottom (Item *);
+
+    static const size_t max_entries = 16;
+    static const size_t min_entries = 6;
+
+  private:
+    struct Node;
+
+    struct Entry {
+        Rect    rect;
+        Node*   node;  ///< child node, or 0 in a leaf
+        Item*   item;  ///< the indexed item, in a leaf
+        int64_t order; ///< stacking order of item
+    };
+
+    struct Node {
+        Node (bool l) : leaf (l), parent (0) {}
+        ~Node ();
+        Rect extent () const;
+
+        bool leaf;
+        Node* parent;
+        std::vector<Entry> entries;
+    };
+
+    struct Child {
+        Child () : order (0), indexed_order (0), indexed (false) {}
+        Rect    rect;  ///< bounding box in the tree, if indexed
+        int64_t order; ///< current stacking order
+        int64_t indexed_order;
+        bool    indexed;
+    };
+
+    typedef std::map<Item*, Child> Children;
+    typedef std::vector<std::pair<int64_t, Item*> > Found;
+
+    void flush () const;
+    void apply_changes ();
+    void insert (Entry const &);
+    void erase (Item *, Rect const &);
+    Node* find_leaf (Node *, Item *, Rect const &) const;
+    Node* split (Node *);
+    void search (Node const *, Rect const &, Found &) const;
+    std::vector<Item*> lookup (Rect const &) const;
+
+    Node*           _root;
+    Children        _children;
+    std::set<Item*> _dirty;
+    int64_t         _top;
+    int64_t         _bottom;
 };
 
 class LIBCANVAS_API OptimizingLookupTable : public LookupTable
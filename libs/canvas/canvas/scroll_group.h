@@ -19,6 +19,10 @@
 #ifndef __CANVAS_SCROLL_GROUP_H__
 #define __CANVAS_SCROLL_GROUP_H__
 
+#include <vector>
+
+#include <cairomm/surface.h>
+
 #include "canvas/container.h"
 
 namespace ArdourCanvas {
@@ -26,6 +30,12 @@ namespace ArdourCanvas {
 /** A ScrollGroup has no contents of its own, but renders
  *  its children in a way that reflects the most recent
  *  call to its scroll_to() method.
+ *
+ *  The rendered contents are kept in an image the size of the canvas
+ *  window. Scrolling shifts that image and only renders the newly
+ *  exposed strips; other areas are only rendered again once they have
+ *  been damaged via Canvas::request_redraw(). Set
+ *  ARDOUR_CANVAS_NO_SCROLL_CACHE in the environment to disable this.
  */
 class LIBCANVAS_API ScrollGroup : public Container
 {
@@ -46,11 +56,25 @@ class LIBCANVAS_API ScrollGroup : public Container
 
 	void render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) const;
 
+	/** Mark an area, in window coordinates, as needing to be rendered again */
+	void damage (Rect const & area);
+
 	ScrollSensitivity sensitivity() const { return _scroll_sensitivity; }
 
   private:
 	ScrollSensitivity _scroll_sensitivity;
 	Duple             _scroll_offset;
+
+	void update_cache (Rect const & area) const;
+	void shift_cache (Duple const & delta) const;
+	void add_dirty (Rect const &) const;
+
+	/** our children as last rendered, in window coordinates at _cached_offset */
+	mutable Cairo::RefPtr<Cairo::ImageSurface> _cache;
+	mutable Cairo::RefPtr<Cairo::ImageSurface> _spare;
+	mutable Duple                              _cached_offset;
+	/** areas of _cache that are out of date */
+	mutable std::vector<Rect>                  _dirty;
 };
 
 }
@@ -280,7 +280,7 @@ Item::set_position (Duple p)
 
 
 		if (_parent) {
-			_parent->child_changed ();
+			_parent->child_changed (this);
 		}
 	}
 }
@@ -378,7 +378,7 @@ Item::propagate_show_hide ()
 	/* bounding box may have changed while we were hidden */
 
 	if (_parent) {
-		_parent->child_changed ();
+		_parent->child_changed (this);
 	}
 
 	_canvas->item_shown_or_hidden (this);
@@ -626,7 +626,7 @@ Item::end_change ()
 		_canvas->item_changed (this, _pre_change_bounding_box);
 
 		if (_parent) {
-			_parent->child_changed ();
+			_parent->child_changed (this);
 		}
 	}
 }
@@ -863,8 +863,16 @@ Item::add (Item* i)
 
 	_items.push_back (i);
 	i->reparent (this);
-	invalidate_lut ();
+	if (_lut && !_lut->child_added (i)) {
+		invalidate_lut ();
+	}
 	_bounding_box_dirty = true;
+
+	/* our own bounding box may have grown, and our parent indexes it */
+
+	if (_parent) {
+		_parent->child_changed (this);
+	}
 }
 
 void
@@ -889,7 +897,9 @@ Item::remove (Item* i)
 
 	i->unparent ();
 	_items.remove (i);
-	invalidate_lut ();
+	if (_lut && !_lut->child_removed (i)) {
+		invalidate_lut ();
+	}
 	_bounding_box_dirty = true;
 
 	end_change ();
@@ -946,7 +956,9 @@ Item::raise_child_to_top (Item* i)
 	_items.remove (i);
 	_items.push_back (i);
 
-	invalidate_lut ();
+	if (_lut && !_lut->child_raised_to_top (i)) {
+		invalidate_lut ();
+	}
         redraw ();
 }
 
@@ -979,7 +991,9 @@ Item::lower_child_to_bottom (Item* i)
 	}
 	_items.remove (i);
 	_items.push_front (i);
-	invalidate_lut ();
+	if (_lut && !_lut->child_lowered_to_bottom (i)) {
+		invalidate_lut ();
+	}
         redraw ();
 }
 
@@ -987,7 +1001,7 @@ void
 Item::ensure_lut () const
 {
 	if (!_lut) {
-		_lut = new DumbLookupTable (*this);
+		_lut = new RTreeLookupTable (*this);
 	}
 }
 
@@ -999,13 +1013,15 @@ Item::invalidate_lut () const
 }
 
 void
-Item::child_changed ()
+Item::child_changed (Item* child)
 {
-	invalidate_lut ();
+	if (_lut && !_lut->child_changed (child)) {
+		invalidate_lut ();
+	}
 	_bounding_box_dirty = true;
 
 	if (_parent) {
-		_parent->child_changed ();
+		_parent->child_changed (this);
 	}
 }
 
@@ -17,6 +17,9 @@
     Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 */
 
+#include <algorithm>
+#include <cassert>
+
 #include "canvas/item.h"
 #include "canvas/lookup_table.h"
 
@@ -103,6 +106,484 @@ DumbLookupTable::has_item_at_point (Duple const & point) const
 	return false;
 }
 
+/* RTreeLookupTable: a Guttman R-tree with quadratic split. Costs are
+ * measured in half-perimeters rather than areas, since bounding boxes of
+ * canvas items may extend to COORD_MAX and areas would overflow.
+ */
+
+static inline Distance
+margin (Rect const & r)
+{
+	return r.width() + r.height();
+}
+
+static inline bool
+overlaps (Rect const & a, Rect const & b)
+{
+	return a.x0 <= b.x1 && b.x0 <= a.x1 && a.y0 <= b.y1 && b.y0 <= a.y1;
+}
+
+static inline bool
+encloses (Rect const & outer, Rect const & inner)
+{
+	return outer.x0 <= inner.x0 && outer.y0 <= inner.y0 && outer.x1 >= inner.x1 && outer.y1 >= inner.y1;
+}
+
+RTreeLookupTable::Node::~Node ()
+{
+	if (!leaf) {
+		for (vector<Entry>::iterator i = entries.begin(); i != entries.end(); ++i) {
+			delete i->node;
+		}
+	}
+}
+
+Rect
+RTreeLookupTable::Node::extent () const
+{
+	assert (!entries.empty ());
+
+	Rect r = entries.front().rect;
+	for (vector<Entry>::const_iterator i = entries.begin() + 1; i != entries.end(); ++i) {
+		r = r.extend (i->rect);
+	}
+	return r;
+}
+
+RTreeLookupTable::RTreeLookupTable (Item const & item)
+	: LookupTable (item)
+	, _root (new Node (true))
+	, _top (0)
+	, _bottom (0)
+{
+	list<Item*> const & items = _item.items ();
+
+	for (list<Item*>::const_iterator i = items.begin(); i != items.end(); ++i) {
+		Child& c (_children[*i]);
+		c.order = ++_top;
+		_dirty.insert (*i);
+	}
+}
+
+RTreeLookupTable::~RTreeLookupTable ()
+{
+	delete _root;
+}
+
+bool
+RTreeLookupTable::child_added (Item* i)
+{
+	Child& c (_children[i]);
+	c.order = ++_top;
+	_dirty.insert (i);
+	return true;
+}
+
+bool
+RTreeLookupTable::child_removed (Item* i)
+{
+	/* i may be half-way through destruction, so only use what we stored */
+
+	Children::iterator c = _children.find (i);
+
+	if (c != _children.end()) {
+		if (c->second.indexed) {
+			erase (i, c->second.rect);
+		}
+		_children.erase (c);
+	}
+
+	_dirty.erase (i);
+	return true;
+}
+
+bool
+RTreeLookupTable::child_changed (Item* i)
+{
+	if (_children.find (i) == _children.end()) {
+		return false;
+	}
+	_dirty.insert (i);
+	return true;
+}
+
+bool
+RTreeLookupTable::child_raised_to_top (Item* i)
+{
+	Children::iterator c = _children.find (i);
+	if (c == _children.end()) {
+		return false;
+	}
+	c->second.order = ++_top;
+	_dirty.insert (i);
+	return true;
+}
+
+bool
+RTreeLookupTable::child_lowered_to_bottom (Item* i)
+{
+	Children::iterator c = _children.find (i);
+	if (c == _children.end()) {
+		return false;
+	}
+	c->second.order = --_bottom;
+	_dirty.insert (i);
+	return true;
+}
+
+void
+RTreeLookupTable::flush () const
+{
+	if (!_dirty.empty()) {
+		const_cast<RTreeLookupTable*> (this)->apply_changes ();
+	}
+}
+
+void
+RTreeLookupTable::apply_changes ()
+{
+	for (set<Item*>::const_iterator i = _dirty.begin(); i != _dirty.end(); ++i) {
+
+		Child& c (_children[*i]);
+		boost::optional<Rect> bbox = (*i)->bounding_box ();
+		Rect r;
+
+		if (bbox) {
+			r = (*i)->item_to_parent (bbox.get());
+		}
+
+		if (c.indexed) {
+			if (bbox && !(r != c.rect) && c.order == c.indexed_order) {
+				continue;
+			}
+			erase (*i, c.rect);
+			c.indexed = false;
+		}
+
+		if (bbox) {
+			Entry e;
+			e.rect = r;
+			e.node = 0;
+			e.item = *i;
+			e.order = c.order;
+			insert (e);
+
+			c.rect = r;
+			c.indexed_order = c.order;
+			c.indexed = true;
+		}
+	}
+
+	_dirty.clear ();
+}
+
+void
+RTreeLookupTable::insert (Entry const & e)
+{
+	/* descend to the leaf whose extent grows least */
+
+	Node* n = _root;
+
+	while (!n->leaf) {
+		Entry* best = 0;
+		Distance best_growth = 0;
+		Distance best_margin = 0;
+
+		for (vector<Entry>::iterator i = n->entries.begin(); i != n->entries.end(); ++i) {
+			Distance const m = margin (i->rect);
+			Distance const growth = margin (i->rect.extend (e.rect)) - m;
+			if (!best || growth < best_growth || (growth == best_growth && m < best_margin)) {
+				best = &(*i);
+				best_growth = growth;
+				best_margin = m;
+			}
+		}
+
+		n = best->node;
+	}
+
+	n->entries.push_back (e);
+
+	/* walk back up, fixing extents and splitting full nodes */
+
+	while (n) {
+		Node* sibling = 0;
+
+		if (n->entries.size() > max_entries) {
+			sibling = split (n);
+		}
+
+		Node* p = n->parent;
+
+		if (!p) {
+			if (sibling) {
+				_root = new Node (false);
+
+				Entry a;
+				a.rect = n->extent ();
+				a.node = n;
+				a.item = 0;
+				a.order = 0;
+				Entry b (a);
+				b.rect = sibling->extent ();
+				b.node = sibling;
+
+				_root->entries.push_back (a);
+				_root->entries.push_back (b);
+				n->parent = _root;
+				sibling->parent = _root;
+			}
+			break;
+		}
+
+		for (vector<Entry>::iterator i = p->entries.begin(); i != p->entries.end(); ++i) {
+			if (i->node == n) {
+				i->rect = n->extent ();
+				break;
+			}
+		}
+
+		if (sibling) {
+			Entry s;
+			s.rect = sibling->extent ();
+			s.node = sibling;
+			s.item = 0;
+			s.order = 0;
+			sibling->parent = p;
+			p->entries.push_back (s);
+		}
+
+		n = p;
+	}
+}
+
+RTreeLookupTable::Node*
+RTreeLookupTable::split (Node* n)
+{
+	vector<Entry> all;
+	all.swap (n->entries);
+
+	/* seeds: the pair that would waste most if kept together */
+
+	size_t s1 = 0;
+	size_t s2 = 1;
+	Distance worst = -COORD_MAX;
+
+	for (size_t i = 0; i < all.size(); ++i) {
+		for (size_t j = i + 1; j < all.size(); ++j) {
+			Distance const waste = margin (all[i].rect.extend (all[j].rect)) - margin (all[i].rect) - margin (all[j].rect);
+			if (waste > worst) {
+				worst = waste;
+				s1 = i;
+				s2 = j;
+			}
+		}
+	}
+
+	Node* m = new Node (n->leaf);
+
+	n->entries.push_back (all[s1]);
+	m->entries.push_back (all[s2]);
+	Rect a = all[s1].rect;
+	Rect b = all[s2].rect;
+	size_t left = all.size() - 2;
+
+	for (size_t i = 0; i < all.size(); ++i) {
+
+		if (i == s1 || i == s2) {
+			continue;
+		}
+
+		bool to_n;
+
+		if (n->entries.size() + left <= min_entries) {
+			to_n = true;
+		} else if (m->entries.size() + left <= min_entries) {
+			to_n = false;
+		} else {
+			Distance const ga = margin (a.extend (all[i].rect)) - margin (a);
+			Distance const gb = margin (b.extend (all[i].rect)) - margin (b);
+			if (ga != gb) {
+				to_n = ga < gb;
+			} else {
+				to_n = n->entries.size() <= m->entries.size();
+			}
+		}
+
+		if (to_n) {
+			n->entries.push_back (all[i]);
+			a = a.extend (all[i].rect);
+		} else {
+			m->entries.push_back (all[i]);
+			b = b.extend (all[i].rect);
+		}
+
+		--left;
+	}
+
+	if (!m->leaf) {
+		for (vector<Entry>::iterator i = m->entries.begin(); i != m->entries.end(); ++i) {
+			i->node->parent = m;
+		}
+	}
+
+	return m;
+}
+
+RTreeLookupTable::Node*
+RTreeLookupTable::find_leaf (Node* n, Item* item, Rect const & r) const
+{
+	for (vector<Entry>::iterator i = n->entries.begin(); i != n->entries.end(); ++i) {
+		if (n->leaf) {
+			if (i->item == item) {
+				return n;
+			}
+		} else if (encloses (i->rect, r)) {
+			Node* l = find_leaf (i->node, item, r);
+			if (l) {
+				return l;
+			}
+		}
+	}
+
+	return 0;
+}
+
+void
+RTreeLookupTable::erase (Item* item, Rect const & r)
+{
+	Node* n = find_leaf (_root, item, r);
+
+	if (!n) {
+		return;
+	}
+
+	for (vector<Entry>::iterator i = n->entries.begin(); i != n->entries.end(); ++i) {
+		if (i->item == item) {
+			n->entries.erase (i);
+			break;
+		}
+	}
+
+	/* Shrink extents on the way up and drop empty nodes. Underfull nodes
+	 * are kept rather than reinserted; children tend to move by small
+	 * amounts, and a restack rebuilds the whole table anyway.
+	 */
+
+	while (n->parent) {
+		Node* p = n->parent;
+
+		for (vector<Entry>::iterator i = p->entries.begin(); i != p->entries.end(); ++i) {
+			if (i->node == n) {
+				if (n->entries.empty()) {
+					p->entries.erase (i);
+					delete n;
+				} else {
+					i->rect = n->extent ();
+				}
+				break;
+			}
+		}
+
+		n = p;
+	}
+
+	while (!_root->leaf && _root->entries.size() < 2) {
+		Node* old = _root;
+		if (old->entries.empty()) {
+			_root = new Node (true);
+		} else {
+			_root = old->entries.front().node;
+			_root->parent = 0;
+			old->entries.clear ();
+		}
+		delete old;
+	}
+}
+
+void
+RTreeLookupTable::search (Node const * n, Rect const & r, Found& found) const
+{
+	for (vector<Entry>::const_iterator i = n->entries.begin(); i != n->entries.end(); ++i) {
+		if (overlaps (i->rect, r)) {
+			if (n->leaf) {
+				found.push_back (make_pair (i->order, i->item));
+			} else {
+				search (i->node, r, found);
+			}
+		}
+	}
+}
+
+vector<Item*>
+RTreeLookupTable::lookup (Rect const & r) const
+{
+	flush ();
+
+	Found found;
+	search (_root, r, found);
+
+	/* callers expect stacking order, lowest first */
+	sort (found.begin(), found.end());
+
+	vector<Item*> vitems;
+	vitems.reserve (found.size());
+	for (Found::const_iterator i = found.begin(); i != found.end(); ++i) {
+		vitems.push_back (i->second);
+	}
+	return vitems;
+}
+
+vector<Item*>
+RTreeLookupTable::get (Rect const & area)
+{
+	/* area is in window coordinates; allow for the rounding that
+	   item_to_window() applies when callers check our results.
+	*/
+	return lookup (_item.window_to_item (area).expand (1.0));
+}
+
+vector<Item*>
+RTreeLookupTable::items_at_point (Duple const & point) const
+{
+	/* Point is in window coordinate system */
+
+	Duple const p = _item.window_to_item (point);
+	vector<Item*> vitems = lookup (Rect (p.x, p.y, p.x, p.y).expand (0.5));
+	vector<Item*>::iterator i = vitems.begin();
+
+	for (vector<Item*>::iterator j = vitems.begin(); j != vitems.end(); ++j) {
+		if ((*j)->covers (point)) {
+			*i++ = *j;
+		}
+	}
+
+	vitems.erase (i, vitems.end());
+	return vitems;
+}
+
+bool
+RTreeLookupTable::has_item_at_point (Duple const & point) const
+{
+	/* Point is in window coordinate system */
+
+	Duple const p = _item.window_to_item (point);
+	vector<Item*> vitems = lookup (Rect (p.x, p.y, p.x, p.y).expand (0.5));
+
+	for (vector<Item*>::const_iterator i = vitems.begin(); i != vitems.end(); ++i) {
+
+		if (!(*i)->visible()) {
+			continue;
+		}
+
+		if ((*i)->covers (point)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 OptimizingLookupTable::OptimizingLookupTable (Item const & item, int items_per_cell)
 	: LookupTable (item)
 	, _items_per_cell (items_per_cell)
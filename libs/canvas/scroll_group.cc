@@ -18,6 +18,11 @@
 
 #include <iostream>
 
+#include <cmath>
+#include <cstdlib>
+
+#include <cairomm/context.h>
+
 #include "pbd/compose.h"
 
 #include "canvas/canvas.h"
@@ -27,6 +32,21 @@
 using namespace std;
 using namespace ArdourCanvas;
 
+/* beyond this many separate dirty areas, render their union instead */
+static const size_t max_dirty_rects = 16;
+
+static bool
+use_cache ()
+{
+	static int use = -1;
+
+	if (use < 0) {
+		use = getenv ("ARDOUR_CANVAS_NO_SCROLL_CACHE") ? 0 : 1;
+	}
+
+	return use;
+}
+
 ScrollGroup::ScrollGroup (Canvas* c, ScrollSensitivity s)
 	: Container (c)
 	, _scroll_sensitivity (s)
@@ -60,13 +80,208 @@ ScrollGroup::render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) c
 	self.x1 = min (_position.x + _canvas->width(), self.x1);
 	self.y1 = min (_position.y + _canvas->height(), self.y1);
 
+	if (!use_cache ()) {
+		context->save ();
+		context->rectangle (self.x0, self.y0, self.width(), self.height());
+		context->clip ();
+
+		Container::render (area, context);
+
+		context->restore ();
+		return;
+	}
+
+	boost::optional<Rect> draw = self.intersection (area);
+
+	if (!draw || draw->width() <= 0 || draw->height() <= 0) {
+		return;
+	}
+
+	update_cache (draw.get());
+
 	context->save ();
-	context->rectangle (self.x0, self.y0, self.width(), self.height());
+	context->rectangle (draw->x0, draw->y0, draw->width(), draw->height());
 	context->clip ();
+	context->set_source (_cache, 0, 0);
+	context->paint ();
+	context->restore ();
+}
 
-	Container::render (area, context);
+/** Bring the cached image up to date within @param area (in window
+ *  coordinates), rendering only what scrolling exposed or what was damaged.
+ */
+void
+ScrollGroup::update_cache (Rect const & area) const
+{
+	int const w = (int) ceil (_canvas->width ());
+	int const h = (int) ceil (_canvas->height ());
 
-	context->restore ();
+	if (!_cache || _cache->get_width () != w || _cache->get_height () != h) {
+		_cache = Cairo::ImageSurface::create (Cairo::FORMAT_ARGB32, w, h);
+		_spare.clear ();
+		_cached_offset = _scroll_offset;
+		_dirty.clear ();
+		_dirty.push_back (Rect (0, 0, w, h));
+	}
+
+	if (_cached_offset != _scroll_offset) {
+		/* contents move the opposite way to the scroll offset */
+		shift_cache (_cached_offset - _scroll_offset);
+		_cached_offset = _scroll_offset;
+	}
+
+	if (_dirty.empty ()) {
+		return;
+	}
+
+	vector<Rect> dirty;
+	dirty.swap (_dirty);
+
+	Cairo::RefPtr<Cairo::Context> cc;
+
+	for (vector<Rect>::const_iterator d = dirty.begin(); d != dirty.end(); ++d) {
+
+		boost::optional<Rect> i = d->intersection (area);
+
+		if (!i || i->width() <= 0 || i->height() <= 0) {
+			_dirty.push_back (*d);
+			continue;
+		}
+
+		/* render whole pixels, so that nothing is left half-drawn
+		 * at the edge of what we render.
+		 */
+
+		Rect const r (floor (i->x0), floor (i->y0), ceil (i->x1), ceil (i->y1));
+
+		if (!cc) {
+			cc = Cairo::Context::create (_cache);
+		}
+
+		cc->save ();
+		cc->rectangle (r.x0, r.y0, r.width(), r.height());
+		cc->clip ();
+		cc->set_operator (Cairo::OPERATOR_CLEAR);
+		cc->paint ();
+		cc->set_operator (Cairo::OPERATOR_OVER);
+		Container::render (r, cc);
+		cc->restore ();
+
+		/* keep whatever of the dirty area was not rendered */
+
+		if (r.y0 > d->y0) {
+			_dirty.push_back (Rect (d->x0, d->y0, d->x1, r.y0));
+		}
+		if (r.y1 < d->y1) {
+			_dirty.push_back (Rect (d->x0, r.y1, d->x1, d->y1));
+		}
+
+		Coord const y0 = max (d->y0, r.y0);
+		Coord const y1 = min (d->y1, r.y1);
+
+		if (y1 > y0) {
+			if (r.x0 > d->x0) {
+				_dirty.push_back (Rect (d->x0, y0, r.x0, y1));
+			}
+			if (r.x1 < d->x1) {
+				_dirty.push_back (Rect (r.x1, y0, d->x1, y1));
+			}
+		}
+	}
+
+	if (_dirty.size() > max_dirty_rects) {
+		Rect u = _dirty.front ();
+		for (vector<Rect>::const_iterator d = _dirty.begin(); d != _dirty.end(); ++d) {
+			u = u.extend (*d);
+		}
+		_dirty.clear ();
+		_dirty.push_back (u);
+	}
+}
+
+/** Move the cached image by @param delta pixels and mark the area that
+ *  this uncovers as dirty.
+ */
+void
+ScrollGroup::shift_cache (Duple const & delta) const
+{
+	int const w = _cache->get_width ();
+	int const h = _cache->get_height ();
+
+	if (delta.x != rint (delta.x) || delta.y != rint (delta.y) || fabs (delta.x) >= w || fabs (delta.y) >= h) {
+		/* cannot re-use any of it */
+		_dirty.clear ();
+		_dirty.push_back (Rect (0, 0, w, h));
+		return;
+	}
+
+	if (!_spare) {
+		_spare = Cairo::ImageSurface::create (Cairo::FORMAT_ARGB32, w, h);
+	}
+
+	Cairo::RefPtr<Cairo::Context> cc = Cairo::Context::create (_spare);
+	cc->set_operator (Cairo::OPERATOR_SOURCE);
+	cc->set_source (_cache, delta.x, delta.y);
+	cc->paint ();
+
+	_cache.swap (_spare);
+
+	for (vector<Rect>::iterator d = _dirty.begin(); d != _dirty.end(); ++d) {
+		*d = d->translate (delta);
+	}
+
+	if (delta.x > 0) {
+		add_dirty (Rect (0, 0, delta.x, h));
+	} else if (delta.x < 0) {
+		add_dirty (Rect (w + delta.x, 0, w, h));
+	}
+
+	if (delta.y > 0) {
+		add_dirty (Rect (0, 0, w, delta.y));
+	} else if (delta.y < 0) {
+		add_dirty (Rect (0, h + delta.y, w, h));
+	}
+}
+
+void
+ScrollGroup::add_dirty (Rect const & r) const
+{
+	if (r.width() <= 0 || r.height() <= 0) {
+		return;
+	}
+
+	for (vector<Rect>::iterator d = _dirty.begin(); d != _dirty.end(); ++d) {
+		if (r.x0 >= d->x0 && r.y0 >= d->y0 && r.x1 <= d->x1 && r.y1 <= d->y1) {
+			/* already covered */
+			return;
+		}
+	}
+
+	if (_dirty.size() >= max_dirty_rects) {
+		Rect u = r;
+		for (vector<Rect>::const_iterator d = _dirty.begin(); d != _dirty.end(); ++d) {
+			u = u.extend (*d);
+		}
+		_dirty.clear ();
+		_dirty.push_back (u);
+		return;
+	}
+
+	_dirty.push_back (r);
+}
+
+void
+ScrollGroup::damage (Rect const & area)
+{
+	if (!_cache) {
+		return;
+	}
+
+	/* @param area is relative to the current scroll offset, which may
+	 * differ from the one that the cache was rendered at.
+	 */
+
+	add_dirty (area.translate (_scroll_offset - _cached_offset));
 }
 
 void
@@ -245,6 +245,7 @@ public:
 	void create_curve();
 	void destroy_curve();
 
+	bool         has_curve() const { return _curve != 0; }
 	Curve&       curve()       { assert(_curve); return *_curve; }
 	const Curve& curve() const { assert(_curve); return *_curve; }
 
@@ -20,7 +20,11 @@
 #define EVORAL_CURVE_HPP
 
 #include <inttypes.h>
+#include <vector>
+
 #include <boost/utility.hpp>
+#include <glib.h>
+#include <glibmm/threads.h>
 
 #include "evoral/visibility.h"
 
@@ -36,9 +40,12 @@ public:
 	bool rt_safe_get_vector (double x0, double x1, float *arg, int32_t veclen);
 	void get_vector (double x0, double x1, float *arg, int32_t veclen);
 
+	void render (double x0, int64_t len);
+	bool render_wanted (double x, int64_t len) const;
+
 	void solve ();
 
-	void mark_dirty() const { _dirty = true; }
+	void mark_dirty() const { _dirty = true; g_atomic_int_inc (&_generation); }
 
 private:
 	double unlocked_eval (double where);
@@ -46,8 +53,30 @@ private:
 
 	void _get_vector (double x0, double x1, float *arg, int32_t veclen);
 
+	/** Values at every whole x in [x0, x0 + len), as of list edit @a generation */
+	struct Rendered {
+		Rendered () : x0 (0), len (0), generation (0) {}
+
+		double             x0;
+		int64_t            len;
+		gint               generation;
+		std::vector<float> data;
+	};
+
+	bool get_rendered (double x0, double x1, float* vec, int32_t veclen, bool allow_stale);
+
 	mutable bool       _dirty;
 	const ControlList& _list;
+
+	/* render() fills the unpublished one of these two and then publishes
+	 * it; rt_safe_get_vector() registers as a reader of the published one
+	 * while copying from it, so that it is not refilled underneath it.
+	 */
+	Rendered             _rendered[2];
+	volatile gint        _published; ///< index into _rendered, or -1
+	volatile gint        _readers[2];
+	mutable volatile gint _generation;
+	Glib::Threads::Mutex _render_lock;
 };
 
 } // namespace Evoral
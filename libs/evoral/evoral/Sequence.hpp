@@ -25,6 +25,7 @@
 #include <list>
 #include <utility>
 #include <boost/shared_ptr.hpp>
+#include <boost/pool/pool_alloc.hpp>
 #include <glibmm/threads.h>
 
 #include "evoral/visibility.h"
@@ -152,7 +153,13 @@ public:
 		}
 	};
 
-	typedef std::multiset<NotePtr, EarlierNoteComparator> Notes;
+	/** Notes and the nodes of the time index are small, numerous and
+	 *  long-lived, so they are carved out of shared pools rather than
+	 *  allocated one at a time.
+	 */
+	typedef boost::fast_pool_allocator<Note<Time> > NoteAllocator;
+
+	typedef std::multiset<NotePtr, EarlierNoteComparator, boost::fast_pool_allocator<NotePtr> > Notes;
 	inline       Notes& notes()       { return _notes; }
 	inline const Notes& notes() const { return _notes; }
 
@@ -325,9 +332,14 @@ protected:
 		return 0;
 	}
 
-	typedef std::multiset<NotePtr, NoteNumberComparator>  Pitches;
-	inline       Pitches& pitches(uint8_t chan)       { return _pitches[chan&0xf]; }
-	inline const Pitches& pitches(uint8_t chan) const { return _pitches[chan&0xf]; }
+	/** Notes of one channel and pitch, in time order */
+	typedef std::vector<NotePtr> Pitches;
+
+	inline const Pitches& pitches(uint8_t chan, uint8_t note) const {
+		static const Pitches none;
+		const std::vector<Pitches>& p (_pitches[chan&0xf]);
+		return p.empty() ? none : p[note&0x7f];
+	}
 
 	virtual void control_list_marked_dirty ();
 
@@ -343,17 +355,24 @@ private:
 	void append_sysex_unlocked(const MIDIEvent<Time>& ev, Evoral::event_id_t);
 	void append_patch_change_unlocked(const PatchChange<Time>&, Evoral::event_id_t);
 
+	void add_to_pitches (const NotePtr note);
+	bool remove_from_pitches (const constNotePtr note, bool by_id);
+	void rebuild_pitches ();
+
 	void get_notes_by_pitch (Notes&, NoteOperator, uint8_t val, int chan_mask = 0) const;
 	void get_notes_by_velocity (Notes&, NoteOperator, uint8_t val, int chan_mask = 0) const;
 
 	const TypeMap& _type_map;
 
-	Notes        _notes;       // notes indexed by time
-	Pitches      _pitches[16]; // notes indexed by channel+pitch
+	Notes                _notes;       // notes indexed by time
+	std::vector<Pitches> _pitches[16]; // notes indexed by channel+pitch, sized on first use
 	SysExes      _sysexes;
 	PatchChanges _patch_changes;
 
-	typedef std::multiset<NotePtr, EarlierNoteComparator> WriteNotes;
+	/* unresolved note ons while writing; append() is in time order, so
+	 * these are too.
+	 */
+	typedef std::vector<NotePtr> WriteNotes;
 	WriteNotes _write_notes[16];
 
 	/** Current bank number on each channel so that we know what
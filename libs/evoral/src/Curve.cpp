@@ -22,6 +22,7 @@
 #include <climits>
 #include <cfloat>
 #include <cmath>
+#include <cstring>
 #include <vector>
 
 #include <glibmm/threads.h>
@@ -38,7 +39,11 @@ namespace Evoral {
 Curve::Curve (const ControlList& cl)
 	: _dirty (true)
 	, _list (cl)
+	, _published (-1)
+	, _generation (0)
 {
+	_readers[0] = 0;
+	_readers[1] = 0;
 }
 
 void
@@ -171,16 +176,122 @@ Curve::solve ()
 bool
 Curve::rt_safe_get_vector (double x0, double x1, float *vec, int32_t veclen)
 {
+	if (get_rendered (x0, x1, vec, veclen, false)) {
+		return true;
+	}
+
 	Glib::Threads::RWLock::ReaderLock lm(_list.lock(), Glib::Threads::TRY_LOCK);
 
 	if (!lm.locked()) {
-		return false;
+		/* the list is being edited: values from before the edit are
+		 * better than none at all
+		 */
+		return get_rendered (x0, x1, vec, veclen, true);
 	} else {
 		_get_vector (x0, x1, vec, veclen);
 		return true;
 	}
 }
 
+/** Copy pre-rendered values for a request of one value per whole x.
+ *  Realtime safe.
+ *  @param allow_stale true to accept values rendered before the list was last changed.
+ *  @return false if the request is not covered by the rendered values.
+ */
+bool
+Curve::get_rendered (double x0, double x1, float* vec, int32_t veclen, bool allow_stale)
+{
+	if (veclen <= 0 || x1 - x0 != veclen) {
+		return false;
+	}
+
+	int const idx = g_atomic_int_get (&_published);
+
+	if (idx < 0) {
+		return false;
+	}
+
+	g_atomic_int_inc (&_readers[idx]);
+
+	bool ok = false;
+
+	/* render() may have published the other buffer and be about to
+	 * refill this one: only go ahead if it is still the published one.
+	 */
+
+	if (g_atomic_int_get (&_published) == idx) {
+
+		Rendered const & r (_rendered[idx]);
+		double const d = x0 - r.x0;
+		int64_t const offset = (int64_t) d;
+
+		if ((allow_stale || r.generation == g_atomic_int_get (&_generation))
+		    && d == offset && offset >= 0 && offset + veclen <= r.len) {
+			memcpy (vec, &r.data[offset], sizeof (float) * veclen);
+			ok = true;
+		}
+	}
+
+	g_atomic_int_add (&_readers[idx], -1);
+
+	return ok;
+}
+
+/** Render the values at every whole x in [x0, x0 + len) for
+ *  rt_safe_get_vector() to use.  Not realtime safe.
+ */
+void
+Curve::render (double x0, int64_t len)
+{
+	if (len < 2) {
+		return;
+	}
+
+	Glib::Threads::Mutex::Lock rl (_render_lock);
+
+	int const idx = (g_atomic_int_get (&_published) == 0) ? 1 : 0;
+
+	/* a reader that started on this buffer before the previous render
+	 * published the other one is only ever copying a few values.
+	 */
+	while (g_atomic_int_get (&_readers[idx])) {
+		g_usleep (10);
+	}
+
+	Rendered& r (_rendered[idx]);
+
+	r.data.resize (len);
+
+	{
+		Glib::Threads::RWLock::ReaderLock lm (_list.lock());
+		r.generation = g_atomic_int_get (&_generation);
+		_get_vector (x0, x0 + len - 1, &r.data[0], len);
+	}
+
+	r.x0 = x0;
+	r.len = len;
+
+	g_atomic_int_set (&_published, idx);
+}
+
+/** @return true if the rendered values do not cover [x, x + len), or
+ *  the list has changed since they were rendered.  Only meaningful in
+ *  the thread that calls render().
+ */
+bool
+Curve::render_wanted (double x, int64_t len) const
+{
+	int const idx = g_atomic_int_get (&_published);
+
+	if (idx < 0) {
+		return true;
+	}
+
+	Rendered const & r (_rendered[idx]);
+
+	return r.generation != g_atomic_int_get (&_generation) || x < r.x0 || x + len > r.x0 + r.len;
+}
+
 void
 Curve::get_vector (double x0, double x1, float *vec, int32_t veclen)
 {
@@ -24,6 +24,8 @@
 #include <stdint.h>
 #include <cstdio>
 
+#include <boost/make_shared.hpp>
+
 #if __clang__
 #include "evoral/Note.hpp"
 #endif
@@ -56,6 +58,17 @@ static double const time_between_interpolated_controller_outputs = 1.0 / 256;
 
 namespace Evoral {
 
+/* orders notes by time without copying shared pointers, for the per-pitch
+ * vectors.
+ */
+template<typename Time>
+struct NoteTimeLess {
+	typedef boost::shared_ptr<Note<Time> > NotePtr;
+
+	bool operator() (const NotePtr& a, const NotePtr& b) const { return a->time() < b->time(); }
+	bool operator() (const NotePtr& a, Time t) const { return a->time() < t; }
+};
+
 // Read iterator (const_iterator)
 
 template<typename Time>
@@ -490,10 +503,12 @@ Sequence<Time>::Sequence(const Sequence<Time>& other)
 	, _highest_note(other._highest_note)
 {
 	for (typename Notes::const_iterator i = other._notes.begin(); i != other._notes.end(); ++i) {
-		NotePtr n (new Note<Time> (**i));
-		_notes.insert (n);
+		NotePtr n (boost::allocate_shared<Note<Time> > (NoteAllocator(), **i));
+		_notes.insert (_notes.end(), n);
 	}
 
+	rebuild_pitches ();
+
 	for (typename SysExes::const_iterator i = other._sysexes.begin(); i != other._sysexes.end(); ++i) {
 		boost::shared_ptr<Event<Time> > n (new Event<Time> (**i, true));
 		_sysexes.insert (n);
@@ -598,6 +613,9 @@ Sequence<Time>::clear()
 {
 	WriteLock lock(write_lock());
 	_notes.clear();
+	for (int i = 0; i < 16; ++i) {
+		_pitches[i].clear();
+	}
 	for (Controls::iterator li = _controls.begin(); li != _controls.end(); ++li)
 		li->second->list()->clear();
 }
@@ -649,13 +667,15 @@ Sequence<Time>::end_write (StuckNoteOption option, Time when)
 				break;
 			case DeleteStuckNotes:
 				cerr << "WARNING: Stuck note lost: " << (*n)->note() << endl;
+				remove_from_pitches (*n, false);
 				_notes.erase(n);
 				break;
 			case ResolveStuckNotes:
 				if (when <= (*n)->time()) {
 					cerr << "WARNING: Stuck note resolution - end time @ "
 					     << when << " is before note on: " << (**n) << endl;
-					_notes.erase (*n);
+					remove_from_pitches (*n, false);
+					_notes.erase (n);
 				} else {
 					(*n)->set_length (when - (*n)->time());
 					cerr << "WARNING: resolved note-on with no note-off to generate " << (**n) << endl;
@@ -699,7 +719,7 @@ Sequence<Time>::add_note_unlocked(const NotePtr note, void* arg)
 		_highest_note = note->note();
 
 	_notes.insert (note);
-	_pitches[note->channel()].insert (note);
+	add_to_pitches (note);
 
 	_edited = true;
 
@@ -793,45 +813,11 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 
 	if (erased) {
 
-		Pitches& p (pitches (note->channel()));
-
-		typename Pitches::iterator j;
-
 		/* if we had to ID-match above, we can't expect to find it in
-		 * pitches via note comparison either. so do another linear
-		 * search to locate it. otherwise, we can use the note index
-		 * to potentially speed things up.
+		 * pitches via its time either.
 		 */
 
-		if (id_matched) {
-
-			for (j = p.begin(); j != p.end(); ++j) {
-				if ((*j)->id() == note->id()) {
-					p.erase (j);
-					break;
-				}
-			}
-
-		} else {
-
-			/* Now find the same note in the "pitches" list (which indexes
-			 * notes by channel+time. We care only about its note number
-			 * so the search_note has all other properties unset.
-			 */
-
-			NotePtr search_note (new Note<Time>(0, Time(), Time(), note->note(), 0));
-
-			for (j = p.lower_bound (search_note); j != p.end() && (*j)->note() == note->note(); ++j) {
-
-				if ((*j) == note) {
-					DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1\terasing pitch %2 @ %3\n", this, (int)(*j)->note(), (*j)->time()));
-					p.erase (j);
-					break;
-				}
-			}
-		}
-
-		if (j == p.end()) {
+		if (!remove_from_pitches (note, id_matched)) {
 			warning << string_compose ("erased note %1 not found in pitches for channel %2", *note, (int) note->channel()) << endmsg;
 		}
 
@@ -970,14 +956,14 @@ Sequence<Time>::append_note_on_unlocked (const MIDIEvent<Time>& ev, event_id_t e
 		return;
 	}
 
-	NotePtr note(new Note<Time>(ev.channel(), ev.time(), Time(), ev.note(), ev.velocity()));
+	NotePtr note (boost::allocate_shared<Note<Time> > (NoteAllocator(), ev.channel(), ev.time(), Time(), ev.note(), ev.velocity()));
 	note->set_id (evid);
 
 	add_note_unlocked (note);
 
 	DEBUG_TRACE (DEBUG::Sequence, string_compose ("Appending active note on %1 channel %2\n",
 	                                              (unsigned)(uint8_t)note->note(), note->channel()));
-	_write_notes[note->channel()].insert (note);
+	_write_notes[note->channel()].push_back (note);
 
 }
 
@@ -1010,10 +996,9 @@ Sequence<Time>::append_note_off_unlocked (const MIDIEvent<Time>& ev)
 
 	/* XXX use _overlap_pitch_resolution to determine FIFO/LIFO ... */
 
-	for (typename WriteNotes::iterator n = _write_notes[ev.channel()].begin(); n != _write_notes[ev.channel()].end(); ) {
+	WriteNotes& wn (_write_notes[ev.channel()]);
 
-		typename WriteNotes::iterator tmp = n;
-		++tmp;
+	for (typename WriteNotes::iterator n = wn.begin(); n != wn.end(); ++n) {
 
 		NotePtr nn = *n;
 		if (ev.note() == nn->note() && nn->channel() == ev.channel()) {
@@ -1022,13 +1007,11 @@ Sequence<Time>::append_note_off_unlocked (const MIDIEvent<Time>& ev)
 			nn->set_length (ev.time() - nn->time());
 			nn->set_off_velocity (ev.velocity());
 
-			_write_notes[ev.channel()].erase(n);
+			wn.erase(n);
 			DEBUG_TRACE (DEBUG::Sequence, string_compose ("resolved note @ %2 length: %1\n", nn->length(), nn->time()));
 			resolved = true;
 			break;
 		}
-
-		n = tmp;
 	}
 
 	if (!resolved) {
@@ -1111,11 +1094,10 @@ template<typename Time>
 bool
 Sequence<Time>::contains_unlocked (const NotePtr& note) const
 {
-	const Pitches& p (pitches (note->channel()));
-	NotePtr search_note(new Note<Time>(0, Time(), Time(), note->note()));
+	const Pitches& p (pitches (note->channel(), note->note()));
 
-	for (typename Pitches::const_iterator i = p.lower_bound (search_note);
-	     i != p.end() && (*i)->note() == note->note(); ++i) {
+	for (typename Pitches::const_iterator i = std::lower_bound (p.begin(), p.end(), note->time(), NoteTimeLess<Time>());
+	     i != p.end() && (*i)->time() == note->time(); ++i) {
 
 		if (**i == *note) {
 			return true;
@@ -1140,19 +1122,22 @@ Sequence<Time>::overlaps_unlocked (const NotePtr& note, const NotePtr& without)
 	Time sa = note->time();
 	Time ea  = note->end_time();
 
-	const Pitches& p (pitches (note->channel()));
-	NotePtr search_note(new Note<Time>(0, Time(), Time(), note->note()));
+	const Pitches& p (pitches (note->channel(), note->note()));
+
+	for (typename Pitches::const_iterator i = p.begin(); i != p.end(); ++i) {
 
-	for (typename Pitches::const_iterator i = p.lower_bound (search_note);
-	     i != p.end() && (*i)->note() == note->note(); ++i) {
+		Time sb = (*i)->time();
+		Time eb = (*i)->end_time();
+
+		if (sb > ea) {
+			/* this and all later notes start after the end of this one */
+			break;
+		}
 
 		if (without && (**i) == *without) {
 			continue;
 		}
 
-		Time sb = (*i)->time();
-		Time eb = (*i)->end_time();
-
 		if (((sb > sa) && (eb <= ea)) ||
 		    ((eb >= sa) && (eb <= ea)) ||
 		    ((sb > sa) && (sb <= ea)) ||
@@ -1169,6 +1154,75 @@ void
 Sequence<Time>::set_notes (const typename Sequence<Time>::Notes& n)
 {
 	_notes = n;
+	rebuild_pitches ();
+}
+
+template<typename Time>
+void
+Sequence<Time>::add_to_pitches (const NotePtr note)
+{
+	std::vector<Pitches>& c (_pitches[note->channel()]);
+
+	if (c.empty()) {
+		c.resize (128);
+	}
+
+	Pitches& p (c[note->note()]);
+
+	/* after existing notes at the same time, as for _notes */
+	p.insert (std::upper_bound (p.begin(), p.end(), note, NoteTimeLess<Time>()), note);
+}
+
+/** Remove \a note from the per-pitch index.
+ * @param by_id true to find the note by ID, for when its time or pitch may
+ * have changed since it was added.
+ * @return true if the note was found.
+ */
+template<typename Time>
+bool
+Sequence<Time>::remove_from_pitches (const constNotePtr note, bool by_id)
+{
+	std::vector<Pitches>& c (_pitches[note->channel()]);
+
+	if (c.empty()) {
+		return false;
+	}
+
+	if (!by_id) {
+		Pitches& p (c[note->note()]);
+		for (typename Pitches::iterator i = std::lower_bound (p.begin(), p.end(), note->time(), NoteTimeLess<Time>());
+		     i != p.end() && (*i)->time() == note->time(); ++i) {
+			if (*i == note) {
+				DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1\terasing pitch %2 @ %3\n", this, (int)(*i)->note(), (*i)->time()));
+				p.erase (i);
+				return true;
+			}
+		}
+	}
+
+	for (typename std::vector<Pitches>::iterator p = c.begin(); p != c.end(); ++p) {
+		for (typename Pitches::iterator i = p->begin(); i != p->end(); ++i) {
+			if ((*i)->id() == note->id()) {
+				p->erase (i);
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+template<typename Time>
+void
+Sequence<Time>::rebuild_pitches ()
+{
+	for (int i = 0; i < 16; ++i) {
+		_pitches[i].clear();
+	}
+
+	for (typename Notes::const_iterator i = _notes.begin(); i != _notes.end(); ++i) {
+		add_to_pitches (*i);
+	}
 }
 
 // CONST iterator implementations (x3)
@@ -1178,7 +1232,11 @@ template<typename Time>
 typename Sequence<Time>::Notes::const_iterator
 Sequence<Time>::note_lower_bound (Time t) const
 {
-	NotePtr search_note(new Note<Time>(0, t, Time(), 0, 0));
+	/* non-owning pointer to a stack note, which saves allocating a note
+	 * and its reference count for every lookup.
+	 */
+	Note<Time> search (0, t, Time(), 0, 0);
+	NotePtr search_note (NotePtr(), &search);
 	typename Sequence<Time>::Notes::const_iterator i = _notes.lower_bound(search_note);
 	assert(i == _notes.end() || (*i)->time() >= t);
 	return i;
@@ -1213,7 +1271,11 @@ template<typename Time>
 typename Sequence<Time>::Notes::iterator
 Sequence<Time>::note_lower_bound (Time t)
 {
-	NotePtr search_note(new Note<Time>(0, t, Time(), 0, 0));
+	/* non-owning pointer to a stack note, which saves allocating a note
+	 * and its reference count for every lookup.
+	 */
+	Note<Time> search (0, t, Time(), 0, 0);
+	NotePtr search_note (NotePtr(), &search);
 	typename Sequence<Time>::Notes::iterator i = _notes.lower_bound(search_note);
 	assert(i == _notes.end() || (*i)->time() >= t);
 	return i;
@@ -1274,44 +1336,39 @@ Sequence<Time>::get_notes_by_pitch (Notes& n, NoteOperator op, uint8_t val, int
 			continue;
 		}
 
-		const Pitches& p (pitches (c));
-		NotePtr search_note(new Note<Time>(0, Time(), Time(), val, 0));
-		typename Pitches::const_iterator i;
-		switch (op) {
-		case PitchEqual:
-			i = p.lower_bound (search_note);
-			while (i != p.end() && (*i)->note() == val) {
-				n.insert (*i);
-			}
-			break;
-		case PitchLessThan:
-			i = p.upper_bound (search_note);
-			while (i != p.end() && (*i)->note() < val) {
-				n.insert (*i);
-			}
-			break;
-		case PitchLessThanOrEqual:
-			i = p.upper_bound (search_note);
-			while (i != p.end() && (*i)->note() <= val) {
-				n.insert (*i);
-			}
-			break;
-		case PitchGreater:
-			i = p.lower_bound (search_note);
-			while (i != p.end() && (*i)->note() > val) {
-				n.insert (*i);
-			}
-			break;
-		case PitchGreaterThanOrEqual:
-			i = p.lower_bound (search_note);
-			while (i != p.end() && (*i)->note() >= val) {
-				n.insert (*i);
+		if (_pitches[c].empty()) {
+			continue;
+		}
+
+		for (int pitch = 0; pitch < 128; ++pitch) {
+
+			bool match;
+
+			switch (op) {
+			case PitchEqual:
+				match = (pitch == val);
+				break;
+			case PitchLessThan:
+				match = (pitch < val);
+				break;
+			case PitchLessThanOrEqual:
+				match = (pitch <= val);
+				break;
+			case PitchGreater:
+				match = (pitch > val);
+				break;
+			case PitchGreaterThanOrEqual:
+				match = (pitch >= val);
+				break;
+			default:
+				//fatal << string_compose (_("programming error: %1 %2", X_("get_notes_by_pitch() called with illegal operator"), op)) << endmsg;
+				abort(); /* NOTREACHED*/
 			}
-			break;
 
-		default:
-			//fatal << string_compose (_("programming error: %1 %2", X_("get_notes_by_pitch() called with illegal operator"), op)) << endmsg;
-			abort(); /* NOTREACHED*/
+			if (match) {
+				const Pitches& p (_pitches[c][pitch]);
+				n.insert (p.begin(), p.end());
+			}
 		}
 	}
 }
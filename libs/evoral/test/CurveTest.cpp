@@ -424,3 +424,44 @@ CurveTest::constrainedCubic ()
 		CPPUNIT_ASSERT_DOUBLES_EQUAL(v, g[x], 0.000008);
 	}
 }
+
+void
+CurveTest::renderedVector ()
+{
+	float vec[64];
+
+	boost::shared_ptr<Evoral::ControlList> cl = TestCtrlList();
+
+	cl->create_curve ();
+	cl->set_interpolation (ControlList::Linear);
+
+	cl->fast_simple_add (   0.0 , 2048.0);
+	cl->fast_simple_add (8192.0 , 4096.0);
+
+	CPPUNIT_ASSERT (cl->curve ().render_wanted (1024.0, 4096));
+
+	cl->curve ().render (1024.0, 4096);
+	CPPUNIT_ASSERT (!cl->curve ().render_wanted (1024.0, 4096));
+	CPPUNIT_ASSERT (!cl->curve ().render_wanted (2000.0, 2048));
+	CPPUNIT_ASSERT (cl->curve ().render_wanted (4000.0, 2048));
+	CPPUNIT_ASSERT (cl->curve ().render_wanted (1000.0, 64));
+
+	/* one value per whole x, from the rendered values */
+	CPPUNIT_ASSERT (cl->curve ().rt_safe_get_vector (2000.0, 2064.0, vec, 64));
+	for (int i = 0; i < 64; ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (2048.0 + (2000.0 + i) * .25, vec[i], 1e-3);
+	}
+
+	/* the end of the rendered range */
+	CPPUNIT_ASSERT (cl->curve ().rt_safe_get_vector (5056.0, 5120.0, vec, 64));
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (2048.0 + 5119.0 * .25, vec[63], 1e-3);
+
+	/* an edit makes the rendered values stale */
+	cl->fast_simple_add (8193.0 , 0.0);
+	CPPUNIT_ASSERT (cl->curve ().render_wanted (2000.0, 64));
+
+	cl->curve ().render (1024.0, 4096);
+	CPPUNIT_ASSERT (!cl->curve ().render_wanted (2000.0, 64));
+	CPPUNIT_ASSERT (cl->curve ().rt_safe_get_vector (3000.0, 3064.0, vec, 64));
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (2048.0 + 3000.0 * .25, vec[0], 1e-3);
+}
@@ -11,6 +11,7 @@ class CurveTest : public CppUnit::TestFixture
 	CPPUNIT_TEST (threePointDiscete);
 	CPPUNIT_TEST (constrainedCubic);
 	CPPUNIT_TEST (ctrlListEval);
+	CPPUNIT_TEST (renderedVector);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -19,6 +20,7 @@ public:
 	void threePointDiscete ();
 	void constrainedCubic ();
 	void ctrlListEval ();
+	void renderedVector ();
 
 private:
 	boost::shared_ptr<Evoral::ControlList> TestCtrlList() {
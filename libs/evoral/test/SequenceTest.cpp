@@ -154,3 +154,60 @@ SequenceTest::controlInterpolationTest ()
 		last_value = i->second;
 	}
 }
+
+void
+SequenceTest::pitchIndexTest ()
+{
+	typedef boost::shared_ptr< Note<Time> > NotePtr;
+
+	seq->clear();
+
+	for (Notes::const_iterator i = test_notes.begin(); i != test_notes.end(); ++i) {
+		CPPUNIT_ASSERT (seq->add_note_unlocked (*i));
+	}
+
+	/* a second note on the pitch of the first */
+	NotePtr later (new Note<Time> (0, Beats(2000), Beats(100), 64, 64));
+	CPPUNIT_ASSERT (seq->add_note_unlocked (later));
+
+	CPPUNIT_ASSERT (seq->contains (test_notes[3]));
+	CPPUNIT_ASSERT (seq->overlaps (NotePtr (new Note<Time> (0, Beats(50), Beats(10), 64, 64)), NotePtr()));
+	CPPUNIT_ASSERT (seq->overlaps (NotePtr (new Note<Time> (0, Beats(1950), Beats(100), 64, 64)), NotePtr()));
+	CPPUNIT_ASSERT (!seq->overlaps (NotePtr (new Note<Time> (0, Beats(150), Beats(10), 64, 64)), NotePtr()));
+	CPPUNIT_ASSERT (!seq->overlaps (NotePtr (new Note<Time> (1, Beats(50), Beats(10), 64, 64)), NotePtr()));
+
+	Sequence<Time>::Notes found;
+	seq->get_notes (found, Sequence<Time>::PitchEqual, 64);
+	CPPUNIT_ASSERT_EQUAL (size_t(2), found.size());
+	CPPUNIT_ASSERT (*found.begin() == test_notes[0]);
+
+	found.clear ();
+	seq->get_notes (found, Sequence<Time>::PitchGreaterThanOrEqual, 70);
+	CPPUNIT_ASSERT_EQUAL (size_t(6), found.size());
+
+	/* removal by ID, after the note has been moved */
+	later->set_time (Beats(3000));
+	seq->remove_note_unlocked (later);
+	CPPUNIT_ASSERT_EQUAL (size_t(12), seq->notes().size());
+
+	found.clear ();
+	seq->get_notes (found, Sequence<Time>::PitchEqual, 64);
+	CPPUNIT_ASSERT_EQUAL (size_t(1), found.size());
+
+	/* copies get their own index */
+	MySequence<Time> copy (*seq);
+	CPPUNIT_ASSERT_EQUAL (size_t(12), copy.notes().size());
+	CPPUNIT_ASSERT (copy.contains (test_notes[3]));
+	CPPUNIT_ASSERT (copy.notes().begin()->get() != test_notes[0].get());
+
+	/* stuck notes dropped by end_write() leave the index too */
+	seq->clear ();
+	seq->start_write ();
+	seq->append (test_notes[0]->on_event(), next_event_id ());
+	seq->end_write (Sequence<Time>::DeleteStuckNotes);
+	CPPUNIT_ASSERT_EQUAL (size_t(0), seq->notes().size());
+
+	found.clear ();
+	seq->get_notes (found, Sequence<Time>::PitchEqual, 64);
+	CPPUNIT_ASSERT_EQUAL (size_t(0), found.size());
+}
@@ -75,8 +75,28 @@ DummyReceiver dummy_receiver;
 
 int main (int argc, char **argv) {
 	char *dllpath = NULL;
-	if (argc == 3 && !strcmp("-f", argv[1])) {
-		dllpath = argv[2];
+	bool force = false;
+	int argi = 1;
+
+	for (; argi < argc - 1; ++argi) {
+		if (!strcmp("-f", argv[argi])) {
+			force = true;
+		} else if (!strcmp("-n", argv[argi])) {
+			/* caller handles the blacklist (parallel scan) */
+			vstfx_manage_blacklist = false;
+		} else {
+			break;
+		}
+	}
+
+	if (argi != argc - 1) {
+		fprintf(stderr, "usage: %s [-f] [-n] <vst>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	dllpath = argv[argi];
+
+	if (force) {
 		const size_t slen = strlen (dllpath);
 		if (
 				(slen > 3 && 0 == g_ascii_strcasecmp (&dllpath[slen-3], ".so"))
@@ -84,15 +104,10 @@ int main (int argc, char **argv) {
 				(slen > 4 && 0 == g_ascii_strcasecmp (&dllpath[slen-4], ".dll"))
 		   ) {
 			vstfx_remove_infofile(dllpath);
-			vstfx_un_blacklist(dllpath);
+			if (vstfx_manage_blacklist) {
+				vstfx_un_blacklist(dllpath);
+			}
 		}
-
-	}
-	else if (argc != 2) {
-		fprintf(stderr, "usage: %s [-f] <vst>\n", argv[0]);
-		return EXIT_FAILURE;
-	} else {
-		dllpath = argv[1];
 	}
 
 	PBD::init();
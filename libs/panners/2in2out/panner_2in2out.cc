@@ -88,12 +88,12 @@ Panner2in2out::Panner2in2out (boost::shared_ptr<Pannable> p)
         update ();
 
         /* LEFT SIGNAL */
-        left_interp[0] = left[0] = desired_left[0];
-        right_interp[0] = right[0] = desired_right[0];
+        left[0] = desired_left[0];
+        right[0] = desired_right[0];
 
         /* RIGHT SIGNAL */
-        left_interp[1] = left[1] = desired_left[1];
-        right_interp[1] = right[1] = desired_right[1];
+        left[1] = desired_left[1];
+        right[1] = desired_right[1];
 
         _pannable->pan_azimuth_control->Changed.connect_same_thread (*this, boost::bind (&Panner2in2out::update, this));
         _pannable->pan_width_control->Changed.connect_same_thread (*this, boost::bind (&Panner2in2out::update, this));
@@ -267,122 +267,29 @@ Panner2in2out::distribute_one (AudioBuffer& srcbuf, BufferSet& obufs, gain_t gai
 {
 	assert (obufs.count().n_audio() == 2);
 
-	pan_t delta;
-	Sample* dst;
-	pan_t pan;
+	Sample* dst[2] = { obufs.get_audio(0).data(), obufs.get_audio(1).data() };
+	float initial[2];
+	float target[2];
 
-	Sample* const src = srcbuf.data();
-
-	/* LEFT OUTPUT */
-
-	dst = obufs.get_audio(0).data();
-
-	if (fabsf ((delta = (left[which] - desired_left[which]))) > 0.002) { // about 1 degree of arc
-
-		/* we've moving the pan by an appreciable amount, so we must
-		   interpolate over 64 frames or nframes, whichever is smaller */
-
-		pframes_t const limit = min ((pframes_t) 64, nframes);
-		pframes_t n;
-
-		delta = -(delta / (float) (limit));
-
-		for (n = 0; n < limit; n++) {
-			left_interp[which] = left_interp[which] + delta;
-			left[which] = left_interp[which] + 0.9 * (left[which] - left_interp[which]);
-			dst[n] += src[n] * left[which] * gain_coeff;
-		}
-
-		/* then pan the rest of the buffer; no need for interpolation for this bit */
-
-		pan = left[which] * gain_coeff;
-
-		mix_buffers_with_gain (dst+n,src+n,nframes-n,pan);
-
-	} else {
-
-		left[which] = desired_left[which];
-		left_interp[which] = left[which];
-
-		if ((pan = (left[which] * gain_coeff)) != 1.0f) {
-
-			if (pan != 0.0f) {
-
-				/* pan is 1 but also not 0, so we must do it "properly" */
-
-				//obufs.get_audio(1).read_from (srcbuf, nframes);
-				mix_buffers_with_gain(dst,src,nframes,pan);
-
-				/* mark that we wrote into the buffer */
-
-				// obufs[0] = 0;
-
-			}
-
-		} else {
-
-			/* pan is 1 so we can just copy the input samples straight in */
-
-			mix_buffers_no_gain(dst,src,nframes);
-
-			/* XXX it would be nice to mark that we wrote into the buffer */
-		}
-	}
-
-	/* RIGHT OUTPUT */
-
-	dst = obufs.get_audio(1).data();
-
-	if (fabsf ((delta = (right[which] - desired_right[which]))) > 0.002) { // about 1 degree of arc
-
-		/* we're moving the pan by an appreciable amount, so we must
-		   interpolate over 64 frames or nframes, whichever is smaller */
-
-		pframes_t const limit = min ((pframes_t) 64, nframes);
-		pframes_t n;
-
-		delta = -(delta / (float) (limit));
-
-		for (n = 0; n < limit; n++) {
-			right_interp[which] = right_interp[which] + delta;
-			right[which] = right_interp[which] + 0.9 * (right[which] - right_interp[which]);
-			dst[n] += src[n] * right[which] * gain_coeff;
-		}
-
-		/* then pan the rest of the buffer, no need for interpolation for this bit */
-
-		pan = right[which] * gain_coeff;
-
-		mix_buffers_with_gain(dst+n,src+n,nframes-n,pan);
-
-		/* XXX it would be nice to mark the buffer as written to */
-
-	} else {
-
-		right[which] = desired_right[which];
-		right_interp[which] = right[which];
-
-		if ((pan = (right[which] * gain_coeff)) != 1.0f) {
-
-			if (pan != 0.0f) {
-
-				/* pan is not 1 but also not 0, so we must do it "properly" */
+	/* if we're moving the pan by an appreciable amount (about 1 degree of
+	   arc) on either side, ramp that side's gain over 64 frames or nframes,
+	   whichever is smaller, and leave the rest of the buffer at the new gain.
+	*/
 
-				mix_buffers_with_gain(dst,src,nframes,pan);
-				// obufs.get_audio(1).read_from (srcbuf, nframes);
+	pframes_t const limit = min ((pframes_t) 64, nframes);
 
-				/* XXX it would be nice to mark the buffer as written to */
-			}
+	target[0] = desired_left[which] * gain_coeff;
+	target[1] = desired_right[which] * gain_coeff;
 
-		} else {
+	initial[0] = (fabsf (left[which] - desired_left[which]) > 0.002) ? left[which] * gain_coeff : target[0];
+	initial[1] = (fabsf (right[which] - desired_right[which]) > 0.002) ? right[which] * gain_coeff : target[1];
 
-			/* pan is 1 so we can just copy the input samples straight in */
+	left[which] = desired_left[which];
+	right[which] = desired_right[which];
 
-			mix_buffers_no_gain(dst,src,nframes);
+	mix_buffer_to_outputs (dst, 2, srcbuf.data(), nframes, initial, target, limit);
 
-			/* XXX it would be nice to mark the buffer as written to */
-		}
-	}
+	/* XXX it would be nice to mark the buffers as written to */
 }
 
 void
@@ -392,8 +299,6 @@ Panner2in2out::distribute_one_automated (AudioBuffer& srcbuf, BufferSet& obufs,
 {
 	assert (obufs.count().n_audio() == 2);
 
-	Sample* dst;
-	pan_t* pbuf;
 	Sample* const src = srcbuf.data();
         pan_t* const position = buffers[0];
         pan_t* const width = buffers[1];
@@ -448,25 +353,13 @@ Panner2in2out::distribute_one_automated (AudioBuffer& srcbuf, BufferSet& obufs,
 
 	/* LEFT OUTPUT */
 
-	dst = obufs.get_audio(0).data();
-	pbuf = buffers[0];
-
-	for (pframes_t n = 0; n < nframes; ++n) {
-		dst[n] += src[n] * pbuf[n];
-	}
-
-	/* XXX it would be nice to mark the buffer as written to */
+	mix_buffers_with_gain_vector (obufs.get_audio(0).data(), src, nframes, buffers[0]);
 
 	/* RIGHT OUTPUT */
 
-	dst = obufs.get_audio(1).data();
-	pbuf = buffers[1];
-
-	for (pframes_t n = 0; n < nframes; ++n) {
-		dst[n] += src[n] * pbuf[n];
-	}
+	mix_buffers_with_gain_vector (obufs.get_audio(1).data(), src, nframes, buffers[1]);
 
-	/* XXX it would be nice to mark the buffer as written to */
+	/* XXX it would be nice to mark the buffers as written to */
 }
 
 Panner*
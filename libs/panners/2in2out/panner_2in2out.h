@@ -77,8 +77,6 @@ class Panner2in2out : public Panner
 	float right[2];
 	float desired_left[2];
 	float desired_right[2];
-	float left_interp[2];
-	float right_interp[2];
 
   private:
         bool clamp_stereo_pan (double& direction_as_lr_fract, double& width);
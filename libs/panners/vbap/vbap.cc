@@ -25,18 +25,17 @@
 #include <iostream>
 #include <string>
 
-#ifdef COMPILER_MSVC
-#include <malloc.h>
-#endif
-
 #include "pbd/cartesian.h"
 #include "pbd/compose.h"
 
+#include "evoral/ControlList.hpp"
+
 #include "ardour/amp.h"
 #include "ardour/audio_buffer.h"
 #include "ardour/buffer_set.h"
 #include "ardour/pan_controllable.h"
 #include "ardour/pannable.h"
+#include "ardour/runtime_functions.h"
 #include "ardour/speakers.h"
 
 #include "vbap.h"
@@ -122,98 +121,48 @@ void
 VBAPanner::update ()
 {
         /* recompute signal directions based on panner azimuth and, if relevant, width (diffusion) and elevation parameters */
-        double elevation = _pannable->pan_elevation_control->get_value() * 90.0;
-
-        if (_signals.size() > 1) {
-                double w = - (_pannable->pan_width_control->get_value());
-                double signal_direction = 1.0 - (_pannable->pan_azimuth_control->get_value() + (w/2));
-                double grd_step_per_signal = w / (_signals.size() - 1);
-                for (vector<Signal*>::iterator s = _signals.begin(); s != _signals.end(); ++s) {
-
-                        Signal* signal = *s;
 
-                        int over = signal_direction;
-                        over -= (signal_direction >= 0) ? 0 : 1;
-                        signal_direction -= (double)over;
+        double const azimuth = _pannable->pan_azimuth_control->get_value();
+        double const width = _pannable->pan_width_control->get_value();
+        double const elevation = _pannable->pan_elevation_control->get_value();
+        boost::shared_ptr<VBAPSpeakers::GainTable> table = _speakers->gain_table ();
 
-                        signal->direction = AngularVector (signal_direction * 360.0, elevation);
-                        compute_gains (signal->desired_gains, signal->desired_outputs, signal->direction.azi, signal->direction.ele);
-                        signal_direction += grd_step_per_signal;
-                }
-        } else if (_signals.size() == 1) {
-                double center = (1.0 - _pannable->pan_azimuth_control->get_value()) * 360.0;
-
-                /* width has no role to play if there is only 1 signal: VBAP does not do "diffusion" of a single channel */
-
-                Signal* s = _signals.front();
-                s->direction = AngularVector (center, elevation);
-                compute_gains (s->desired_gains, s->desired_outputs, s->direction.azi, s->direction.ele);
+        for (uint32_t n = 0; n < _signals.size(); ++n) {
+                Signal* signal = _signals[n];
+                signal->direction = signal_direction (n, azimuth, width, elevation);
+                compute_gains (*table, signal->desired_gains, signal->desired_outputs, signal->direction.azi, signal->direction.ele);
         }
 
         SignalPositionChanged(); /* emit */
 }
 
-void
-VBAPanner::compute_gains (double gains[3], int speaker_ids[3], int azi, int ele)
+AngularVector
+VBAPanner::signal_direction (uint32_t which, double azimuth, double width, double elevation) const
 {
-	/* calculates gain factors using loudspeaker setup and given direction */
-	double cartdir[3];
-	double power;
-	int i,j,k;
-	double small_g;
-	double big_sm_g, gtmp[3];
-	const int dimension = _speakers->dimension();
-	assert(dimension == 2 || dimension == 3);
-
-	spherical_to_cartesian (azi, ele, 1.0, cartdir[0], cartdir[1], cartdir[2]);
-	big_sm_g = -100000.0;
-
-	gains[0] = gains[1] = gains[2] = 0;
-	speaker_ids[0] = speaker_ids[1] = speaker_ids[2] = 0;
-
-	for (i = 0; i < _speakers->n_tuples(); i++) {
-
-		small_g = 10000000.0;
-
-		for (j = 0; j < dimension; j++) {
-
-			gtmp[j] = 0.0;
-
-			for (k = 0; k < dimension; k++) {
-				gtmp[j] += cartdir[k] * _speakers->matrix(i)[j * dimension + k];
-			}
-
-			if (gtmp[j] < small_g) {
-				small_g = gtmp[j];
-			}
-		}
-
-		if (small_g > big_sm_g) {
+        if (_signals.size() > 1) {
+                double w = - width;
+                double signal_direction = 1.0 - (azimuth + (w/2)) + which * (w / (_signals.size() - 1));
 
-			big_sm_g = small_g;
+                int over = signal_direction;
+                over -= (signal_direction >= 0) ? 0 : 1;
+                signal_direction -= (double)over;
 
-			gains[0] = gtmp[0];
-			gains[1] = gtmp[1];
+                return AngularVector (signal_direction * 360.0, elevation * 90.0);
+        }
 
-			speaker_ids[0] = _speakers->speaker_for_tuple (i, 0);
-			speaker_ids[1] = _speakers->speaker_for_tuple (i, 1);
+        /* width has no role to play if there is only 1 signal: VBAP does not do "diffusion" of a single channel */
 
-			if (_speakers->dimension() == 3) {
-				gains[2] = gtmp[2];
-				speaker_ids[2] = _speakers->speaker_for_tuple (i, 2);
-			} else {
-				gains[2] = 0.0;
-				speaker_ids[2] = -1;
-			}
-		}
-	}
+        return AngularVector ((1.0 - azimuth) * 360.0, elevation * 90.0);
+}
 
-	power = sqrt (gains[0]*gains[0] + gains[1]*gains[1] + gains[2]*gains[2]);
+void
+VBAPanner::compute_gains (VBAPSpeakers::GainTable const & table, double gains[3], int speaker_ids[3], int azi, int ele)
+{
+	VBAPSpeakers::Gains const & g (VBAPSpeakers::gains (table, azi, ele));
 
-	if (power > 0) {
-		gains[0] /= power;
-		gains[1] /= power;
-		gains[2] /= power;
+	for (int i = 0; i < 3; ++i) {
+		gains[i] = g.gain[i];
+		speaker_ids[i] = g.speaker[i];
 	}
 }
 
@@ -226,21 +175,23 @@ VBAPanner::distribute (BufferSet& inbufs, BufferSet& obufs, gain_t gain_coeffici
         assert (inbufs.count().n_audio() == _signals.size());
 
         for (s = _signals.begin(), n = 0; s != _signals.end(); ++s, ++n) {
-
-                Signal* signal (*s);
-
                 distribute_one (inbufs.get_audio (n), obufs, gain_coefficient, nframes, n);
-
-                memcpy (signal->outputs, signal->desired_outputs, sizeof (signal->outputs));
         }
 }
 
 void
 VBAPanner::distribute_one (AudioBuffer& srcbuf, BufferSet& obufs, gain_t gain_coefficient, pframes_t nframes, uint32_t which)
 {
-	Sample* const src = srcbuf.data();
-        Signal* signal (_signals[which]);
+        Signal& signal (*_signals[which]);
+        mix_signal (signal, signal.desired_gains, signal.desired_outputs, srcbuf.data(), obufs, gain_coefficient, 0, nframes);
+}
 
+/** Mix @a src into @a outputs with @a gains, ramping from where the signal
+ *  was last time.
+ */
+void
+VBAPanner::mix_signal (Signal& signal, double const gains[3], int const outputs[3], Sample const * src, BufferSet& obufs, gain_t gain_coefficient, pframes_t offset, pframes_t nframes)
+{
 	/* VBAP may distribute the signal across up to 3 speakers depending on
 	   the configuration of the speakers.
 
@@ -257,109 +208,118 @@ VBAPanner::distribute_one (AudioBuffer& srcbuf, BufferSet& obufs, gain_t gain_co
            anything here that will simply assign new (sample) values
            to the output buffers - everything must be done via mixing
            functions and not assignment/copying.
-	*/
 
-        vector<double>::size_type sz = signal->gains.size();
-
-        assert (sz == obufs.count().n_audio());
+           All of them are mixed in one pass over the source, with each
+           output's gain ramped across the block as needed.
+	*/
 
-        int8_t *outputs = (int8_t*)alloca(sz); // on the stack, no malloc
+        assert (signal.gains.size() == obufs.count().n_audio());
 
-        /* set initial state of each output "record"
-         */
+        Sample* dst[6];
+        float initial[6];
+        float target[6];
+        uint32_t n = 0;
 
-        for (uint32_t o = 0; o < sz; ++o) {
-                outputs[o] = 0;
-        }
+	for (int o = 0; o < 3; ++o) {
+                int const output = outputs[o];
 
-        /* for all outputs used this time and last time,
-           change the output record to show what has
-           happened.
-        */
+		if (output == -1) {
+                        continue;
+                }
 
+                pan_t const pan = gain_coefficient * gains[o];
 
-        for (int o = 0; o < 3; ++o) {
-                if (signal->outputs[o] != -1) {
-                        /* used last time */
-                        outputs[signal->outputs[o]] |= 1;
-                }
+                dst[n] = obufs.get_audio (output).data() + offset;
+                target[n] = pan;
 
-                if (signal->desired_outputs[o] != -1) {
-                        /* used this time */
-                        outputs[signal->desired_outputs[o]] |= 1<<1;
+                if (fabs (pan - signal.gains[output]) > 0.00001) {
+                        /* the gain coefficient has changed, so interpolate */
+                        initial[n] = signal.gains[output];
+                } else {
+                        initial[n] = pan;
                 }
-        }
 
-        /* at this point, we can test a speaker's status:
+                signal.gains[output] = pan;
+                ++n;
+	}
 
-           (*outputs[o] & 1)      <= in use before
-           (*outputs[o] & 2)      <= in use this time
-           (*outputs[o] & 3) == 3 <= in use both times
-            *outputs[o] == 0      <= not in use either time
+        /* fade out the outputs that were used last time but not this time */
 
-        */
-
-	for (int o = 0; o < 3; ++o) {
-                pan_t pan;
-                int output = signal->desired_outputs[o];
+        for (int o = 0; o < 3; ++o) {
+                int const output = signal.outputs[o];
 
-		if (output == -1) {
+                if (output == -1 || output == outputs[0] ||
+                    output == outputs[1] || output == outputs[2]) {
                         continue;
                 }
 
-                pan = gain_coefficient * signal->desired_gains[o];
+                dst[n] = obufs.get_audio (output).data() + offset;
+                initial[n] = signal.gains[output];
+                target[n] = 0.0;
+                signal.gains[output] = 0.0;
+                ++n;
+        }
 
-                if (pan == 0.0 && signal->gains[output] == 0.0) {
+        mix_buffer_to_outputs (dst, n, src, nframes, initial, target, nframes);
 
-                        /* nothing deing delivered to this output */
+        memcpy (signal.outputs, outputs, sizeof (signal.outputs));
+
+        /* note that the output buffers were all silenced at some point
+           so anything we didn't write to with this signal (or any others)
+           is just as it should be.
+        */
+}
 
-                        signal->gains[output] = 0.0;
+void
+VBAPanner::distribute_one_automated (AudioBuffer& srcbuf, BufferSet& obufs,
+                                     framepos_t start, framepos_t end,
+				     pframes_t nframes, pan_t** /*buffers*/, uint32_t which)
+{
+        /* The speakers a signal uses can change as it moves, so rather
+           than per-sample gains, evaluate the automation every 64 frames
+           and ramp each speaker's gain between those points.
+        */
 
-                } else if (fabs (pan - signal->gains[output]) > 0.00001) {
+        pframes_t const block = 64;
+        Signal* signal (_signals[which]);
+        Sample* const src = srcbuf.data();
 
-                        /* signal to this output but the gain coefficient has changed, so
-                           interpolate between them.
-                        */
+        boost::shared_ptr<Evoral::ControlList> azimuth = _pannable->pan_azimuth_control->list();
+        boost::shared_ptr<Evoral::ControlList> width = _pannable->pan_width_control->list();
+        boost::shared_ptr<Evoral::ControlList> elevation = _pannable->pan_elevation_control->list();
 
-                        AudioBuffer& buf (obufs.get_audio (output));
-                        buf.accumulate_with_ramped_gain_from (srcbuf.data(), nframes, signal->gains[output], pan, 0);
-                        signal->gains[output] = pan;
+        /* update() writes desired_gains/desired_outputs from other threads,
+           so keep what automation asks for to ourselves. Until it asks for
+           anything, stay where the signal was last time.
+        */
+        boost::shared_ptr<VBAPSpeakers::GainTable> table = _speakers->gain_table ();
+        double gains[3];
+        int outputs[3];
 
-                } else {
+        for (int o = 0; o < 3; ++o) {
+                outputs[o] = signal->outputs[o];
+                gains[o] = (outputs[o] == -1) ? 0.0 : signal->gains[outputs[o]];
+        }
 
-                        /* signal to this output, same gain as before so just copy with gain
-                         */
+        for (pframes_t offset = 0; offset < nframes; offset += block) {
 
-                        mix_buffers_with_gain (obufs.get_audio (output).data(),src,nframes,pan);
-                        signal->gains[output] = pan;
-                }
-	}
+                pframes_t const n = min (block, nframes - offset);
+                double const when = start + (end - start) * (double) (offset + n) / nframes;
+                bool ok_a, ok_w, ok_e;
 
-        /* clean up the outputs that were used last time but not this time
-         */
+                double const a = azimuth->rt_safe_eval (when, ok_a);
+                double const w = width->rt_safe_eval (when, ok_w);
+                double const e = elevation->rt_safe_eval (when, ok_e);
 
-        for (uint32_t o = 0; o < sz; ++o) {
-                if (outputs[o] == 1) {
-                        /* take signal and deliver with a rapid fade out
-                         */
-                        AudioBuffer& buf (obufs.get_audio (o));
-                        buf.accumulate_with_ramped_gain_from (srcbuf.data(), nframes, signal->gains[o], 0.0, 0);
-                        signal->gains[o] = 0.0;
+                if (ok_a && ok_w && ok_e) {
+                        signal->direction = signal_direction (which, a, w, e);
+                        compute_gains (*table, gains, outputs, signal->direction.azi, signal->direction.ele);
                 }
-        }
 
-        /* note that the output buffers were all silenced at some point
-           so anything we didn't write to with this signal (or any others)
-           is just as it should be.
-        */
-}
+                /* if the lists are busy, stay where we were */
 
-void
-VBAPanner::distribute_one_automated (AudioBuffer& /*src*/, BufferSet& /*obufs*/,
-                                     framepos_t /*start*/, framepos_t /*end*/,
-				     pframes_t /*nframes*/, pan_t** /*buffers*/, uint32_t /*which*/)
-{
-	/* XXX to be implemented */
+                mix_signal (*signal, gains, outputs, src + offset, obufs, 1.0, offset, n);
+        }
 }
 
 XMLNode&
@@ -82,10 +82,13 @@ private:
         std::vector<Signal*> _signals;
         boost::shared_ptr<VBAPSpeakers>  _speakers;
 
-	void compute_gains (double g[3], int ls[3], int azi, int ele);
+	static void compute_gains (VBAPSpeakers::GainTable const &, double g[3], int ls[3], int azi, int ele);
+        PBD::AngularVector signal_direction (uint32_t which, double azimuth, double width, double elevation) const;
         void update ();
         void clear_signals ();
 
+        void mix_signal (Signal&, double const gains[3], int const outputs[3], Sample const * src, BufferSet& obufs, gain_t gain_coeff, pframes_t offset, pframes_t nframes);
+
 	void distribute_one (AudioBuffer& src, BufferSet& obufs, gain_t gain_coeff, pframes_t nframes, uint32_t which);
 	void distribute_one_automated (AudioBuffer& src, BufferSet& obufs,
                                           framepos_t start, framepos_t end, pframes_t nframes,
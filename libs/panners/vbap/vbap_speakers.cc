@@ -31,6 +31,7 @@
    of the software.
 */
 
+#include <cassert>
 #include <cmath>
 #include <algorithm>
 #include <stdlib.h>
@@ -48,6 +49,7 @@ const double VBAPSpeakers::MIN_VOL_P_SIDE_LGTH = 0.01;
 VBAPSpeakers::VBAPSpeakers (boost::shared_ptr<Speakers> s)
 	: _dimension (2)
         , _parent (s)
+        , _gains (new GainTable)
 {
 	_parent->Changed.connect_same_thread (speaker_connection, boost::bind (&VBAPSpeakers::update, this));
         update ();
@@ -75,6 +77,8 @@ VBAPSpeakers::update ()
 
 	if (_speakers.size() < 2) {
 		/* nothing to be done with less than two speakers */
+		RCUWriter<GainTable> writer (_gains);
+		writer.get_copy()->clear ();
 		return;
 	}
 
@@ -88,6 +92,127 @@ VBAPSpeakers::update ()
 	} else {
 		choose_speaker_pairs ();
 	}
+
+	fill_gain_table ();
+}
+
+void
+VBAPSpeakers::fill_gain_table ()
+{
+	/* In 2D the elevation of the source only scales all gains
+	   equally, which normalization removes, so azimuth is enough.
+	*/
+
+	const int n_ele = (_dimension == 3) ? 91 : 1;
+	vector<Gains> table (360 * n_ele);
+
+	for (int ele = 0; ele < n_ele; ++ele) {
+		for (int azi = 0; azi < 360; ++azi) {
+			double g[3];
+			int ls[3];
+			Gains& e (table[ele * 360 + azi]);
+
+			compute_gains (g, ls, azi, ele);
+
+			for (int i = 0; i < 3; ++i) {
+				e.gain[i] = g[i];
+				e.speaker[i] = ls[i];
+			}
+		}
+	}
+
+	/* the process thread may be using the old table: publish the new
+	   one rather than overwriting it.
+	*/
+	RCUWriter<GainTable> writer (_gains);
+	writer.get_copy()->swap (table);
+}
+
+VBAPSpeakers::Gains const &
+VBAPSpeakers::gains (GainTable const & table, int azi, int ele)
+{
+	static const Gains none = { { 0, 0, 0 }, { -1, -1, -1 } };
+
+	if (table.empty()) {
+		return none;
+	}
+
+	azi %= 360;
+	if (azi < 0) {
+		azi += 360;
+	}
+
+	if (table.size() == 360) {
+		return table[azi];
+	}
+
+	ele = min (90, max (0, ele));
+	return table[ele * 360 + azi];
+}
+
+void
+VBAPSpeakers::compute_gains (double gains[3], int speaker_ids[3], int azi, int ele) const
+{
+	/* calculates gain factors using loudspeaker setup and given direction */
+	double cartdir[3];
+	double power;
+	int i,j,k;
+	double small_g;
+	double big_sm_g, gtmp[3];
+	const int dimension = _dimension;
+	assert(dimension == 2 || dimension == 3);
+
+	spherical_to_cartesian (azi, ele, 1.0, cartdir[0], cartdir[1], cartdir[2]);
+	big_sm_g = -100000.0;
+
+	gains[0] = gains[1] = gains[2] = 0;
+	speaker_ids[0] = speaker_ids[1] = speaker_ids[2] = 0;
+
+	for (i = 0; i < n_tuples(); i++) {
+
+		const dvector& m (_matrices[i]);
+		small_g = 10000000.0;
+
+		for (j = 0; j < dimension; j++) {
+
+			gtmp[j] = 0.0;
+
+			for (k = 0; k < dimension; k++) {
+				gtmp[j] += cartdir[k] * m[j * dimension + k];
+			}
+
+			if (gtmp[j] < small_g) {
+				small_g = gtmp[j];
+			}
+		}
+
+		if (small_g > big_sm_g) {
+
+			big_sm_g = small_g;
+
+			gains[0] = gtmp[0];
+			gains[1] = gtmp[1];
+
+			speaker_ids[0] = speaker_for_tuple (i, 0);
+			speaker_ids[1] = speaker_for_tuple (i, 1);
+
+			if (dimension == 3) {
+				gains[2] = gtmp[2];
+				speaker_ids[2] = speaker_for_tuple (i, 2);
+			} else {
+				gains[2] = 0.0;
+				speaker_ids[2] = -1;
+			}
+		}
+	}
+
+	power = sqrt (gains[0]*gains[0] + gains[1]*gains[1] + gains[2]*gains[2]);
+
+	if (power > 0) {
+		gains[0] /= power;
+		gains[1] /= power;
+		gains[2] /= power;
+	}
 }
 
 void
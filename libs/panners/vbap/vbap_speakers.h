@@ -21,9 +21,11 @@
 
 #include <string>
 #include <vector>
+#include <stdint.h>
 
 #include <boost/utility.hpp>
 
+#include <pbd/rcu.h>
 #include <pbd/signals.h>
 
 #include "ardour/panner.h"
@@ -38,7 +40,7 @@ public:
 	VBAPSpeakers (boost::shared_ptr<Speakers>);
 
 	typedef std::vector<double> dvector;
-	const dvector matrix (int tuple) const  { return _matrices[tuple]; }
+	const dvector& matrix (int tuple) const  { return _matrices[tuple]; }
 	int speaker_for_tuple (int tuple, int which) const { return _speaker_tuples[tuple][which]; }
 
 	int           n_tuples () const  { return _matrices.size(); }
@@ -47,6 +49,25 @@ public:
         uint32_t n_speakers() const { return _speakers.size(); }
         boost::shared_ptr<Speakers> parent() const { return _parent; }
 
+	/* VBAP gains for a source in a given direction, precomputed for
+	   each whole degree of azimuth (and elevation, in 3D) whenever the
+	   speakers change.
+	*/
+	struct Gains {
+		float   gain[3];
+		int16_t speaker[3]; /* -1 if unused */
+	};
+
+	typedef std::vector<Gains> GainTable;
+
+	/* the current table, which stays valid for as long as the caller
+	   holds on to it even if the speakers change meanwhile.
+	   Realtime safe.
+	*/
+	boost::shared_ptr<GainTable> gain_table () const { return _gains.reader (); }
+
+	static Gains const & gains (GainTable const &, int azi, int ele);
+
 	~VBAPSpeakers ();
 
 private:
@@ -76,6 +97,7 @@ private:
 
 	std::vector<dvector>  _matrices;       /* holds matrices for a given speaker combinations */
 	std::vector<tmatrix>  _speaker_tuples; /* holds speakers IDs for a given combination */
+	SerializedRCUManager<GainTable> _gains; /* 360 azimuths, times 91 elevations in 3D */
 
 	/* A struct for all loudspeakers */
 	struct ls_triplet_chain {
@@ -91,6 +113,8 @@ private:
 	static void   cross_prod(PBD::CartesianVector v1,PBD::CartesianVector v2, PBD::CartesianVector *res);
 
 	void update ();
+	void compute_gains (double g[3], int ls[3], int azi, int ele) const;
+	void fill_gain_table ();
 	int  any_ls_inside_triplet (int a, int b, int c);
 	void add_ldsp_triplet (int i, int j, int k, struct ls_triplet_chain **ls_triplets);
 	int  lines_intersect (int i,int j,int k,int l);
@@ -0,0 +1,128 @@
+/*
+    Copyright (C) 2016 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include <gio/gio.h>
+
+#include "pbd/packed_xml.h"
+#include "pbd/xml++.h"
+
+using namespace std;
+using namespace PBD;
+
+/** Run all of `in' through `c', putting the result in `out' */
+static bool
+convert (GConverter* c, string const & in, string& out)
+{
+	char buf[16384];
+	gsize pos = 0;
+
+	out.clear ();
+
+	while (true) {
+		gsize bytes_read = 0;
+		gsize bytes_written = 0;
+		GError* err = 0;
+
+		GConverterResult const r = g_converter_convert (
+			c, in.data() + pos, in.size() - pos, buf, sizeof (buf),
+			G_CONVERTER_INPUT_AT_END, &bytes_read, &bytes_written, &err);
+
+		if (r == G_CONVERTER_ERROR) {
+			g_error_free (err);
+			return false;
+		}
+
+		pos += bytes_read;
+		out.append (buf, bytes_written);
+
+		if (r == G_CONVERTER_FINISHED) {
+			return true;
+		}
+	}
+}
+
+PackedXML::PackedXML (XMLNode* node)
+	: _compressed (false)
+{
+	XMLTree tree;
+	tree.set_root (node); /* tree now owns node */
+
+	string const text = tree.write_buffer ();
+
+	GZlibCompressor* z = g_zlib_compressor_new (G_ZLIB_COMPRESSOR_FORMAT_RAW, -1);
+	_compressed = convert (G_CONVERTER (z), text, _data);
+	g_object_unref (z);
+
+	if (!_compressed) {
+		_data = text;
+	}
+
+	/* drop any slack left by appending */
+	string (_data).swap (_data);
+}
+
+XMLNode*
+PackedXML::unpack () const
+{
+	string text;
+
+	if (_compressed) {
+		GZlibDecompressor* z = g_zlib_decompressor_new (G_ZLIB_COMPRESSOR_FORMAT_RAW);
+		bool const ok = convert (G_CONVERTER (z), _data, text);
+		g_object_unref (z);
+		if (!ok) {
+			return 0;
+		}
+	} else {
+		text = _data;
+	}
+
+	XMLTree tree;
+
+	if (!tree.read_buffer (text) || !tree.root ()) {
+		return 0;
+	}
+
+	return new XMLNode (*tree.root ());
+}
+
+size_t
+PackedXML::memory_usage (XMLNode const & node)
+{
+	/* list and map nodes are roughly this many pointers each */
+	size_t const list_node = 3 * sizeof (void*);
+	size_t const map_node = 4 * sizeof (void*) + sizeof (string) + sizeof (void*);
+
+	size_t s = sizeof (XMLNode) + node.name().capacity() + node.content().capacity();
+
+	XMLPropertyList const & props (node.properties ());
+
+	for (XMLPropertyConstIterator p = props.begin(); p != props.end(); ++p) {
+		s += sizeof (XMLProperty) + list_node + map_node;
+		s += 2 * (*p)->name().capacity() + (*p)->value().capacity();
+	}
+
+	XMLNodeList const & children (node.children ());
+
+	for (XMLNodeConstIterator c = children.begin(); c != children.end(); ++c) {
+		s += list_node + memory_usage (**c);
+	}
+
+	return s;
+}
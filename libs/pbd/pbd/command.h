@@ -48,6 +48,17 @@ public:
 		return false;
 	}
 
+	/** Called once the command is in the undo history, where it may be
+	 *  kept for a long time; it may then reduce the memory it uses at the
+	 *  expense of making undo and redo a little slower.
+	 */
+	virtual void compact () {}
+
+	/** @return approximate number of bytes used by this command */
+	virtual size_t memory_usage () const {
+		return sizeof (*this) + _name.capacity ();
+	}
+
 protected:
 	Command() {}
 	Command(const std::string& name) : _name(name) {}
@@ -25,6 +25,7 @@
 
 #include "pbd/libpbd_visibility.h"
 #include "pbd/command.h"
+#include "pbd/packed_xml.h"
 #include "pbd/stacktrace.h"
 #include "pbd/xml++.h"
 #include "pbd/demangle.h"
@@ -32,6 +33,8 @@
 #include <sigc++/slot.h>
 #include <typeinfo>
 
+#include <boost/scoped_ptr.hpp>
+
 /** A class that can return a Stateful object which is the subject of a MementoCommand.
  *
  *  The existence of this class means that the undo record can refer to objects which
@@ -98,6 +101,9 @@ private:
 /** This command class is initialized with before and after mementos
  * (from Stateful::get_state()), so undo becomes restoring the before
  * memento, and redo is restoring the after memento.
+ *
+ * Once compacted the mementos are kept packed (see PBD::PackedXML), and
+ * are unpacked again whenever they are needed.
  */
 template <class obj_T>
 class LIBPBD_TEMPLATE_API MementoCommand : public Command
@@ -105,6 +111,7 @@ class LIBPBD_TEMPLATE_API MementoCommand : public Command
 public:
 	MementoCommand (obj_T& a_object, XMLNode* a_before, XMLNode* a_after)
 		: _binder (new SimpleMementoCommandBinder<obj_T> (a_object)), before (a_before), after (a_after)
+		, packed_before (0), packed_after (0)
 	{
 		/* The binder's object died, so we must die */
 		_binder->DropReferences.connect_same_thread (_binder_death_connection, boost::bind (&MementoCommand::binder_dying, this));
@@ -112,6 +119,7 @@ public:
 
 	MementoCommand (MementoCommandBinder<obj_T>* b, XMLNode* a_before, XMLNode* a_after)
 		: _binder (b), before (a_before), after (a_after)
+		, packed_before (0), packed_after (0)
 	{
 		/* The binder's object died, so we must die */
 		_binder->DropReferences.connect_same_thread (_binder_death_connection, boost::bind (&MementoCommand::binder_dying, this));
@@ -121,6 +129,8 @@ public:
 		drop_references ();
 		delete before;
 		delete after;
+		delete packed_before;
+		delete packed_after;
 		delete _binder;
 	}
 
@@ -129,22 +139,29 @@ public:
 	}
 
 	void operator() () {
-		if (after) {
-			_binder->get()->set_state(*after, Stateful::current_state_version);
+		boost::scoped_ptr<XMLNode> unpacked;
+		XMLNode const * a = get_memento (after, packed_after, unpacked);
+		if (a) {
+			_binder->get()->set_state(*a, Stateful::current_state_version);
 		}
 	}
 
 	void undo() {
-		if (before) {
-			_binder->get()->set_state(*before, Stateful::current_state_version);
+		boost::scoped_ptr<XMLNode> unpacked;
+		XMLNode const * b = get_memento (before, packed_before, unpacked);
+		if (b) {
+			_binder->get()->set_state(*b, Stateful::current_state_version);
 		}
 	}
 
 	virtual XMLNode &get_state() {
 		std::string name;
-		if (before && after) {
+		bool const have_before = before || packed_before;
+		bool const have_after = after || packed_after;
+
+		if (have_before && have_after) {
 			name = "MementoCommand";
-		} else if (before) {
+		} else if (have_before) {
 			name = "MementoUndoCommand";
 		} else {
 			name = "MementoRedoCommand";
@@ -155,22 +172,61 @@ public:
 
 		node->add_property ("type_name", _binder->type_name ());
 
-		if (before) {
-			node->add_child_copy(*before);
+		boost::scoped_ptr<XMLNode> unpacked_before;
+		boost::scoped_ptr<XMLNode> unpacked_after;
+		XMLNode const * b = get_memento (before, packed_before, unpacked_before);
+		XMLNode const * a = get_memento (after, packed_after, unpacked_after);
+
+		if (b) {
+			node->add_child_copy(*b);
 		}
 
-		if (after) {
-			node->add_child_copy(*after);
+		if (a) {
+			node->add_child_copy(*a);
 		}
 
 		return *node;
 	}
 
+	void compact () {
+		if (before) {
+			packed_before = new PBD::PackedXML (before);
+			before = 0;
+		}
+		if (after) {
+			packed_after = new PBD::PackedXML (after);
+			after = 0;
+		}
+	}
+
+	size_t memory_usage () const {
+		size_t s = sizeof (*this) + _name.capacity ();
+		s += before ? PBD::PackedXML::memory_usage (*before) : 0;
+		s += after ? PBD::PackedXML::memory_usage (*after) : 0;
+		s += packed_before ? packed_before->memory_usage () : 0;
+		s += packed_after ? packed_after->memory_usage () : 0;
+		return s;
+	}
+
 protected:
 	MementoCommandBinder<obj_T>* _binder;
 	XMLNode* before;
 	XMLNode* after;
+	PBD::PackedXML* packed_before;
+	PBD::PackedXML* packed_after;
 	PBD::ScopedConnection _binder_death_connection;
+
+private:
+	/** @return the memento held either as `node' or `packed', unpacking into `unpacked' if need be */
+	static XMLNode const * get_memento (XMLNode const * node, PBD::PackedXML const * packed, boost::scoped_ptr<XMLNode>& unpacked) {
+		if (node) {
+			return node;
+		}
+		if (packed) {
+			unpacked.reset (packed->unpack ());
+		}
+		return unpacked.get ();
+	}
 };
 
 #endif // __lib_pbd_memento_h__
@@ -0,0 +1,57 @@
+/*
+    Copyright (C) 2016 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __pbd_packed_xml_h__
+#define __pbd_packed_xml_h__
+
+#include <string>
+
+#include "pbd/libpbd_visibility.h"
+
+class XMLNode;
+
+namespace PBD {
+
+/** An XMLNode kept as compressed text, for state that has to be held on
+ *  to for a long time but is rarely looked at, such as undo mementos.
+ *  This is usually a small fraction of the size of the XMLNode tree.
+ */
+class LIBPBD_API PackedXML
+{
+public:
+	/** Pack a node; the node is deleted */
+	PackedXML (XMLNode* node);
+
+	/** @return a new copy of the packed node, owned by the caller, or 0 on error */
+	XMLNode* unpack () const;
+
+	/** @return approximate number of bytes used */
+	size_t memory_usage () const { return sizeof (*this) + _data.capacity (); }
+
+	/** @return approximate number of bytes used by an XMLNode tree */
+	static size_t memory_usage (XMLNode const &);
+
+private:
+	std::string _data;
+	bool        _compressed;
+};
+
+} /* namespace */
+
+#endif /* __pbd_packed_xml_h__ */
@@ -57,6 +57,9 @@ class LIBPBD_API UndoTransaction : public Command
 
 	XMLNode &get_state();
 
+	void compact ();
+	size_t memory_usage () const;
+
 	void set_timestamp (struct timeval &t) {
 		_timestamp = t;
 	}
@@ -69,6 +72,7 @@ class LIBPBD_API UndoTransaction : public Command
 	std::list<Command*>    actions;
 	struct timeval        _timestamp;
 	bool                  _clearing;
+	mutable size_t        _memory_usage; ///< cached result of memory_usage(), or 0
 
 	friend void command_death (UndoTransaction*, Command *);
 
@@ -108,6 +112,12 @@ class LIBPBD_API UndoHistory : public PBD::ScopedConnectionList
 
 	void set_depth (uint32_t);
 
+	/** Limit the memory used by the history to about `bytes', by dropping the
+	 *  oldest undo transactions as required; 0 means no limit.
+	 */
+	void set_memory_budget (size_t bytes);
+	size_t memory_usage () const;
+
 	PBD::Signal0<void> Changed;
 	PBD::Signal0<void> BeginUndoRedo;
 	PBD::Signal0<void> EndUndoRedo;
@@ -115,10 +125,12 @@ class LIBPBD_API UndoHistory : public PBD::ScopedConnectionList
   private:
 	bool _clearing;
 	uint32_t _depth;
+	size_t _memory_budget;
 	std::list<UndoTransaction*> UndoList;
 	std::list<UndoTransaction*> RedoList;
 
 	void remove (UndoTransaction*);
+	void enforce_memory_budget ();
 };
 
 
@@ -18,6 +18,7 @@
 */
 
 #include "pbd/stateful_diff_command.h"
+#include "pbd/packed_xml.h"
 #include "pbd/property_list.h"
 #include "pbd/demangle.h"
 #include "i18n.h"
@@ -122,3 +123,13 @@ StatefulDiffCommand::empty () const
 {
 	return _changes->empty();
 }
+
+size_t
+StatefulDiffCommand::memory_usage () const
+{
+	/* the changes themselves are best measured by what it takes to describe them */
+	XMLNode changes (X_("Changes"));
+	_changes->get_changes_as_xml (&changes);
+
+	return sizeof (*this) + _name.capacity () + PackedXML::memory_usage (changes);
+}
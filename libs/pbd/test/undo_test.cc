@@ -0,0 +1,81 @@
+#include "undo_test.h"
+
+#include "pbd/undo.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (UndoTest);
+
+using namespace std;
+
+namespace {
+
+/** A command which claims to use a given amount of memory */
+class SizedCommand : public Command
+{
+public:
+	SizedCommand (size_t size, bool* compacted)
+		: _size (size)
+		, _compacted (compacted)
+	{}
+
+	~SizedCommand () { drop_references (); }
+
+	void operator() () {}
+	void undo () {}
+
+	void compact () { *_compacted = true; }
+	size_t memory_usage () const { return _size; }
+
+private:
+	size_t _size;
+	bool* _compacted;
+};
+
+UndoTransaction*
+sized_transaction (size_t size, bool* compacted)
+{
+	UndoTransaction* ut = new UndoTransaction;
+	ut->add_command (new SizedCommand (size, compacted));
+	return ut;
+}
+
+}
+
+void
+UndoTest::testMemoryBudget ()
+{
+	UndoHistory history;
+	bool compacted = false;
+
+	UndoTransaction* ut = sized_transaction (1000, &compacted);
+	size_t const one = ut->memory_usage ();
+	CPPUNIT_ASSERT (one >= 1000);
+
+	history.add (ut);
+	CPPUNIT_ASSERT (compacted);
+	CPPUNIT_ASSERT_EQUAL (one, history.memory_usage ());
+
+	for (int i = 0; i < 9; ++i) {
+		history.add (sized_transaction (1000, &compacted));
+	}
+
+	CPPUNIT_ASSERT_EQUAL ((unsigned long) 10, history.undo_depth ());
+	CPPUNIT_ASSERT_EQUAL (10 * one, history.memory_usage ());
+
+	/* the oldest transactions go to get within budget */
+	history.set_memory_budget (4 * one);
+	CPPUNIT_ASSERT_EQUAL ((unsigned long) 4, history.undo_depth ());
+
+	history.add (sized_transaction (1000, &compacted));
+	CPPUNIT_ASSERT_EQUAL ((unsigned long) 4, history.undo_depth ());
+	CPPUNIT_ASSERT (history.memory_usage () <= 4 * one);
+
+	/* the latest transaction is kept even if it is over budget on its own */
+	history.add (sized_transaction (100000, &compacted));
+	CPPUNIT_ASSERT_EQUAL ((unsigned long) 1, history.undo_depth ());
+
+	history.set_memory_budget (0);
+	for (int i = 0; i < 9; ++i) {
+		history.add (sized_transaction (1000, &compacted));
+	}
+	CPPUNIT_ASSERT_EQUAL ((unsigned long) 10, history.undo_depth ());
+}
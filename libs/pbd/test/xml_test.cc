@@ -16,7 +16,10 @@
 
 #include <libxml/xpath.h>
 
+#include "pbd/compose.h"
 #include "pbd/file_utils.h"
+#include "pbd/packed_xml.h"
+#include "pbd/xml++.h"
 
 #include "test_common.h"
 
@@ -77,3 +80,37 @@ XMLTest::testXMLFilenameEncoding ()
 		CPPUNIT_ASSERT (write_xml (output_path));
 	}
 }
+
+void
+XMLTest::testPackedXML ()
+{
+	XMLNode* node = new XMLNode ("AutomationList");
+	node->add_property ("id", "42");
+	node->add_property ("interpolation-style", "Linear");
+
+	string events;
+	for (int i = 0; i < 1000; ++i) {
+		events += string_compose ("%1 %2\n", i * 256, i / 1000.0);
+	}
+	node->add_child ("events")->add_content (events);
+
+	XMLNode const copy (*node);
+	size_t const tree_size = PackedXML::memory_usage (copy);
+
+	PackedXML packed (node);
+
+	CPPUNIT_ASSERT (packed.memory_usage () < tree_size / 2);
+
+	XMLNode* unpacked = packed.unpack ();
+	CPPUNIT_ASSERT (unpacked);
+	CPPUNIT_ASSERT_EQUAL (string ("AutomationList"), unpacked->name ());
+	CPPUNIT_ASSERT_EQUAL (string ("42"), unpacked->property ("id")->value ());
+	CPPUNIT_ASSERT_EQUAL (string ("Linear"), unpacked->property ("interpolation-style")->value ());
+
+	XMLNode* e = unpacked->child ("events");
+	CPPUNIT_ASSERT (e);
+	CPPUNIT_ASSERT (!e->children().empty());
+	CPPUNIT_ASSERT_EQUAL (events, e->children().front()->content ());
+
+	delete unpacked;
+}
@@ -5,8 +5,10 @@ class XMLTest : public CppUnit::TestFixture
 {
 	CPPUNIT_TEST_SUITE (XMLTest);
 	CPPUNIT_TEST (testXMLFilenameEncoding);
+	CPPUNIT_TEST (testPackedXML);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
 	void testXMLFilenameEncoding ();
+	void testPackedXML ();
 };
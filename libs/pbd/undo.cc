@@ -32,6 +32,7 @@ using namespace sigc;
 
 UndoTransaction::UndoTransaction ()
 	: _clearing(false)
+	, _memory_usage (0)
 {
 	gettimeofday (&_timestamp, 0);
 }
@@ -39,6 +40,7 @@ UndoTransaction::UndoTransaction ()
 UndoTransaction::UndoTransaction (const UndoTransaction& rhs)
 	: Command(rhs._name)
 	, _clearing(false)
+	, _memory_usage (0)
 {
         _timestamp = rhs._timestamp;
 	clear ();
@@ -72,6 +74,7 @@ UndoTransaction::operator= (const UndoTransaction& rhs)
 	_name = rhs._name;
 	clear ();
 	actions.insert(actions.end(),rhs.actions.begin(),rhs.actions.end());
+	_memory_usage = 0;
 	return *this;
 }
 
@@ -85,12 +88,14 @@ UndoTransaction::add_command (Command *const cmd)
 
 	cmd->DropReferences.connect_same_thread (*this, boost::bind (&command_death, this, cmd));
 	actions.push_back (cmd);
+	_memory_usage = 0;
 }
 
 void
 UndoTransaction::remove_command (Command* const action)
 {
 	actions.remove (action);
+	_memory_usage = 0;
 }
 
 bool
@@ -108,6 +113,7 @@ UndoTransaction::clear ()
 	}
 	actions.clear ();
 	_clearing = false;
+	_memory_usage = 0;
 }
 
 void
@@ -150,6 +156,28 @@ XMLNode &UndoTransaction::get_state()
     return *node;
 }
 
+void
+UndoTransaction::compact ()
+{
+	for (list<Command*>::iterator i = actions.begin(); i != actions.end(); ++i) {
+		(*i)->compact ();
+	}
+	_memory_usage = 0;
+}
+
+size_t
+UndoTransaction::memory_usage () const
+{
+	if (_memory_usage == 0) {
+		_memory_usage = sizeof (*this) + _name.capacity ();
+		for (list<Command*>::const_iterator i = actions.begin(); i != actions.end(); ++i) {
+			_memory_usage += (*i)->memory_usage () + 3 * sizeof (void*);
+		}
+	}
+
+	return _memory_usage;
+}
+
 class UndoRedoSignaller {
 public:
     UndoRedoSignaller (UndoHistory& uh)
@@ -168,6 +196,50 @@ UndoHistory::UndoHistory ()
 {
 	_clearing = false;
 	_depth = 0;
+	_memory_budget = 0;
+}
+
+void
+UndoHistory::set_memory_budget (size_t bytes)
+{
+	_memory_budget = bytes;
+	enforce_memory_budget ();
+}
+
+size_t
+UndoHistory::memory_usage () const
+{
+	size_t s = 0;
+
+	for (list<UndoTransaction*>::const_iterator i = UndoList.begin(); i != UndoList.end(); ++i) {
+		s += (*i)->memory_usage ();
+	}
+
+	for (list<UndoTransaction*>::const_iterator i = RedoList.begin(); i != RedoList.end(); ++i) {
+		s += (*i)->memory_usage ();
+	}
+
+	return s;
+}
+
+/** Drop the oldest undo transactions until we are within our memory budget,
+ *  always keeping the most recent one.
+ */
+void
+UndoHistory::enforce_memory_budget ()
+{
+	if (_memory_budget == 0) {
+		return;
+	}
+
+	size_t used = memory_usage ();
+
+	while (used > _memory_budget && UndoList.size() > 1) {
+		UndoTransaction* ut = UndoList.front ();
+		UndoList.pop_front ();
+		used -= ut->memory_usage ();
+		delete ut;
+	}
 }
 
 void
@@ -219,6 +291,9 @@ UndoHistory::add (UndoTransaction* const ut)
 		}
 	}
 
+	/* the transaction may now stay around for a long time */
+	ut->compact ();
+
 	UndoList.push_back (ut);
 	/* Adding a transacrion makes the redo list meaningless. */
 	_clearing = true;
@@ -228,6 +303,8 @@ UndoHistory::add (UndoTransaction* const ut)
 	RedoList.clear ();
 	_clearing = false;
 
+	enforce_memory_budget ();
+
 	/* we are now owners of the transaction and must delete it when finished with it */
 
 	Changed (); /* EMIT SIGNAL */
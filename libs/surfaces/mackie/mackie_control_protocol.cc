@@ -461,6 +461,10 @@ MackieControlProtocol::periodic ()
 
 	ARDOUR::microseconds_t now_usecs = ARDOUR::get_microseconds ();
 
+	if (_metering_active) {
+		_meter_view.update (*session->meter_snapshot ());
+	}
+
 	{
 		Glib::Threads::Mutex::Lock lm (surfaces_lock);
 
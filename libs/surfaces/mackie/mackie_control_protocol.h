@@ -31,6 +31,7 @@
 #define ABSTRACT_UI_EXPORTS
 #include "pbd/abstract_ui.h"
 #include "midi++/types.h"
+#include "ardour/meter_snapshot.h"
 #include "ardour/types.h"
 #include "control_protocol/control_protocol.h"
 
@@ -146,6 +147,9 @@ class MackieControlProtocol
 	bool zoom_mode () const { return modifier_state() & MODIFIER_ZOOM; }
 	bool     metering_active () const { return _metering_active; }
 
+	/** meter levels of all strips, refreshed once per periodic() */
+	ARDOUR::MeterSnapshot::View& meter_view () { return _meter_view; }
+
 	void set_view_mode (ViewMode);
 	void set_flip_mode (FlipMode);
 	void set_pot_mode (PotMode);
@@ -318,6 +322,7 @@ class MackieControlProtocol
 	int16_t                  _ipmidi_base;
 	bool                      needs_ipmidi_restart;
 	bool                     _metering_active;
+	ARDOUR::MeterSnapshot::View _meter_view;
 	bool                     _initialized;
 	ARDOUR::RouteNotificationList _last_selected_routes;
 	XMLNode*                 configuration_state;
@@ -886,7 +886,7 @@ void
 Strip::update_meter ()
 {
 	if (_meter && _transport_is_rolling && _metering_active) {
-		float dB = const_cast<PeakMeter&> (_route->peak_meter()).meter_level (0, MeterMCP);
+		float dB = _surface->mcp().meter_view().level (_route->peak_meter().snapshot_slot(), 0, MeterMCP);
 		_meter->send_update (*_surface, dB);
 	}
 }
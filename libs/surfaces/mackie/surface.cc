@@ -770,6 +770,9 @@ Surface::turn_it_on ()
 
 	_active = true;
 
+	/* whatever the device showed before is gone */
+	_port->invalidate_shadow ();
+
 	_mcp.device_ready ();
 
 	for (Strips::iterator s = strips.begin(); s != strips.end(); ++s) {
@@ -889,6 +892,12 @@ Surface::redisplay (ARDOUR::microseconds_t now)
 	for (Strips::iterator s = strips.begin(); s != strips.end(); ++s) {
 		(*s)->redisplay (now);
 	}
+
+	/* send everything that changed since the last tick in one burst */
+
+	if (_port) {
+		_port->flush ();
+	}
 }
 
 void
@@ -1158,6 +1167,7 @@ Surface::reset ()
 		msg << 0x00;
 		msg << MIDI::eox;
 		_port->write (msg);
+		_port->invalidate_shadow ();
 	}
 }
 
@@ -1219,7 +1229,8 @@ Surface::hui_heartbeat ()
 	}
 
 	MidiByteArray msg (3, MIDI::on, 0x0, 0x0);
-	_port->write (msg);
+	/* must be sent every time, not just when changed */
+	_port->write_immediate (msg);
 }
 
 void
@@ -1227,6 +1238,8 @@ Surface::connected ()
 {
 	DEBUG_TRACE (DEBUG::MackieControl, string_compose ("Surface %1 now connected, trying to ping device...\n", _name));
 
+	_port->invalidate_shadow ();
+
 	say_hello ();
 
 	if (_mcp.device_info().no_handshake()) {
@@ -51,7 +51,12 @@ using namespace Mackie;
 
 SurfacePort::SurfacePort (Surface& s)
 	: _surface (&s)
+	, _meters_pending (false)
 {
+	memset (_lcd_wanted, 0xff, sizeof (_lcd_wanted));
+	memset (_lcd_shown, 0xff, sizeof (_lcd_shown));
+	memset (_pending_meter, 0xff, sizeof (_pending_meter));
+
 	if (_surface->mcp().device_info().uses_ipmidi()) {
 		_input_port = new MIDI::IPMIDIPort (_surface->mcp().ipmidi_base() +_surface->number());
 		_output_port = _input_port;
@@ -88,6 +93,8 @@ SurfacePort::SurfacePort (Surface& s)
 
 SurfacePort::~SurfacePort()
 {
+	flush ();
+
 	if (dynamic_cast<MIDI::IPMIDIPort*>(_input_port)) {
 		delete _input_port;
 		_input_port = 0;
@@ -191,6 +198,256 @@ SurfacePort::write (const MidiByteArray & mba)
 		return 0;
 	}
 
+	MIDI::byte const status = mba[0] & 0xf0;
+
+	if (mba.size() == 3 && (status == MIDI::on || status == MIDI::controller || status == MIDI::pitchbend)) {
+
+		/* buttons/LEDs and pots are addressed by their note/CC
+		 * number, faders by their channel alone.
+		 */
+
+		uint16_t key = mba[0] << 8;
+
+		if (status != MIDI::pitchbend) {
+			key |= mba[1];
+		}
+
+		Glib::Threads::Mutex::Lock lm (_output_lock);
+		_pending[key] = (mba[1] << 8) | mba[2];
+		return 0;
+	}
+
+	if (mba.size() == 2 && status == MIDI::chanpress) {
+
+		/* meters: only the most recent level (and overload state)
+		 * per strip matters. They are never compared with what was
+		 * sent before, since the device lets meters decay by itself.
+		 */
+
+		uint32_t const index = ((mba[1] >> 4) << 1) | ((mba[1] & 0xf) >= 0xe ? 1 : 0);
+
+		Glib::Threads::Mutex::Lock lm (_output_lock);
+		_pending_meter[index] = mba[1];
+		_meters_pending = true;
+		return 0;
+	}
+
+	{
+		Glib::Threads::Mutex::Lock lm (_output_lock);
+		if (queue_display (mba)) {
+			return 0;
+		}
+	}
+
+	return write_immediate (mba);
+}
+
+int
+SurfacePort::write_immediate (const MidiByteArray & mba)
+{
+	if (mba.empty()) {
+		return 0;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_output_lock);
+
+	/* keep ordering with respect to anything already queued */
+
+	if (flush_unlocked ()) {
+		return -1;
+	}
+
+	return write_now (mba);
+}
+
+int
+SurfacePort::flush ()
+{
+	Glib::Threads::Mutex::Lock lm (_output_lock);
+	return flush_unlocked ();
+}
+
+void
+SurfacePort::invalidate_shadow ()
+{
+	Glib::Threads::Mutex::Lock lm (_output_lock);
+
+	/* the device may show anything now: queue everything we believe it
+	 * showed so that the next flush repaints it.
+	 */
+
+	for (ControlState::const_iterator i = _shown.begin(); i != _shown.end(); ++i) {
+		_pending.insert (*i);
+	}
+
+	_shown.clear ();
+
+	for (size_t n = 0; n < lcd_size; ++n) {
+		if (_lcd_wanted[n] == 0xff) {
+			_lcd_wanted[n] = _lcd_shown[n];
+		}
+	}
+
+	memset (_lcd_shown, 0xff, sizeof (_lcd_shown));
+}
+
+/** Remember the text of an LCD update (sysex 0x12) rather than sending it.
+ *  @return false if @param mba is not a (valid) LCD update.
+ */
+bool
+SurfacePort::queue_display (const MidiByteArray & mba)
+{
+	/* f0 00 00 66 <model> 12 <offset> <chars...> f7 */
+
+	if (mba.size() < 9 || mba[0] != MIDI::sysex || mba[1] != 0x00 || mba[2] != 0x00 || mba[3] != 0x66 ||
+	    mba[5] != 0x12 || mba.back() != MIDI::eox) {
+		return false;
+	}
+
+	size_t const offset = mba[6];
+	size_t const len = mba.size() - 8;
+
+	if (offset + len > lcd_size) {
+		return false;
+	}
+
+	_lcd_header.assign (mba.begin(), mba.begin() + 5);
+
+	for (size_t n = 0; n < len; ++n) {
+		_lcd_wanted[offset + n] = mba[7 + n];
+	}
+
+	return true;
+}
+
+int
+SurfacePort::flush_unlocked ()
+{
+	/* do not starve buttons, LEDs and faders: meters go out last, and
+	 * only if this flush has not already sent a lot.
+	 */
+	static const size_t meter_budget = 128;
+
+	size_t bytes = 0;
+
+	for (ControlState::iterator i = _pending.begin(); i != _pending.end(); ) {
+
+		ControlState::iterator s = _shown.find (i->first);
+
+		if (s != _shown.end() && s->second == i->second) {
+			_pending.erase (i++);
+			continue;
+		}
+
+		MidiByteArray msg (3, (MIDI::byte) (i->first >> 8), (MIDI::byte) (i->second >> 8), (MIDI::byte) (i->second & 0xff));
+
+		if (write_now (msg)) {
+			/* leave the rest for the next flush */
+			return -1;
+		}
+
+		_shown[i->first] = i->second;
+		bytes += msg.size();
+		_pending.erase (i++);
+	}
+
+	if (flush_display (bytes)) {
+		return -1;
+	}
+
+	if (bytes > meter_budget) {
+		return 0;
+	}
+
+	return flush_meters ();
+}
+
+int
+SurfacePort::flush_display (size_t& bytes)
+{
+	/* a separate LCD message costs 8 bytes of overhead, so re-sending
+	 * shorter runs of unchanged characters in between is cheaper.
+	 */
+	static const size_t max_gap = 8;
+
+	size_t n = 0;
+
+	while (n < lcd_size) {
+
+		if (_lcd_wanted[n] == 0xff || _lcd_wanted[n] == _lcd_shown[n]) {
+			++n;
+			continue;
+		}
+
+		size_t const start = n;
+		size_t end = n + 1;
+
+		for (size_t m = end; m < lcd_size && m - end < max_gap; ++m) {
+			if (_lcd_wanted[m] != 0xff && _lcd_wanted[m] != _lcd_shown[m]) {
+				end = m + 1;
+			} else if (_lcd_wanted[m] == 0xff && _lcd_shown[m] == 0xff) {
+				/* unknown content, cannot be re-sent */
+				break;
+			}
+		}
+
+		MidiByteArray msg;
+		msg << _lcd_header;
+		msg << 0x12;
+		msg << (MIDI::byte) start;
+
+		for (size_t m = start; m < end; ++m) {
+			msg << (_lcd_wanted[m] != 0xff ? _lcd_wanted[m] : _lcd_shown[m]);
+		}
+
+		msg << MIDI::eox;
+
+		if (write_now (msg)) {
+			return -1;
+		}
+
+		for (size_t m = start; m < end; ++m) {
+			if (_lcd_wanted[m] != 0xff) {
+				_lcd_shown[m] = _lcd_wanted[m];
+				_lcd_wanted[m] = 0xff;
+			}
+		}
+
+		bytes += msg.size();
+		n = end;
+	}
+
+	return 0;
+}
+
+int
+SurfacePort::flush_meters ()
+{
+	if (!_meters_pending) {
+		return 0;
+	}
+
+	for (size_t n = 0; n < sizeof (_pending_meter); ++n) {
+
+		if (_pending_meter[n] == 0xff) {
+			continue;
+		}
+
+		if (write_now (MidiByteArray (2, MIDI::chanpress, _pending_meter[n]))) {
+			return -1;
+		}
+
+		_pending_meter[n] = 0xff;
+	}
+
+	_meters_pending = false;
+
+	return 0;
+}
+
+int
+SurfacePort::write_now (const MidiByteArray & mba)
+{
 	DEBUG_TRACE (DEBUG::MackieControl, string_compose ("port %1 write %2\n", output_port().name(), mba));
 
 	if (mba[0] != 0xf0 && mba.size() > 3) {
@@ -18,6 +18,10 @@
 #ifndef surface_port_h
 #define surface_port_h
 
+#include <map>
+
+#include <glibmm/threads.h>
+
 #include <midi++/types.h>
 
 #include "pbd/signals.h"
@@ -56,9 +60,23 @@ class SurfacePort
 	SurfacePort (Mackie::Surface&);
 	virtual ~SurfacePort();
 
-	/// an easier way to output bytes via midi
+	/** queue bytes for output at the next flush(). Button/LED, pot,
+	 *  fader and LCD messages are compared against what the device is
+	 *  believed to show, and only differences are sent.
+	 */
 	int write (const MidiByteArray&);
 
+	/// output bytes now, bypassing the shadow (pings, device commands)
+	int write_immediate (const MidiByteArray&);
+
+	/** send everything queued by write(), controls and displays first,
+	 *  meters last. Called once per redisplay tick.
+	 */
+	int flush ();
+
+	/// forget what the device shows, e.g. after it has been (re)connected
+	void invalidate_shadow ();
+
 	MIDI::Port& input_port() const { return *_input_port; }
 	MIDI::Port& output_port() const { return *_output_port; }
 
@@ -76,11 +94,38 @@ class SurfacePort
   protected:
 
   private:
+	int write_now (const MidiByteArray&);
+	int flush_unlocked ();
+	int flush_display (size_t& bytes);
+	int flush_meters ();
+	bool queue_display (const MidiByteArray&);
+
 	Mackie::Surface*   _surface;
 	MIDI::Port* _input_port;
 	MIDI::Port* _output_port;
 	boost::shared_ptr<ARDOUR::Port> _async_in;
 	boost::shared_ptr<ARDOUR::Port> _async_out;
+
+	Glib::Threads::Mutex _output_lock;
+
+	/* note, CC and pitchbend state, keyed by (status << 8 | data1),
+	 * valued (data1 << 8 | data2)
+	 */
+	typedef std::map<uint16_t,uint16_t> ControlState;
+	ControlState _pending;
+	ControlState _shown;
+
+	/* the 2x56 character LCD; 0xff marks "unknown"/"nothing wanted" */
+	static const size_t lcd_size = 112;
+	MIDI::byte _lcd_wanted[lcd_size];
+	MIDI::byte _lcd_shown[lcd_size];
+	MidiByteArray _lcd_header;
+
+	/* latest meter level and overload message per strip, indexed by
+	 * (strip << 1 | overload); 0xff means nothing pending
+	 */
+	MIDI::byte _pending_meter[32];
+	bool _meters_pending;
 };
 
 std::ostream& operator <<  (std::ostream& , const SurfacePort& port);
@@ -83,6 +83,7 @@ OSC::OSC (Session& s, uint32_t port)
 	, _osc_unix_server (0)
 	, _namespace_root ("/ardour")
 	, _send_route_changes (true)
+	, _feedback_interval (50)
 {
 	_instance = this;
 
@@ -244,6 +245,12 @@ OSC::thread_init ()
 		g_source_ref (remote_server);
 	}
 
+	/* a short tick; each client has its own, longer, feedback interval */
+
+	Glib::RefPtr<Glib::TimeoutSource> periodic_timeout = Glib::TimeoutSource::create (10); // milliseconds
+	periodic_connection = periodic_timeout->connect (sigc::mem_fun (*this, &OSC::periodic));
+	periodic_timeout->attach (_main_loop->get_context());
+
 	PBD::notify_gui_about_thread_creation (X_("gui"), pthread_self(), X_("OSC"), 2048);
 	SessionEvent::create_per_thread_pool (X_("OSC"), 128);
 }
@@ -251,6 +258,8 @@ OSC::thread_init ()
 int
 OSC::stop ()
 {
+	periodic_connection.disconnect ();
+
 	/* stop main loop */
 
 	if (local_server) {
@@ -298,6 +307,10 @@ OSC::stop ()
 		}
 	}
 
+	for (FeedbackClients::iterator c = _feedback_clients.begin(); c != _feedback_clients.end(); ++c) {
+		lo_address_free (c->second.addr);
+	}
+	_feedback_clients.clear ();
 	return 0;
 }
 
@@ -339,6 +352,8 @@ OSC::register_callbacks()
 		REGISTER_CALLBACK (serv, "/ardour/set_transport_speed", "f", set_transport_speed);
 		REGISTER_CALLBACK (serv, "/ardour/locate", "ii", locate);
 		REGISTER_CALLBACK (serv, "/ardour/save_state", "", save_state);
+		REGISTER_CALLBACK (serv, "/ardour/dsp_timing", "", dsp_timing);
+		REGISTER_CALLBACK (serv, "/ardour/dsp_timing_reset", "", dsp_timing_reset);
 		REGISTER_CALLBACK (serv, "/ardour/prev_marker", "", prev_marker);
 		REGISTER_CALLBACK (serv, "/ardour/next_marker", "", next_marker);
 		REGISTER_CALLBACK (serv, "/ardour/undo", "", undo);
@@ -441,6 +456,8 @@ OSC::listen_to_route (boost::shared_ptr<Route> route, lo_address addr)
 	OSCRouteObserver* o = new OSCRouteObserver (route, addr);
 	route_observers.push_back (o);
 
+	feedback_client (addr);
+
 	route->DropReferences.connect (*this, MISSING_INVALIDATOR, boost::bind (&OSC::drop_route, this, boost::weak_ptr<Route> (route)), this);
 }
 
@@ -620,6 +637,11 @@ OSC::catchall (const char *path, const char* /*types*/, lo_arg **argv, int argc,
 
 		ret = 0;
 
+	} else if (strcmp (path, "/ardour/feedback") == 0) {
+
+		set_client_feedback (msg, argv, argc);
+		ret = 0;
+
 	} else if (strcmp (path, "/routes/ignore") == 0) {
 
 		for (int n = 0; n < argc; ++n) {
@@ -643,6 +665,133 @@ OSC::update_clock ()
 
 }
 
+void
+OSC::set_feedback_interval (uint32_t ms)
+{
+	_feedback_interval = max ((uint32_t) 10, ms);
+}
+
+OSC::FeedbackClient&
+OSC::feedback_client (lo_address addr)
+{
+	char* u = lo_address_get_url (addr);
+	string const url (u);
+	free (u);
+
+	FeedbackClients::iterator c = _feedback_clients.find (url);
+
+	if (c == _feedback_clients.end()) {
+		FeedbackClient fc;
+		fc.addr = lo_address_new (lo_address_get_hostname (addr), lo_address_get_port (addr));
+		fc.interval = _feedback_interval;
+		c = _feedback_clients.insert (make_pair (url, fc)).first;
+	}
+
+	return c->second;
+}
+
+/** /ardour/feedback flags [interval]
+ *
+ * flags: 1 = route meter levels, 2 = transport position, in addition to
+ * the route values that a client always gets for routes it listens to.
+ * interval: minimum time between feedback bundles, in ms.
+ */
+void
+OSC::set_client_feedback (lo_message msg, lo_arg** argv, int argc)
+{
+	lo_message reply = lo_message_new ();
+
+	if (argc <= 0 || lo_message_get_types (msg)[0] != 'i') {
+		lo_message_add_string (reply, "syntax error");
+	} else {
+		FeedbackClient& fc (feedback_client (lo_message_get_source (msg)));
+
+		fc.flags = argv[0]->i;
+
+		if (argc > 1 && lo_message_get_types (msg)[1] == 'i') {
+			fc.interval = max (10, argv[1]->i);
+		}
+
+		fc.next_send = 0;
+		fc.last_frame = -1;
+
+		lo_message_add_int32 (reply, fc.flags);
+		lo_message_add_int32 (reply, fc.interval);
+	}
+
+	lo_send_message (lo_message_get_source (msg), "#reply", reply);
+	lo_message_free (reply);
+}
+
+/* keep bundles well below the size of a UDP datagram */
+static const uint32_t max_bundle_messages = 64;
+
+bool
+OSC::periodic ()
+{
+	if (!_send_route_changes || !session) {
+		return true;
+	}
+
+	gint64 const now = g_get_monotonic_time ();
+	bool meters_copied = false;
+
+	for (FeedbackClients::iterator c = _feedback_clients.begin(); c != _feedback_clients.end(); ++c) {
+
+		FeedbackClient& fc (c->second);
+
+		if (now < fc.next_send) {
+			continue;
+		}
+
+		fc.next_send = now + fc.interval * 1000;
+
+		if ((fc.flags & FeedbackMeters) && !meters_copied) {
+			_meter_view.update (*session->meter_snapshot ());
+			meters_copied = true;
+		}
+
+		lo_bundle bundle = lo_bundle_new (LO_TT_IMMEDIATE);
+		uint32_t n = 0;
+
+		for (RouteObservers::iterator x = route_observers.begin(); x != route_observers.end(); ++x) {
+
+			if ((*x)->url() != c->first) {
+				continue;
+			}
+
+			n += (*x)->add_changes (bundle, (fc.flags & FeedbackMeters) ? &_meter_view : 0);
+
+			if (n >= max_bundle_messages) {
+				lo_send_bundle (fc.addr, bundle);
+				lo_bundle_free_messages (bundle);
+				bundle = lo_bundle_new (LO_TT_IMMEDIATE);
+				n = 0;
+			}
+		}
+
+		if (fc.flags & FeedbackTransport) {
+			framepos_t const pos = session->transport_frame ();
+
+			if (pos != fc.last_frame) {
+				lo_message msg = lo_message_new ();
+				lo_message_add_int64 (msg, pos);
+				lo_bundle_add_message (bundle, "/ardour/transport_frame", msg);
+				fc.last_frame = pos;
+				++n;
+			}
+		}
+
+		if (n) {
+			lo_send_bundle (fc.addr, bundle);
+		}
+
+		lo_bundle_free_messages (bundle);
+	}
+
+	return true;
+}
+
 // "Application Hook" Handlers //
 void
 OSC::session_loaded (Session& s)
@@ -788,6 +937,42 @@ OSC::transport_frame (lo_message msg)
 	lo_message_free (reply);
 }
 
+void
+OSC::dsp_timing (lo_message msg)
+{
+	if (!session) return;
+
+	std::vector<Session::ProcessorTiming> timings;
+	session->get_dsp_timing (timings);
+
+	for (std::vector<Session::ProcessorTiming>::const_iterator i = timings.begin(); i != timings.end(); ++i) {
+
+		lo_message reply = lo_message_new ();
+
+		lo_message_add_string (reply, i->route->name().c_str());
+		lo_message_add_string (reply, i->processor ? i->processor->name().c_str() : "");
+		lo_message_add_int64 (reply, i->stats.min);
+		lo_message_add_double (reply, i->stats.avg);
+		lo_message_add_int64 (reply, i->stats.max);
+		lo_message_add_int32 (reply, i->stats.count);
+
+		lo_send_message (lo_message_get_source (msg), "#reply", reply);
+		lo_message_free (reply);
+	}
+
+	lo_message reply = lo_message_new ();
+	lo_message_add_string (reply, "end_dsp_timing");
+	lo_send_message (lo_message_get_source (msg), "#reply", reply);
+	lo_message_free (reply);
+}
+
+void
+OSC::dsp_timing_reset ()
+{
+	if (!session) return;
+	session->reset_dsp_timing ();
+}
+
 int
 OSC::route_mute (int rid, int yn)
 {
@@ -1083,7 +1268,9 @@ OSC::route_plugin_parameter_print (int rid, int piid, int par)
 XMLNode&
 OSC::get_state ()
 {
-	return ControlProtocol::get_state();
+	XMLNode& node (ControlProtocol::get_state());
+	node.add_property (X_("feedback-interval"), PBD::to_string (_feedback_interval, std::dec));
+	return node;
 }
 
 int
@@ -1093,5 +1280,11 @@ OSC::set_state (const XMLNode& node, int version)
 		return -1;
 	}
 
+	const XMLProperty* prop;
+
+	if ((prop = node.property (X_("feedback-interval"))) != 0) {
+		set_feedback_interval (PBD::atoi (prop->value()));
+	}
+
 	return 0;
 }
@@ -20,6 +20,7 @@
 #ifndef ardour_osc_h
 #define ardour_osc_h
 
+#include <map>
 #include <string>
 
 #include <sys/time.h>
@@ -34,6 +35,7 @@
 #define ABSTRACT_UI_EXPORTS
 #include "pbd/abstract_ui.h"
 
+#include "ardour/meter_snapshot.h"
 #include "ardour/types.h"
 #include "control_protocol/control_protocol.h"
 
@@ -76,6 +78,10 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 
 	void set_namespace_root (std::string);
 
+	/** Default time between feedback bundles for new clients, in ms */
+	void set_feedback_interval (uint32_t ms);
+	uint32_t feedback_interval () const { return _feedback_interval; }
+
 	int start ();
 	int stop ();
 
@@ -99,6 +105,36 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	std::string _namespace_root;
 	bool _send_route_changes;
 
+	/* Feedback is not sent as values change.  Route observers remember
+	 * what changed, and periodic() sends each client everything that is
+	 * due in one bundle, at most once per that client's interval.
+	 */
+	enum FeedbackFlags {
+		FeedbackMeters    = 0x1,
+		FeedbackTransport = 0x2
+	};
+
+	struct FeedbackClient {
+		FeedbackClient () : addr (0), interval (0), flags (0), next_send (0), last_frame (-1) {}
+
+		lo_address         addr;
+		uint32_t           interval;   ///< ms between bundles
+		uint32_t           flags;      ///< FeedbackFlags
+		gint64             next_send;  ///< g_get_monotonic_time() of the next bundle
+		ARDOUR::framepos_t last_frame; ///< last transport position sent
+	};
+
+	typedef std::map<std::string, FeedbackClient> FeedbackClients;
+
+	FeedbackClients  _feedback_clients; ///< indexed by client URL
+	uint32_t         _feedback_interval;
+	ARDOUR::MeterSnapshot::View _meter_view; ///< shared by all clients, refreshed per periodic()
+	sigc::connection periodic_connection;
+
+	FeedbackClient& feedback_client (lo_address);
+	void set_client_feedback (lo_message, lo_arg** argv, int argc);
+	bool periodic ();
+
 	void register_callbacks ();
 
 	void route_added (ARDOUR::RouteList&);
@@ -122,6 +158,8 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 
 	void routes_list (lo_message msg);
 	void transport_frame(lo_message msg);
+	void dsp_timing (lo_message msg);
+	void dsp_timing_reset ();
 
 #define PATH_CALLBACK_MSG(name)					\
         static int _ ## name (const char *path, const char *types, lo_arg **argv, int argc, void *data, void *user_data) { \
@@ -134,6 +172,7 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 
 	PATH_CALLBACK_MSG(routes_list);
 	PATH_CALLBACK_MSG(transport_frame);
+	PATH_CALLBACK_MSG(dsp_timing);
 
 #define PATH_CALLBACK(name) \
         static int _ ## name (const char *path, const char *types, lo_arg **argv, int argc, void *data, void *user_data) { \
@@ -161,6 +200,7 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	PATH_CALLBACK(toggle_punch_out);
 	PATH_CALLBACK(rec_enable_toggle);
 	PATH_CALLBACK(toggle_all_rec_enables);
+	PATH_CALLBACK(dsp_timing_reset);
 
 #define PATH_CALLBACK1(name,type,optional)					\
         static int _ ## name (const char *path, const char *types, lo_arg **argv, int argc, void *data, void *user_data) { \
@@ -19,8 +19,11 @@
 
 #include "boost/lambda/lambda.hpp"
 
+#include <cmath>
+
 #include "ardour/route.h"
 #include "ardour/audio_track.h"
+#include "ardour/meter.h"
 #include "ardour/midi_track.h"
 
 #include "osc.h"
@@ -35,9 +38,15 @@ using namespace ArdourSurface;
 
 OSCRouteObserver::OSCRouteObserver (boost::shared_ptr<Route> r, lo_address a)
 	: _route (r)
+	, _changed (0)
+	, _last_meter (-200.0f)
 {
 	addr = lo_address_new (lo_address_get_hostname(a) , lo_address_get_port(a));
 
+	char* u = lo_address_get_url (addr);
+	_url = u;
+	free (u);
+
 	_route->PropertyChanged.connect (name_changed_connection, MISSING_INVALIDATOR, boost::bind (&OSCRouteObserver::name_changed, this, boost::lambda::_1), OSC::instance());
 
 	if (boost::dynamic_pointer_cast<AudioTrack>(_route) || boost::dynamic_pointer_cast<MidiTrack>(_route)) {
@@ -45,17 +54,17 @@ OSCRouteObserver::OSCRouteObserver (boost::shared_ptr<Route> r, lo_address a)
 		boost::shared_ptr<Track> track = boost::dynamic_pointer_cast<Track>(r);
 		boost::shared_ptr<Controllable> rec_controllable = boost::dynamic_pointer_cast<Controllable>(track->rec_enable_control());
 
-		rec_controllable->Changed.connect (rec_changed_connection, MISSING_INVALIDATOR, bind (&OSCRouteObserver::send_change_message, this, X_("/route/rec"), track->rec_enable_control()), OSC::instance());
+		rec_controllable->Changed.connect (rec_changed_connection, MISSING_INVALIDATOR, boost::bind (&OSCRouteObserver::value_changed, this, RecChanged), OSC::instance());
 	}
 
 	boost::shared_ptr<Controllable> mute_controllable = boost::dynamic_pointer_cast<Controllable>(_route->mute_control());
-	mute_controllable->Changed.connect (mute_changed_connection, MISSING_INVALIDATOR, bind (&OSCRouteObserver::send_change_message, this, X_("/route/mute"), _route->mute_control()), OSC::instance());
+	mute_controllable->Changed.connect (mute_changed_connection, MISSING_INVALIDATOR, boost::bind (&OSCRouteObserver::value_changed, this, MuteChanged), OSC::instance());
 
 	boost::shared_ptr<Controllable> solo_controllable = boost::dynamic_pointer_cast<Controllable>(_route->solo_control());
-	solo_controllable->Changed.connect (solo_changed_connection, MISSING_INVALIDATOR, bind (&OSCRouteObserver::send_change_message, this, X_("/route/solo"), _route->solo_control()), OSC::instance());
+	solo_controllable->Changed.connect (solo_changed_connection, MISSING_INVALIDATOR, boost::bind (&OSCRouteObserver::value_changed, this, SoloChanged), OSC::instance());
 
 	boost::shared_ptr<Controllable> gain_controllable = boost::dynamic_pointer_cast<Controllable>(_route->gain_control());
-	gain_controllable->Changed.connect (gain_changed_connection, MISSING_INVALIDATOR, bind (&OSCRouteObserver::send_change_message, this, X_("/route/gain"), _route->gain_control()), OSC::instance());
+	gain_controllable->Changed.connect (gain_changed_connection, MISSING_INVALIDATOR, boost::bind (&OSCRouteObserver::value_changed, this, GainChanged), OSC::instance());
 }
 
 OSCRouteObserver::~OSCRouteObserver ()
@@ -76,31 +85,93 @@ OSCRouteObserver::name_changed (const PBD::PropertyChange& what_changed)
 	    return;
 	}
 
+	value_changed (NameChanged);
+}
+
+void
+OSCRouteObserver::value_changed (Feedback what)
+{
+	/* nothing is sent here: OSC::periodic() collects all changes for a
+	 * client and sends them together at that client's feedback rate.
+	 */
+	_changed |= what;
+}
+
+uint32_t
+OSCRouteObserver::add_changes (lo_bundle bundle, MeterSnapshot::View* meters)
+{
 	if (!_route) {
-		return;
+		return 0;
 	}
 
-	lo_message msg = lo_message_new ();
+	uint32_t n = 0;
 
-	lo_message_add_int32 (msg, _route->remote_control_id());
-	lo_message_add_string (msg, _route->name().c_str());
+	if (_changed & NameChanged) {
+		lo_message msg = lo_message_new ();
+		lo_message_add_int32 (msg, _route->remote_control_id());
+		lo_message_add_string (msg, _route->name().c_str());
+		lo_bundle_add_message (bundle, "/route/name", msg);
+		++n;
+	}
 
-	lo_send_message (addr, "/route/name", msg);
-	lo_message_free (msg);
+	if (_changed & RecChanged) {
+		boost::shared_ptr<Track> track = boost::dynamic_pointer_cast<Track> (_route);
+		if (track) {
+			add_value (bundle, "/route/rec", track->rec_enable_control());
+			++n;
+		}
+	}
+
+	if (_changed & MuteChanged) {
+		add_value (bundle, "/route/mute", _route->mute_control());
+		++n;
+	}
+
+	if (_changed & SoloChanged) {
+		add_value (bundle, "/route/solo", _route->solo_control());
+		++n;
+	}
+
+	if (_changed & GainChanged) {
+		add_value (bundle, "/route/gain", _route->gain_control());
+		++n;
+	}
+
+	_changed = 0;
+
+	if (meters) {
+		/* highest falloff peak of all channels. Not MeterMCP: reading
+		   that takes the held peak away from every other reader.
+		*/
+		uint32_t const slot = _route->peak_meter().snapshot_slot();
+		uint32_t const nchan = meters->n_channels (slot);
+		float level = -200.0f;
+
+		for (uint32_t c = 0; c < nchan; ++c) {
+			level = max (level, meters->level (slot, c, MeterPeak));
+		}
+
+		/* tablets can't show less than this anyway */
+		if (fabsf (level - _last_meter) >= 0.5f) {
+			lo_message msg = lo_message_new ();
+			lo_message_add_int32 (msg, _route->remote_control_id());
+			lo_message_add_float (msg, level);
+			lo_bundle_add_message (bundle, "/route/meter", msg);
+			_last_meter = level;
+			++n;
+		}
+	}
+
+	return n;
 }
 
 void
-OSCRouteObserver::send_change_message (string path, boost::shared_ptr<Controllable> controllable)
+OSCRouteObserver::add_value (lo_bundle bundle, const char* path, boost::shared_ptr<Controllable> controllable)
 {
 	lo_message msg = lo_message_new ();
 
 	lo_message_add_int32 (msg, _route->remote_control_id());
 	lo_message_add_float (msg, (float) controllable->get_value());
 
-	/* XXX thread issues */
-
-	//std::cerr << "ORC: send " << path << " = " << controllable->get_value() << std::endl;
-
-	lo_send_message (addr, path.c_str(), msg);
-	lo_message_free (msg);
+	lo_bundle_add_message (bundle, path, msg);
 }
@@ -27,6 +27,7 @@
 
 #include "pbd/controllable.h"
 #include "pbd/stateful.h"
+#include "ardour/meter_snapshot.h"
 #include "ardour/types.h"
 
 class OSCRouteObserver
@@ -38,8 +39,26 @@ class OSCRouteObserver
 
 	boost::shared_ptr<ARDOUR::Route> route () const { return _route; }
 	lo_address address() const { return addr; };
+	std::string const & url () const { return _url; }
+
+	/** Add a message to @a bundle for each value that changed since the
+	 *  last call; values that changed more than once in between are only
+	 *  sent once, with their current value.
+	 *  @param meters if non-null, also send the peak meter level taken
+	 *  from this copy of the session's meter snapshot, if it moved.
+	 *  @return the number of messages added.
+	 */
+	uint32_t add_changes (lo_bundle bundle, ARDOUR::MeterSnapshot::View* meters);
 
   private:
+	enum Feedback {
+		NameChanged = 0x01,
+		RecChanged  = 0x02,
+		MuteChanged = 0x04,
+		SoloChanged = 0x08,
+		GainChanged = 0x10
+	};
+
 	boost::shared_ptr<ARDOUR::Route> _route;
 	//boost::shared_ptr<Controllable> _controllable;
 
@@ -50,10 +69,15 @@ class OSCRouteObserver
 	PBD::ScopedConnection gain_changed_connection;
 
 	lo_address addr;
+	std::string _url;
 	std::string path;
 
+	uint32_t _changed; ///< Feedback bits not yet sent
+	float    _last_meter;
+
 	void name_changed (const PBD::PropertyChange& what_changed);
-	void send_change_message (std::string path, boost::shared_ptr<PBD::Controllable> controllable);
+	void value_changed (Feedback);
+	void add_value (lo_bundle, const char* path, boost::shared_ptr<PBD::Controllable> controllable);
 };
 
 #endif /* __osc_oscrouteobserver_h__ */